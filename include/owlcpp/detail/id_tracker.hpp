@@ -30,6 +30,27 @@ public:
       return id;
    }
 
+   /**@return ID that will be returned by next call to get() */
+   id_type next() const {
+      return stack_.empty() ? id_type(counter_) : stack_.top();
+   }
+
+   /**@brief make sure @b id is not returned by get()
+    @details IDs skipped over by @b id become available.
+   */
+   void reserve(id_type const id) {
+      if( id() < counter_ ) {
+         std::stack<id_type> s;
+         for( ; ! stack_.empty(); stack_.pop() ) {
+            if( stack_.top() != id ) s.push(stack_.top());
+         }
+         stack_ = s;
+         return;
+      }
+      for( ; counter_ < id(); ++counter_) stack_.push(id_type(counter_));
+      counter_ = id() + 1;
+   }
+
    void push(id_type const id) {
       BOOST_ASSERT(id < id_type(counter_));
       stack_.push(id);
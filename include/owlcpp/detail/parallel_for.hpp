@@ -0,0 +1,50 @@
+/** @file "/owlcpp/include/owlcpp/detail/parallel_for.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef PARALLEL_FOR_HPP_
+#define PARALLEL_FOR_HPP_
+#include <cstddef>
+#include "boost/function.hpp"
+#include "boost/ref.hpp"
+
+#include "owlcpp/rdf/config.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@return number of threads to use; @b n_threads or,
+if it is 0, the number of hardware threads
+*******************************************************************************/
+OWLCPP_RDF_DECL unsigned n_threads_default(const unsigned n_threads);
+
+/**@brief Call @b fun(i) for every @b i in [0,n) using a pool of threads
+@details Implemented in the rdf library, so that headers that run tasks
+concurrently do not depend on Boost.Thread.
+See parallel_for().
+*******************************************************************************/
+OWLCPP_RDF_DECL void run_parallel(
+         const std::size_t n,
+         boost::function<void(std::size_t)> const& fun,
+         const unsigned n_threads
+);
+
+/**@brief Call @b fun(i) for every @b i in [0,n) using a pool of threads
+@param n number of tasks
+@param fun function object; it is called concurrently from several threads
+@param n_threads maximal number of threads; 0 selects the number of
+hardware threads; with 1 all tasks run in the calling thread
+@throw exception thrown by the task with the smallest index, if any
+@details All tasks are run, even if some of them fail.
+*******************************************************************************/
+template<class Fun> void parallel_for(
+         const std::size_t n,
+         Fun& fun,
+         const unsigned n_threads = 0
+) {
+   run_parallel(n, boost::function<void(std::size_t)>(boost::ref(fun)), n_threads);
+}
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* PARALLEL_FOR_HPP_ */
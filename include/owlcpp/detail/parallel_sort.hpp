@@ -0,0 +1,84 @@
+/** @file "/owlcpp/include/owlcpp/detail/parallel_sort.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef PARALLEL_SORT_HPP_
+#define PARALLEL_SORT_HPP_
+#include <algorithm>
+#include <vector>
+
+#include "owlcpp/detail/parallel_for.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Sort chunks of a range
+*******************************************************************************/
+template<class Iter, class Cmp> class Sort_chunks {
+public:
+   Sort_chunks(std::vector<Iter> const& b, Cmp const& cmp) : b_(b), cmp_(cmp) {}
+   void operator()(const std::size_t i) {std::sort(b_[i], b_[i + 1], cmp_);}
+private:
+   std::vector<Iter> const& b_;
+   Cmp cmp_;
+};
+
+/**@brief Merge pairs of adjacent sorted runs, each @b w chunks long
+*******************************************************************************/
+template<class Iter, class Cmp> class Merge_chunks {
+public:
+   Merge_chunks(std::vector<Iter> const& b, const std::size_t w, Cmp const& cmp)
+   : b_(b), w_(w), cmp_(cmp) {}
+
+   void operator()(const std::size_t i) {
+      const std::size_t n = b_.size() - 1;
+      const std::size_t lo = 2 * w_ * i;
+      const std::size_t mid = lo + w_;
+      const std::size_t hi = std::min(mid + w_, n);
+      if( mid < hi ) std::inplace_merge(b_[lo], b_[mid], b_[hi], cmp_);
+   }
+
+private:
+   std::vector<Iter> const& b_;
+   const std::size_t w_;
+   Cmp cmp_;
+};
+
+/**@brief minimal number of elements per thread for sorting in parallel */
+inline std::size_t parallel_sort_min_chunk() {return 1 << 14;}
+
+/**@brief Sort random access range using a pool of threads
+@param first,last range
+@param cmp comparison function object
+@param n_threads maximal number of threads; 0 selects the number of
+hardware threads
+@details The range is split into chunks that are sorted concurrently and
+then merged pairwise in log2(n_threads) rounds.
+Short ranges are sorted in the calling thread.
+*******************************************************************************/
+template<class Iter, class Cmp> void parallel_sort(
+         const Iter first,
+         const Iter last,
+         Cmp const& cmp,
+         const unsigned n_threads = 0
+) {
+   const std::size_t n = last - first;
+   std::size_t nt = n_threads_default(n_threads);
+   if( nt > n / parallel_sort_min_chunk() ) nt = n / parallel_sort_min_chunk();
+   if( nt < 2 ) {
+      std::sort(first, last, cmp);
+      return;
+   }
+   std::vector<Iter> b(nt + 1);
+   for(std::size_t i = 0; i <= nt; ++i) b[i] = first + n * i / nt;
+   Sort_chunks<Iter,Cmp> sc(b, cmp);
+   parallel_for(nt, sc, nt);
+   for(std::size_t w = 1; w < nt; w *= 2) {
+      Merge_chunks<Iter,Cmp> mc(b, w, cmp);
+      parallel_for((nt + 2 * w - 1) / (2 * w), mc, nt);
+   }
+}
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* PARALLEL_SORT_HPP_ */
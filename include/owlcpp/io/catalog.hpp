@@ -22,6 +22,7 @@ part of owlcpp project.
 #include "owlcpp/rdf/crtpb_ns_node_iri.hpp"
 
 namespace owlcpp{
+class OWLCPP_IO_DECL Catalog_cache;
 
 /**@brief Store locations, ontology IRIs, and version IRIs of OWL ontologies.
 @details Locations should be unique; ontology IRIs may be repeated;
@@ -108,16 +109,48 @@ private:
  @param recurse if true add to catalog files located in sub-directories
  @param search_depth once ontologyIRI declaration is found, stop searching for
  versionIRI declaration after @b search_depth triples
+ @param n_threads maximal number of threads reading files of a directory;
+ 0 selects the number of hardware threads
  @return number of added files
  @details
  If path is a directory, an attempt is made to parse every file located in it.
  Files that fail to parse are ignored.
+ Compressed files are detected from their first bytes and decompressed
+ while being read.
+ Files are added to the catalog in the order of directory iteration
+ regardless of the number of threads.
 *******************************************************************************/
 OWLCPP_IO_DECL std::size_t add(
          Catalog& cat,
          boost::filesystem::path const& path,
          const bool recurse = false,
-         const std::size_t search_depth = std::numeric_limits<std::size_t>::max()
+         const std::size_t search_depth = std::numeric_limits<std::size_t>::max(),
+         const unsigned n_threads = 0
+);
+
+/**@brief determine OntologyIRI and VersionIRI of ontology document(s)
+ and add them to the catalog, reusing IDs of unchanged documents
+ @param cat catalog;
+ @param cache IDs of previously read documents; updated with the IDs of
+ documents that are read
+ @param path symbolic path pointing to local file or directory
+ @param recurse if true add to catalog files located in sub-directories
+ @param search_depth once ontologyIRI declaration is found, stop searching for
+ versionIRI declaration after @b search_depth triples
+ @param n_threads maximal number of threads reading files of a directory;
+ 0 selects the number of hardware threads
+ @return number of added files
+ @details
+ A document is read only if its path, modification time, or size differs from
+ the cached ones or if it was cached with a different @b search_depth.
+*******************************************************************************/
+OWLCPP_IO_DECL std::size_t add(
+         Catalog& cat,
+         Catalog_cache& cache,
+         boost::filesystem::path const& path,
+         const bool recurse = false,
+         const std::size_t search_depth = std::numeric_limits<std::size_t>::max(),
+         const unsigned n_threads = 0
 );
 
 
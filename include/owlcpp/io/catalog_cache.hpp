@@ -0,0 +1,95 @@
+/** @file "/owlcpp/include/owlcpp/io/catalog_cache.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef CATALOG_CACHE_HPP_
+#define CATALOG_CACHE_HPP_
+#include <map>
+#include <string>
+#include "boost/cstdint.hpp"
+#include "boost/filesystem/path.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{
+
+/**@brief Persistent record of ontology IDs found in ontology documents.
+@details Each entry is keyed by the canonical document path and stores
+the modification time and size of the file at the time it was read.
+An entry is used only if the file has not changed since.
+Entries that were neither found nor inserted since the cache was loaded
+belong to documents that are no longer scanned; prune() removes them.
+Cache files are written in native byte order and are not meant to be
+shared between platforms.
+*******************************************************************************/
+class OWLCPP_IO_DECL Catalog_cache {
+public:
+   struct Err : public Input_err {};
+
+   struct Entry {
+      Entry() : mtime(0), size(0), search_depth(0) {}
+      boost::int64_t mtime;
+      boost::uint64_t size;
+      boost::uint64_t search_depth;
+      std::string iri;
+      std::string version;
+   };
+
+   /**@return entry with modification time and size of @b path and
+    with empty ontology IDs
+    */
+   static Entry stamp(std::string const& path, const std::size_t search_depth);
+
+   Catalog_cache() {}
+
+   /**@brief load cache
+    @param file path to cache file;
+    missing, corrupt, or incompatible cache files are ignored
+    */
+   explicit Catalog_cache(boost::filesystem::path const& file);
+
+   std::size_t size() const {return m_.size();}
+   bool empty() const {return m_.empty();}
+
+   /**@return pointer to cached entry for @b path if it was made with same
+    modification time, size, and search depth as @b stamp; otherwise 0
+    @details found entry is marked as seen
+    */
+   Entry const* find(std::string const& path, Entry const& stamp) const;
+
+   /**@brief store entry and mark it as seen
+    @details Entries of files modified within the last two seconds are not
+    stored, since a later change within the same second would not change
+    the modification time.
+    */
+   void insert(std::string const& path, Entry const& entry);
+
+   /**@brief remove entries that were not seen since the cache was loaded
+    @return number of removed entries
+    */
+   std::size_t prune();
+
+   /**@brief replace current entries with the ones stored in @b file
+    @throw Err if file cannot be read or has wrong format
+    */
+   void load(boost::filesystem::path const& file);
+
+   /**@brief write all entries to @b file;
+    call prune() first to drop entries of documents that were not scanned
+    @throw Err if file cannot be written
+    */
+   void save(boost::filesystem::path const& file) const;
+
+private:
+   struct Record : public Entry {
+      Record() : seen(false) {}
+      mutable bool seen;
+   };
+   typedef std::map<std::string, Record> map_t;
+   map_t m_;
+};
+
+}//namespace owlcpp
+#endif /* CATALOG_CACHE_HPP_ */
@@ -0,0 +1,92 @@
+/** @file "/owlcpp/include/owlcpp/io/doc_reloader.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef DOC_RELOADER_HPP_
+#define DOC_RELOADER_HPP_
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/filesystem/path.hpp"
+
+#include "owlcpp/doc_id.hpp"
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{
+class OWLCPP_IO_DECL Triple_store;
+class OWLCPP_IO_DECL Catalog;
+
+/**@brief Replace ontology documents of a live triple store when their
+files change
+@details Content hashes of document files are recorded on construction and
+after each reload.
+A document is re-parsed only if the hash of its file differs from the
+recorded one.
+Triples and blank nodes of the old version are removed and the new version
+is added under the same document ID.
+Other documents and their nodes keep their IDs.
+*******************************************************************************/
+class OWLCPP_IO_DECL Doc_reloader {
+public:
+   struct Err : public Input_err {};
+
+   /**@brief Outcome of reloading a document */
+   struct Report {
+      Report() : changed(false), doc(), imported(), orphaned() {}
+
+      /** false if the file has not changed and the document was kept */
+      bool changed;
+
+      /** ID of the reloaded document */
+      Doc_id doc;
+
+      /** documents loaded because the new version imports them */
+      std::vector<Doc_id> imported;
+
+      /** documents imported by the old version that are no longer imported
+       by any document in the store; they are not removed */
+      std::vector<Doc_id> orphaned;
+   };
+
+   /**
+    @param store triple store
+    @param cat catalog of ontology documents used for locating new imports
+    @param n_threads maximal number of threads used for parsing imports;
+    0 selects the number of hardware threads
+    @details Content hashes are recorded for all documents of @b store
+    whose files can be read.
+   */
+   Doc_reloader(
+            Triple_store& store,
+            Catalog const& cat,
+            const unsigned n_threads = 0
+   );
+
+   /**@brief record current content hash of document file */
+   void track(const Doc_id did);
+
+   /**@brief reload document if its file has changed
+    @throw Err if the document has no path or its file cannot be read;
+    Input_err if the new version cannot be parsed, in which case the store
+    remains unchanged, or if its imports cannot be loaded
+   */
+   Report reload(const Doc_id did);
+
+   /**@brief reload document located at @b file
+    @throw Err if no document in the store has the path of @b file
+   */
+   Report reload(boost::filesystem::path const& file);
+
+private:
+   typedef std::map<std::string, boost::uint64_t> map_t;
+   Triple_store& store_;
+   Catalog const& cat_;
+   const unsigned n_threads_;
+   map_t hashes_;
+};
+
+}//namespace owlcpp
+#endif /* DOC_RELOADER_HPP_ */
@@ -43,6 +43,9 @@ void load(
 @param path optional path to ontology document, used for identification only
 @param check reference to a polymorphic class that checks that the input ontology
 has the expected ontologyIRI and versionIRI.
+@param n_threads maximal number of threads used for parsing imports;
+0 selects the number of hardware threads, 1 parses imports sequentially.
+Imports are always added to the store in the same order.
 @throw Input_err if input ontology contains an error or an ontology with the same
 ID is already in the triple store.
 If an exception is thrown, the destination triple store remains unchanged.
@@ -53,7 +56,8 @@ void load(
          Triple_store& store,
          Catalog const& cat,
          std::string const& path = "",
-         Check_id const& check = Check_id()
+         Check_id const& check = Check_id(),
+         const unsigned n_threads = 0
 );
 
 /**@brief Load ontology from file ignoring imports
@@ -64,6 +68,13 @@ has the expected ontologyIRI and versionIRI.
 @throw Input_err if input ontology contains an error or an ontology with the same
 ID has already been loaded into the triple store.
 If an exception is thrown, the destination triple store remains unchanged.
+@details Files with extensions @c .nt and @c .nq, optionally followed by
+@c .gz, @c .xz, or @c .zst, are loaded with load_ntriples();
+other files are parsed as RDF/XML.
+Files compressed with gzip, xz, or zstd are detected from their first bytes
+and decompressed in a separate thread while being parsed.
+Parsing of large files overlaps with node interning in a separate thread
+when more than one hardware thread is available.
 *******************************************************************************/
 OWLCPP_IO_DECL
 void load_file(
@@ -72,12 +83,40 @@ void load_file(
          Check_id const& check = Check_id()
 );
 
+/**@brief Load N-Triples or N-Quads file ignoring imports
+@param file filesystem path to N-Triples or N-Quads document
+@param store triple store
+@param check reference to a polymorphic class that checks that the ontology
+in the default graph has the expected ontologyIRI and versionIRI.
+@param n_threads maximal number of parsing threads;
+0 selects the number of hardware threads.
+@throw Input_err if the document contains an error or an ontology with the same
+ID has already been loaded into the triple store.
+If an exception is thrown, the destination triple store remains unchanged.
+@details The file is memory-mapped and split at line boundaries into chunks
+that are parsed concurrently; parsed statements are inserted into
+the store in document order.
+Compressed files are decompressed in a separate thread and parsed in batches.
+Each named graph of N-Quads document is stored as a separate document,
+which has the graph IRI as its ontologyIRI.
+*******************************************************************************/
+OWLCPP_IO_DECL
+void load_ntriples(
+         boost::filesystem::path const& file,
+         Triple_store& store,
+         Check_id const& check = Check_id(),
+         const unsigned n_threads = 0
+);
+
 /**@brief Load ontology from file ignoring imports
 @param file filesystem path to ontology document
 @param store triple store
 @param cat catalog of ontology documents used for locating imports
 @param check reference to a polymorphic class that checks that the input ontology
 has the expected ontologyIRI and versionIRI.
+@param n_threads maximal number of threads used for parsing imports;
+0 selects the number of hardware threads, 1 parses imports sequentially.
+Imports are always added to the store in the same order.
 @throw Input_err if input ontology contains an error or an ontology with the same
 ID has already been loaded into the triple store.
 If an exception is thrown, the destination triple store remains unchanged.
@@ -87,7 +126,8 @@ void load_file(
          boost::filesystem::path const& file,
          Triple_store& store,
          Catalog const& cat,
-         Check_id const& check = Check_id()
+         Check_id const& check = Check_id(),
+         const unsigned n_threads = 0
 );
 
 /**Example of loading ontologies into triple store
@@ -98,12 +138,20 @@ void load_file(
 @param iri ontology versionIRI or ontologyIRI
 @param store triple store
 @param cat catalog of ontology documents used for locating imports
+@param n_threads maximal number of threads used for parsing imports;
+0 selects the number of hardware threads, 1 parses imports sequentially.
+Imports are always added to the store in the same order.
 @throw Input_err if input ontology contains an error or an ontology with the same
 ID has already been loaded into the triple store.
 If an exception is thrown, the destination triple store remains unchanged.
 *******************************************************************************/
 OWLCPP_IO_DECL
-void load_iri(std::string const& iri, Triple_store& store, Catalog const& cat);
+void load_iri(
+         std::string const& iri,
+         Triple_store& store,
+         Catalog const& cat,
+         const unsigned n_threads = 0
+);
 
 
 }//namespace owlcpp
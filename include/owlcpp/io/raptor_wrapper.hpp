@@ -38,18 +38,45 @@ public:
       return pref;
    }
 
-   Raptor_wrapper();
+   /** default size of data blocks passed to the parser, 256KB */
+   static std::size_t default_chunk_size() {return 1 << 18;}
 
+   /**@param chunk_size size of data blocks passed to the parser;
+    0 selects default_chunk_size()
+   */
+   explicit Raptor_wrapper(const std::size_t chunk_size = default_chunk_size());
+
+   std::size_t chunk_size() const {return chunk_size_;}
+
+   /**@brief parse RDF/XML stream
+    @details Stream is read and parsed in blocks of chunk_size() bytes.
+    Base URI is "from_stream".
+   */
    template<class Sink> void operator()(std::istream& stream, Sink& sink) {
       setup(&sink, &handle_statement<Sink>);
       parse(stream);
    }
 
+   /**@brief parse RDF/XML file with raptor's own file reader
+    @details File URI is used as base URI.
+   */
    template<class Sink> void operator()(std::string const& file, Sink& sink) {
       setup(&sink, &handle_statement<Sink>);
       parse(file);
    }
 
+   /**@brief parse memory-mapped RDF/XML file
+    @details Mapped data is passed to the parser in blocks of chunk_size()
+    bytes without copying.
+    Files compressed with gzip, xz, or zstd are detected from their first
+    bytes and decompressed in a separate thread while being parsed.
+    Base URI is "from_stream", same as when parsing the file as a stream.
+   */
+   template<class Sink> void parse_mapped(std::string const& file, Sink& sink) {
+      setup(&sink, &handle_statement<Sink>);
+      parse_mapped(file);
+   }
+
    const boost::function<void()> abort_call() {
       return boost::bind(&Raptor_wrapper::abort_parse, this);
    }
@@ -57,6 +84,7 @@ public:
 private:
    boost::shared_ptr<raptor_world> world_;
    boost::shared_ptr<raptor_parser> parser_;
+   std::size_t chunk_size_;
    bool abort_requested_;
 
    void abort_parse();
@@ -67,6 +95,14 @@ private:
 
    void parse(std::string const&);
 
+   void parse_mapped(std::string const&);
+
+   void parse_compressed(std::string const&);
+
+   boost::shared_ptr<raptor_uri> parse_start();
+
+   void parse_chunk(char const* data, const std::size_t n, const bool end);
+
    template<class Sink> static void handle_statement(void* data, const void* rs) {
       static_cast<Sink*>(data)->insert(rs);
    }
@@ -14,6 +14,7 @@ part of owlcpp project.
 #include "owlcpp/io/config.hpp"
 
 namespace owlcpp{
+class OWLCPP_IO_DECL Raptor_wrapper;
 
 /**@brief Find ontologyIRI and versionIRI declarations in a stream containing
 ontology document
@@ -29,7 +30,10 @@ read_ontology_iri(
 );
 
 /**@brief find ontologyIRI and versionIRI declarations in ontology document
-@param file filesystem path to ontology document
+@param file filesystem path to ontology document;
+compressed documents are decompressed while being read;
+documents with @c .nt or @c .nq extension are read as N-Triples or N-Quads
+and only their default graph is searched
 @param search_depth once ontologyIRI declaration is found, stop searching for
 versionIRI declaration after @b search_depth triples
 @return ontologyIRI and versionIRI strings
@@ -40,5 +44,38 @@ read_ontology_iri(
          const std::size_t search_depth = std::numeric_limits<std::size_t>::max()
 );
 
+/**@brief Find ontologyIRI and versionIRI declarations in a stream containing
+ontology document using existing parser
+@param is input stream containing ontology document
+@param parser RDF parser; it may be reused for reading several documents
+@param search_depth once ontologyIRI declaration is found, stop searching for
+versionIRI declaration after @b search_depth triples
+@return ontologyIRI and versionIRI strings
+*******************************************************************************/
+OWLCPP_IO_DECL std::pair<std::string,std::string>
+read_ontology_iri(
+         std::istream& is,
+         Raptor_wrapper& parser,
+         const std::size_t search_depth = std::numeric_limits<std::size_t>::max()
+);
+
+/**@brief Find ontologyIRI and versionIRI declarations in ontology document
+using existing parser
+@param file filesystem path to ontology document;
+compressed documents are decompressed while being read;
+documents with @c .nt or @c .nq extension are read as N-Triples or N-Quads
+and only their default graph is searched
+@param parser RDF/XML parser; it may be reused for reading several documents
+@param search_depth once ontologyIRI declaration is found, stop searching for
+versionIRI declaration after @b search_depth triples
+@return ontologyIRI and versionIRI strings
+*******************************************************************************/
+OWLCPP_IO_DECL std::pair<std::string,std::string>
+read_ontology_iri(
+         boost::filesystem::path const& file,
+         Raptor_wrapper& parser,
+         const std::size_t search_depth = std::numeric_limits<std::size_t>::max()
+);
+
 }//namespace owlcpp
 #endif /* READ_ONTOLOGY_IRI_HPP_ */
@@ -0,0 +1,46 @@
+/** @file "/owlcpp/include/owlcpp/io/snapshot.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef SNAPSHOT_HPP_
+#define SNAPSHOT_HPP_
+#include "boost/filesystem/path.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{
+class OWLCPP_IO_DECL Triple_store;
+
+/**@brief Save triple store to binary snapshot file
+@param store triple store
+@param file path to snapshot file
+@throw Input_err if file cannot be written
+@details Snapshot contains user-defined namespace IRIs and their prefixes,
+nodes, documents, and triples, all with their original IDs.
+Snapshots are written in native byte order and can only be loaded by
+a library built with same limits on the number of standard terms.
+*******************************************************************************/
+OWLCPP_IO_DECL void save_snapshot(
+         Triple_store const& store,
+         boost::filesystem::path const& file
+);
+
+/**@brief Load triple store from binary snapshot file
+@param file path to snapshot file created by save_snapshot()
+@param store empty triple store with same standard nodes as the saved one
+@throw Input_err if the store is not empty or if the file cannot be read,
+has a wrong format, or is inconsistent.
+If an exception is thrown, the destination triple store remains empty.
+@details The file is memory-mapped; nodes are placed directly under their
+saved IDs and triple indices are built with a single batch insertion
+from the mapped triple array.
+*******************************************************************************/
+OWLCPP_IO_DECL void load_snapshot(
+         boost::filesystem::path const& file,
+         Triple_store& store
+);
+
+}//namespace owlcpp
+#endif /* SNAPSHOT_HPP_ */
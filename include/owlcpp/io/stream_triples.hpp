@@ -0,0 +1,90 @@
+/** @file "/owlcpp/include/owlcpp/io/stream_triples.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef STREAM_TRIPLES_HPP_
+#define STREAM_TRIPLES_HPP_
+#include <string>
+#include "boost/filesystem/path.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{
+class OWLCPP_IO_DECL Catalog;
+
+/**@brief RDF term of a streamed statement
+@details Strings refer to parser buffers and are only valid during the call
+to Statement_visitor::visit().
+*******************************************************************************/
+struct Stream_term {
+   enum Kind {Iri, Blank, Literal};
+
+   Stream_term() : kind(Iri) {}
+
+   Kind kind;
+   boost::string_ref value; ///< IRI, blank node label, or literal value
+   boost::string_ref datatype; ///< datatype IRI of literal; may be empty
+   boost::string_ref language; ///< language tag of literal; may be empty
+};
+
+/**@brief Receive statements of streamed documents
+*******************************************************************************/
+class OWLCPP_IO_DECL Statement_visitor {
+public:
+   /** called before the statements of each document */
+   void document(std::string const& path) {document_impl(path);}
+
+   void visit(
+            Stream_term const& subj,
+            Stream_term const& pred,
+            Stream_term const& obj
+   ) {
+      visit_impl(subj, pred, obj);
+   }
+
+   virtual ~Statement_visitor() {}
+
+private:
+   virtual void document_impl(std::string const&) {}
+   virtual void visit_impl(
+            Stream_term const&,
+            Stream_term const&,
+            Stream_term const&
+   ) = 0;
+};
+
+/**@brief Parse ontology document and pass its statements to visitor
+without storing them
+@param file RDF/XML, N-Triples, or N-Quads document, possibly compressed
+@param visitor receives the statements
+@throw Input_err if the document contains an error; some of the statements
+preceding the error may have been passed to @b visitor.
+@details Memory used does not depend on document size.
+Blank node labels are scoped to the document.
+Graph labels of N-Quads statements are ignored.
+*******************************************************************************/
+OWLCPP_IO_DECL void stream_file(
+         boost::filesystem::path const& file,
+         Statement_visitor& visitor
+);
+
+/**@brief Parse ontology document and its import closure and pass their
+statements to visitor without storing them
+@param file ontology document
+@param visitor receives the statements
+@param cat catalog of ontology documents used for locating imports
+@throw Input_err if a document cannot be found or contains an error
+@details Documents are streamed one at a time in breadth-first order of
+imports; each document is streamed once.
+*******************************************************************************/
+OWLCPP_IO_DECL void stream_file(
+         boost::filesystem::path const& file,
+         Statement_visitor& visitor,
+         Catalog const& cat
+);
+
+}//namespace owlcpp
+#endif /* STREAM_TRIPLES_HPP_ */
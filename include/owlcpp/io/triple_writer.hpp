@@ -0,0 +1,88 @@
+/** @file "/owlcpp/include/owlcpp/io/triple_writer.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef TRIPLE_WRITER_HPP_
+#define TRIPLE_WRITER_HPP_
+#include <iosfwd>
+#include <string>
+#include "boost/foreach.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/scoped_ptr.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+#include "owlcpp/rdf/triple.hpp"
+
+namespace owlcpp{
+class OWLCPP_IO_DECL Triple_store;
+namespace detail{
+class Ns_strings;
+class Node_renderer;
+}
+
+/**@brief Buffered writer of triples in N-Triples or Turtle format
+@details Namespace IRIs and prefixes are rendered once, when the writer is
+created; nodes are rendered directly into an output buffer, which is written
+to the stream when it becomes full.
+In Turtle format, prefix declarations for all namespaces with prefixes are
+written first and IRIs are abbreviated where possible.
+Blank nodes are labeled by their document and index.
+@n The store should not be modified while the writer exists.
+*******************************************************************************/
+class OWLCPP_IO_DECL Triple_writer : boost::noncopyable {
+public:
+   enum Format {Ntriples, Turtle};
+
+   static std::size_t default_buffer_size() {return 1 << 20;}
+
+   Triple_writer(
+            Triple_store const& store,
+            std::ostream& os,
+            const Format format = Ntriples,
+            const std::size_t buffer_size = default_buffer_size()
+   );
+
+   /** Flush buffered statements ignoring errors */
+   ~Triple_writer();
+
+   void write(Triple const& t);
+
+   /** write range of triples, e.g., obtained from find_triple() */
+   template<class Range> void write_range(Range const& r) {
+      BOOST_FOREACH(Triple const& t, r) write(t);
+   }
+
+   /**@throw Input_err if the stream fails */
+   void flush();
+
+private:
+   std::ostream& os_;
+   const std::size_t buffer_size_;
+   std::string buff_;
+   boost::scoped_ptr<detail::Ns_strings> ns_;
+   boost::scoped_ptr<detail::Node_renderer> renderer_;
+};
+
+/**@brief Write all triples of the store in N-Triples or Turtle format
+@param store triple store
+@param os output stream
+@param format output format
+@param n_threads maximal number of threads rendering triples;
+0 selects the number of hardware threads
+@throw Input_err if the stream fails
+@details Triples are grouped by document in a single pass over the store
+and written document by document.
+Document partitions are split into segments that are rendered concurrently
+into separate buffers and written in order.
+*******************************************************************************/
+OWLCPP_IO_DECL void write_triples(
+         Triple_store const& store,
+         std::ostream& os,
+         const Triple_writer::Format format = Triple_writer::Ntriples,
+         const unsigned n_threads = 0
+);
+
+}//namespace owlcpp
+#endif /* TRIPLE_WRITER_HPP_ */
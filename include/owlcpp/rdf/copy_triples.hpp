@@ -5,8 +5,8 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef COPY_TRIPLES_HPP_
 #define COPY_TRIPLES_HPP_
+#include <vector>
 #include "boost/foreach.hpp"
-#include "boost/unordered_map.hpp"
 #include "boost/assert.hpp"
 
 #include "owlcpp/rdf/triple.hpp"
@@ -16,13 +16,38 @@ part of owlcpp project.
 
 namespace owlcpp{ namespace detail{
 
+/**@brief Map source IDs to destination IDs
+@details Source IDs are assumed to be dense, so the mapping is stored in a
+vector indexed by source ID.
+*******************************************************************************/
+template<class Id> class Id_remap {
+public:
+   /**@return pointer to mapped ID or NULL */
+   Id const* find(const Id id0) const {
+      if( id0() >= v_.size() || ! mapped_[id0()] ) return 0;
+      return &v_[id0()];
+   }
+
+   void insert(const Id id0, const Id id1) {
+      if( id0() >= v_.size() ) {
+         v_.resize(id0() + 1, Id(0));
+         mapped_.resize(id0() + 1, false);
+      }
+      v_[id0()] = id1;
+      mapped_[id0()] = true;
+   }
+
+   void reserve(const std::size_t n) {
+      v_.reserve(n);
+      mapped_.reserve(n);
+   }
+
+private:
+   std::vector<Id> v_;
+   std::vector<bool> mapped_;
+};
+
 template<class Src, class Dest> class Node_copier : public Visitor_node {
-   typedef boost::unordered_map<Node_id,Node_id> node_map_t;
-   typedef node_map_t::const_iterator node_iter_t;
-   typedef boost::unordered_map<Doc_id,Doc_id> doc_map_t;
-   typedef doc_map_t::const_iterator doc_iter_t;
-   typedef boost::unordered_map<Ns_id,Ns_id> ns_map_t;
-   typedef ns_map_t::const_iterator ns_iter_t;
 
    typedef detail::Map_traits<Src> traits;
    typedef typename traits::doc_type doc_type;
@@ -30,28 +55,33 @@ template<class Src, class Dest> class Node_copier : public Visitor_node {
 public:
    Node_copier(Src const& src, Dest& dest)
    : src_(src), dest_(dest)
-   {}
+   {
+      nm_.reserve(src.map_node().size() + detail::min_node_id()());
+   }
 
    void operator()(Triple const& t) {
+      dest_.insert(cp(t));
+   }
+
+   /**@return copy of the triple with IDs from destination store */
+   Triple cp(Triple const& t) {
       const Node_id subj = cp(t.subj_);
       const Node_id pred = cp(t.pred_);
       const Node_id obj  = cp(t.obj_);
       const  Doc_id doc  = cp(t.doc_);
-      dest_.insert(Triple::make(subj, pred, obj, doc));
+      return Triple::make(subj, pred, obj, doc);
    }
 
    Node_id cp(const Node_id nid0) {
-      const node_iter_t i = nm_.find(nid0);
-      if( i != nm_.end() ) return i->second;
+      if( Node_id const* id = nm_.find(nid0) ) return *id;
       Node const& node = src_[nid0];
       node.accept(*this);
-      nm_.emplace(nid0, last_inserted_id_);
+      nm_.insert(nid0, last_inserted_id_);
       return last_inserted_id_;
    }
 
    Doc_id cp(const Doc_id did0) {
-      const doc_iter_t i = dm_.find(did0);
-      if( i != dm_.end() ) return i->second;
+      if( Doc_id const* id = dm_.find(did0) ) return *id;
       doc_type const& doc = src_[did0];
       const Node_id iri_id = cp(doc.ontology_iri);
       const Node_id vers_id = cp(doc.version_iri);
@@ -68,13 +98,12 @@ public:
       //operations, with multiple instances of %Node_copier
       //BOOST_ASSERT(p.second);
 
-      dm_.emplace(did0, p.first);
+      dm_.insert(did0, p.first);
       return p.first;
    }
 
    Ns_id cp(const Ns_id nsid0) {
-      const ns_iter_t i = nsm_.find(nsid0);
-      if( i != nsm_.end() ) return i->second;
+      if( Ns_id const* id = nsm_.find(nsid0) ) return *id;
       const Ns_id nsid1 = dest_.insert(src_[nsid0]);
       std::string const& pref = src_.prefix(nsid0);
       if(
@@ -84,16 +113,16 @@ public:
       ) {
          dest_.insert_prefix(nsid1, pref);
       }
-      nsm_.emplace(nsid0, nsid1);
+      nsm_.insert(nsid0, nsid1);
       return nsid1;
    }
 
 private:
    Src const& src_;
    Dest& dest_;
-   node_map_t nm_;
-   doc_map_t dm_;
-   ns_map_t nsm_;
+   Id_remap<Node_id> nm_;
+   Id_remap<Doc_id> dm_;
+   Id_remap<Ns_id> nsm_;
    Node_id last_inserted_id_; /**< return value from visit_impl methods */
 
    void visit_impl(Node_iri const& node) {
@@ -154,7 +183,9 @@ template<class Range, class Src, class Dest> inline void copy_triples(
          Dest& dest
 ) {
    detail::Node_copier<Src, Dest> copier(src, dest);
-   BOOST_FOREACH(Triple const& t, r) copier(t);
+   std::vector<Triple> v;
+   BOOST_FOREACH(Triple const& t, r) v.push_back(copier.cp(t));
+   dest.insert(v.begin(), v.end());
 }
 
 /**@brief copy all triples from one store to another
@@ -24,33 +24,33 @@ template<class Super> struct Crtpb_ns_node_iri {
     (e.g., UTF-8, or %HH)
     @return node ID
    */
-   Node_id insert_node_iri(std::string const& iri) {
+   Node_id insert_node_iri(boost::string_ref const& iri) {
       BOOST_CONCEPT_ASSERT((Ns_store<Super>));
       BOOST_CONCEPT_ASSERT((Iri_node_store<Super>));
       Super& super = static_cast<Super&>(*this);
-      std::size_t n;
-      const Ns_id iid = super.insert(remove_fragment(iri, n));
+      boost::string_ref frag;
+      const Ns_id iid = super.insert(split_fragment(iri, frag));
       try{
-         return super.insert_node_iri( iid, iri.substr(n) );
+         return super.insert_node_iri( iid, frag );
       } catch(base_exception const&) {
          typedef typename Super::Err Err;
          BOOST_THROW_EXCEPTION(
                   Err()
                   << typename Err::msg_t("error inserting IRI")
-                  << typename Err::str1_t( iri )
+                  << typename Err::str1_t( iri.to_string() )
                   << typename Err::nested_t(boost::current_exception())
          );
       }
    }
 
-   Node_id const* find_node_iri(std::string const& iri) const {
+   Node_id const* find_node_iri(boost::string_ref const& iri) const {
       BOOST_CONCEPT_ASSERT((Ns_store<Super>));
       BOOST_CONCEPT_ASSERT((Iri_node_store<Super>));
-      std::size_t n;
+      boost::string_ref frag;
       Super const& super = static_cast<Super const&>(*this);
-      Ns_id const*const ns_id = super.find(remove_fragment(iri, n));
+      Ns_id const*const ns_id = super.find(split_fragment(iri, frag));
       if( ! ns_id ) return 0;
-      return super.find_node_iri( *ns_id, iri.substr(n) );
+      return super.find_node_iri( *ns_id, frag );
    }
 
 };
@@ -0,0 +1,87 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/fragment_inserter.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef FRAGMENT_INSERTER_HPP_
+#define FRAGMENT_INSERTER_HPP_
+#include <algorithm>
+#include <vector>
+
+#include "owlcpp/detail/parallel_for.hpp"
+#include "owlcpp/rdf/triple.hpp"
+
+namespace owlcpp{ namespace map_triple_detail{
+
+/**@brief Merge sorted groups of triples into their index fragments
+@details Each group is merged into a different fragment, so that groups
+can be merged concurrently.
+Groups are split into contiguous slices with similar numbers of triples;
+each slice is one task for parallel_for.
+*******************************************************************************/
+template<class Set> class Fragment_inserter {
+   typedef std::vector<Triple>::const_iterator iter_t;
+
+   struct Group {
+      Group(Set& s, const iter_t first, const iter_t last)
+      : s_(&s), first_(first), last_(last) {}
+      Set* s_;
+      iter_t first_;
+      iter_t last_;
+   };
+
+public:
+   /**@brief add group of triples
+    @param s index fragment
+    @param first,last triples sorted in the order of the fragment
+   */
+   void add(Set& s, const iter_t first, const iter_t last) {
+      g_.push_back(Group(s, first, last));
+   }
+
+   /**@brief merge all groups
+    @param n_threads maximal number of threads; 0 selects the number of
+    hardware threads
+    @return number of inserted triples
+   */
+   std::size_t run(const unsigned n_threads) {
+      std::size_t nt = detail::n_threads_default(n_threads);
+      if( nt < 2 || g_.size() < 2 ) return merge(0, g_.size());
+
+      //several slices per thread to even out large groups
+      const std::size_t ns = std::min(nt * 4, g_.size());
+      const std::size_t total = g_.back().last_ - g_.front().first_;
+      b_.assign(1, 0);
+      std::size_t n = 0;
+      for(std::size_t i = 0; i != g_.size(); ++i) {
+         n += g_[i].last_ - g_[i].first_;
+         if( n * ns >= total * b_.size() ) b_.push_back(i + 1);
+      }
+      if( b_.back() != g_.size() ) b_.push_back(g_.size());
+      n_.assign(b_.size() - 1, 0);
+      detail::parallel_for(n_.size(), *this, nt);
+      n = 0;
+      for(std::size_t i = 0; i != n_.size(); ++i) n += n_[i];
+      return n;
+   }
+
+   /**@brief merge slice @b i; called by parallel_for */
+   void operator()(const std::size_t i) {n_[i] = merge(b_[i], b_[i + 1]);}
+
+private:
+   std::vector<Group> g_;
+   std::vector<std::size_t> b_; ///< slice boundaries
+   std::vector<std::size_t> n_; ///< numbers of triples inserted in each slice
+
+   std::size_t merge(const std::size_t first, const std::size_t last) {
+      std::size_t n = 0;
+      for(std::size_t i = first; i != last; ++i) {
+         n += g_[i].s_->insert_sorted(g_[i].first_, g_[i].last_);
+      }
+      return n;
+   }
+};
+
+}//namespace map_triple_detail
+}//namespace owlcpp
+#endif /* FRAGMENT_INSERTER_HPP_ */
@@ -0,0 +1,120 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/fragment_table.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef FRAGMENT_TABLE_HPP_
+#define FRAGMENT_TABLE_HPP_
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "boost/foreach.hpp"
+
+namespace owlcpp{ namespace map_triple_detail{
+
+/**@brief Triple index fragments mapped against consecutive IDs
+@details IDs are split into pages of page_size() consecutive values.
+A page stores its sets sparsely, as (ID, set) pairs sorted by ID, until the
+number of sets exceeds dense_min(); then the page becomes a dense array
+with a slot for every ID.
+IDs of pages without sets take no space beside the page table.
+*******************************************************************************/
+template<class Set> class Fragment_table {
+   typedef std::pair<unsigned, Set> sparse_value;
+   typedef typename std::vector<sparse_value>::iterator sparse_iter;
+   typedef typename std::vector<sparse_value>::const_iterator sparse_citer;
+
+   struct Page {
+      std::vector<sparse_value> sparse_;
+      std::vector<Set> dense_;
+   };
+
+   struct Less {
+      bool operator()(sparse_value const& v, const unsigned n) const {
+         return v.first < n;
+      }
+   };
+
+public:
+   static unsigned page_bits() {return 8;}
+   static unsigned page_size() {return 1U << page_bits();}
+
+   /**@brief maximal number of sets in a sparse page */
+   static std::size_t dense_min() {
+      return page_size() * sizeof(Set) / sizeof(sparse_value);
+   }
+
+   Fragment_table() : p_(), n_(0) {}
+
+   /**@return number of IDs covered by the table, i.e., largest ID + 1 */
+   std::size_t size() const {return n_;}
+
+   /**@return pointer to set for @b id or NULL if there is no set */
+   Set const* find(const std::size_t id) const {
+      if( id >= n_ ) return 0;
+      Page const& p = p_[id >> page_bits()];
+      const unsigned n = local(id);
+      if( ! p.dense_.empty() ) return &p.dense_[n];
+      const sparse_citer i =
+               std::lower_bound(p.sparse_.begin(), p.sparse_.end(), n, Less());
+      if( i == p.sparse_.end() || i->first != n ) return 0;
+      return &i->second;
+   }
+
+   /**@return set for @b id, which is inserted if needed
+    @details Inserting a set may invalidate references to other sets of the
+    same page.
+   */
+   Set& get(const std::size_t id) {
+      if( id >= n_ ) {
+         n_ = id + 1;
+         p_.resize((id >> page_bits()) + 1);
+      }
+      Page& p = p_[id >> page_bits()];
+      const unsigned n = local(id);
+      if( ! p.dense_.empty() ) return p.dense_[n];
+      const sparse_iter i =
+               std::lower_bound(p.sparse_.begin(), p.sparse_.end(), n, Less());
+      if( i != p.sparse_.end() && i->first == n ) return i->second;
+      if( p.sparse_.size() < dense_min() ) {
+         return p.sparse_.insert(i, sparse_value(n, Set()))->second;
+      }
+      p.dense_.resize(page_size());
+      BOOST_FOREACH(sparse_value& v, p.sparse_) p.dense_[v.first].swap(v.second);
+      std::vector<sparse_value>().swap(p.sparse_);
+      return p.dense_[n];
+   }
+
+   /**@brief Remove empty set of sparse page */
+   void erase(const std::size_t id) {
+      if( id >= n_ ) return;
+      Page& p = p_[id >> page_bits()];
+      if( ! p.dense_.empty() ) return;
+      const unsigned n = local(id);
+      const sparse_iter i =
+               std::lower_bound(p.sparse_.begin(), p.sparse_.end(), n, Less());
+      if( i != p.sparse_.end() && i->first == n ) p.sparse_.erase(i);
+   }
+
+   void clear() {
+      std::vector<Page>().swap(p_);
+      n_ = 0;
+   }
+
+   void swap(Fragment_table& t) {
+      p_.swap(t.p_);
+      std::swap(n_, t.n_);
+   }
+
+private:
+   std::vector<Page> p_;
+   std::size_t n_;
+
+   static unsigned local(const std::size_t id) {
+      return static_cast<unsigned>(id & (page_size() - 1));
+   }
+};
+
+}//namespace map_triple_detail
+}//namespace owlcpp
+#endif /* FRAGMENT_TABLE_HPP_ */
@@ -89,6 +89,21 @@ public:
       return i == map_.end() ? 0 : &i->second;
    }
 
+   /**@brief find object equal to a key of different type
+    @param key lookup key
+    @param hash function object; hash(key) should be same as
+    hash_value() of equal object
+    @param eq function object comparing key with object
+   */
+   template<class Key, class Hash, class Eq> id_type const* find(
+            Key const& key,
+            Hash const& hash,
+            Eq const& eq
+   ) const {
+      const const_iterator i = map_.find(key, hash, eq);
+      return i == map_.end() ? 0 : &i->second;
+   }
+
    id_type insert(obj_type const& obj) {
       std::pair<iterator,bool> ip = map_.emplace(obj, id_type());
       if( ip.second ) {
@@ -20,7 +20,8 @@ part of owlcpp project.
 
 #define OWLCPP_TRIPLE_INDEX_CONFIG_MACRO_(r, data, i, elem)                   \
    BOOST_PP_COMMA_IF(i)                                                       \
-   ::boost::mpl::vector4<BOOST_PP_SEQ_ENUM(                                   \
+   ::boost::mpl::BOOST_PP_CAT(vector, BOOST_PP_SEQ_SIZE(elem))<              \
+      BOOST_PP_SEQ_ENUM(                                                      \
             BOOST_PP_SEQ_TRANSFORM(                                           \
                      OWLCPP_TRIPLE_INDEX_ELEMENT_MACRO_, , elem               \
             )                                                                 \
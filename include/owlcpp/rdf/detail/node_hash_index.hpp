@@ -0,0 +1,130 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/node_hash_index.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NODE_HASH_INDEX_HPP_
+#define NODE_HASH_INDEX_HPP_
+#include <vector>
+#include "boost/assert.hpp"
+#include "boost/cstdint.hpp"
+
+#include "owlcpp/node_id.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Open addressing hash table of node IDs
+@details Only node IDs and truncated hash values are stored; keys are
+compared by a predicate that looks up the node by its ID.
+Linear probing is used; erasing shifts subsequent entries back so that
+no tombstones are needed.
+Node_id(0) marks an empty slot.
+Pointers returned by find() are invalidated by insert() and erase().
+*******************************************************************************/
+class Node_hash_index {
+   struct Slot {
+      Slot() : hash_(0), id_() {}
+      Slot(const boost::uint32_t hash, const Node_id id) : hash_(hash), id_(id) {}
+      bool empty() const {return ! id_();}
+      boost::uint32_t hash_;
+      Node_id id_;
+   };
+   typedef std::vector<Slot> vector_t;
+
+public:
+   Node_hash_index() : v_(), size_(0), bits_(0) {}
+
+   std::size_t size() const {return size_;}
+   bool empty() const {return ! size_;}
+
+   /**
+    @param hash hash value of the node
+    @param eq predicate that returns true if node with given ID equals the key
+    @return pointer to node ID or NULL
+   */
+   template<class Eq> Node_id const* find(const std::size_t hash, Eq const& eq) const {
+      if( v_.empty() ) return 0;
+      const boost::uint32_t h = static_cast<boost::uint32_t>(hash);
+      for( std::size_t i = home(h); ; i = next(i) ) {
+         Slot const& s = v_[i];
+         if( s.empty() ) return 0;
+         if( s.hash_ == h && eq(s.id_) ) return &s.id_;
+      }
+   }
+
+   /**@brief insert ID of a node that is not in the index */
+   void insert(const std::size_t hash, const Node_id id) {
+      BOOST_ASSERT(id() && "ID 0 is reserved for empty slots");
+      if( (size_ + 1) * 4 > v_.size() * 3 ) grow();
+      place(Slot(static_cast<boost::uint32_t>(hash), id));
+      ++size_;
+   }
+
+   /**@brief erase node ID; node hash should be same as when it was inserted */
+   void erase(const std::size_t hash, const Node_id id) {
+      BOOST_ASSERT( ! v_.empty() );
+      const boost::uint32_t h = static_cast<boost::uint32_t>(hash);
+      std::size_t i = home(h);
+      for( ; v_[i].id_ != id; i = next(i) ) {
+         BOOST_ASSERT( ! v_[i].empty() && "ID not found" );
+      }
+
+      //shift back entries that would become unreachable
+      for( std::size_t j = next(i); ! v_[j].empty(); j = next(j) ) {
+         const std::size_t k = home(v_[j].hash_);
+         const bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+         if( stays ) continue;
+         v_[i] = v_[j];
+         i = j;
+      }
+      v_[i] = Slot();
+      --size_;
+   }
+
+   /**@brief prepare for inserting @b n node IDs without rehashing */
+   void reserve(const std::size_t n) {
+      std::size_t b = bits_;
+      while( n * 4 > (std::size_t(1) << b) * 3 ) ++b;
+      if( b > bits_ ) rehash(b);
+   }
+
+   void clear() {
+      vector_t().swap(v_);
+      size_ = 0;
+      bits_ = 0;
+   }
+
+private:
+   vector_t v_;
+   std::size_t size_;
+   unsigned bits_;
+
+   /** Fibonacci hashing, picks high bits of the product */
+   std::size_t home(const boost::uint32_t h) const {
+      return static_cast<boost::uint32_t>(h * 2654435769U) >> (32 - bits_);
+   }
+
+   std::size_t next(const std::size_t i) const {return (i + 1) & (v_.size() - 1);}
+
+   void place(Slot const& s) {
+      std::size_t i = home(s.hash_);
+      for( ; ! v_[i].empty(); i = next(i) );
+      v_[i] = s;
+   }
+
+   void grow() {rehash(bits_ ? bits_ + 1 : 4);}
+
+   void rehash(const unsigned bits) {
+      BOOST_ASSERT(bits < 32);
+      vector_t v(std::size_t(1) << bits);
+      v.swap(v_);
+      bits_ = bits;
+      for( vector_t::const_iterator i = v.begin(); i != v.end(); ++i ) {
+         if( ! i->empty() ) place(*i);
+      }
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NODE_HASH_INDEX_HPP_ */
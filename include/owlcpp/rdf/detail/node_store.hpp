@@ -0,0 +1,195 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/node_store.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NODE_STORE_HPP_
+#define NODE_STORE_HPP_
+#include <deque>
+#include <vector>
+#include "boost/assert.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/rdf/node_blank.hpp"
+#include "owlcpp/rdf/node_iri.hpp"
+#include "owlcpp/rdf/node_literal.hpp"
+#include "owlcpp/rdf/visitor_node.hpp"
+#include "owlcpp/rdf/detail/string_pool.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Store nodes of one type contiguously
+@details Nodes are kept by value in fixed size blocks; their addresses do
+not change while they are stored.
+Slots of removed nodes are reused by subsequent insertions.
+*******************************************************************************/
+template<class T> class Node_store : boost::noncopyable {
+public:
+   T* insert(T const& node) {
+      if( free_.empty() ) {
+         store_.push_back(node);
+         return &store_.back();
+      }
+      T* p = free_.back();
+      free_.pop_back();
+      *p = node;
+      return p;
+   }
+
+   /** @param node node stored in this container */
+   void remove(T const& node) {free_.push_back(const_cast<T*>(&node));}
+
+   void clear() {
+      free_.clear();
+      store_.clear();
+   }
+
+private:
+   std::deque<T> store_;
+   std::vector<T*> free_;
+};
+
+/**@brief Type-segregated storage for polymorphic RDF nodes
+@details IRI fragments, string literal values, and language tags of stored
+nodes are interned in a String_pool, so equal strings are stored once.
+Only stored nodes refer to the pooled strings; copies of nodes own their
+strings.
+*******************************************************************************/
+class Node_stores : boost::noncopyable {
+
+   template<class Op> class Dispatch : public Visitor_node {
+   public:
+      Dispatch(Node_stores& ns, Op& op) : ns_(ns), op_(op) {}
+   private:
+      Node_stores& ns_;
+      Op& op_;
+      void visit_impl(Node_iri const& node) {op_(ns_.iri_, node);}
+      void visit_impl(Node_blank const& node) {op_(ns_.blank_, node);}
+      void visit_impl(Node_bool const& node) {op_(ns_.bool_, node);}
+      void visit_impl(Node_int const& node) {op_(ns_.int_, node);}
+      void visit_impl(Node_unsigned const& node) {op_(ns_.unsigned_, node);}
+      void visit_impl(Node_double const& node) {op_(ns_.double_, node);}
+      void visit_impl(Node_string const& node) {op_(ns_.string_, node);}
+   };
+
+   struct Insert {
+      explicit Insert(Node_stores& ns) : ns_(ns), p_(0) {}
+      template<class T> void operator()(Node_store<T>& s, T const& node) {
+         p_ = s.insert(node);
+      }
+      void operator()(Node_store<Node_iri>&, Node_iri const& node) {
+         p_ = ns_.insert_iri(node.ns_id(), node.fragment());
+      }
+      void operator()(Node_store<Node_string>&, Node_string const& node) {
+         p_ = ns_.insert_string(node.value(), node.datatype(), node.language());
+      }
+      Node_stores& ns_;
+      Node const* p_;
+   };
+
+   struct Remove {
+      explicit Remove(Node_stores& ns) : ns_(ns) {}
+      template<class T> void operator()(Node_store<T>& s, T const& node) {
+         ns_.release(node);
+         s.remove(node);
+      }
+      Node_stores& ns_;
+   };
+
+   /** interned string that is released unless kept */
+   class Interned : boost::noncopyable {
+   public:
+      Interned(String_pool& sp, boost::string_ref const& s)
+      : sp_(sp), ps_(sp.intern(s)), keep_(false)
+      {}
+      ~Interned() {if( ! keep_ ) sp_.release(ps_);}
+      Pooled_string const& get() const {return ps_;}
+      void keep() {keep_ = true;}
+   private:
+      String_pool& sp_;
+      const Pooled_string ps_;
+      bool keep_;
+   };
+
+public:
+   /**@brief store a copy of the node
+    @return pointer to the stored copy
+   */
+   Node const* insert(Node const& node) {
+      Insert op(*this);
+      Dispatch<Insert> d(*this, op);
+      node.accept(d);
+      BOOST_ASSERT(op.p_);
+      return op.p_;
+   }
+
+   /**@brief store IRI node without making a temporary copy of its fragment */
+   Node_iri const* insert_iri(const Ns_id ns, boost::string_ref const& val) {
+      Interned fr(pool_, val);
+      Node_iri* p = iri_.insert(Node_iri());
+      p->assign(ns, fr.get());
+      fr.keep();
+      return p;
+   }
+
+   /**@brief store string literal node without making temporary copies of
+    its value and language tag
+   */
+   Node_string const* insert_string(
+            boost::string_ref const& val,
+            const Node_id dt,
+            boost::string_ref const& lang
+   ) {
+      Interned v(pool_, val);
+      Interned l(pool_, lang);
+      Node_string* p = string_.insert(Node_string(""));
+      p->assign(v.get(), dt, l.get());
+      v.keep();
+      l.keep();
+      return p;
+   }
+
+   /**@brief release storage of a node
+    @param node node previously returned by insert()
+   */
+   void remove(Node const& node) {
+      Remove op(*this);
+      Dispatch<Remove> d(*this, op);
+      node.accept(d);
+   }
+
+   void clear() {
+      iri_.clear();
+      blank_.clear();
+      bool_.clear();
+      int_.clear();
+      unsigned_.clear();
+      double_.clear();
+      string_.clear();
+      pool_.clear();
+   }
+
+private:
+   Node_store<Node_iri> iri_;
+   Node_store<Node_blank> blank_;
+   Node_store<Node_bool> bool_;
+   Node_store<Node_int> int_;
+   Node_store<Node_unsigned> unsigned_;
+   Node_store<Node_double> double_;
+   Node_store<Node_string> string_;
+   String_pool pool_;
+
+   template<class T> void release(T const&) {}
+
+   void release(Node_iri const& node) {pool_.release(node.val_);}
+
+   void release(Node_string const& node) {
+      pool_.release(node.val_);
+      pool_.release(node.lang_);
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NODE_STORE_HPP_ */
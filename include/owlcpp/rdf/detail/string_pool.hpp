@@ -0,0 +1,249 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/string_pool.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef STRING_POOL_HPP_
+#define STRING_POOL_HPP_
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/assert.hpp"
+#include "boost/functional/hash.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/rdf/detail/node_hash_index.hpp"
+#include "owlcpp/node_id.hpp"
+
+namespace owlcpp{ namespace detail{
+
+class String_pool;
+
+/**@brief Header of string record; characters follow the header
+*******************************************************************************/
+struct String_header {
+   std::size_t size_;
+   std::size_t n_; ///< number of references to pooled string
+};
+
+/**@brief Handle of a string that is either owned or interned in String_pool
+@details Owned string is kept in a single allocation together with its header
+and is copied together with the handle.
+Copies of a handle of interned string refer to the same pooled string,
+which remains valid until it is released from the pool or the pool is cleared.
+*******************************************************************************/
+class Pooled_string {
+   friend class String_pool;
+public:
+   typedef char const* const_iterator;
+
+   Pooled_string() : p_(0), owned_(false) {}
+
+   /**@brief make handle that owns a copy of @b s */
+   explicit Pooled_string(boost::string_ref const& s)
+   : p_(make(s)), owned_(p_ != 0)
+   {}
+
+   Pooled_string(Pooled_string const& ps)
+   : p_(ps.owned_ ? make(ps) : ps.p_),
+     owned_(ps.owned_)
+   {}
+
+   Pooled_string& operator=(Pooled_string const& ps) {
+      Pooled_string(ps).swap(*this);
+      return *this;
+   }
+
+   ~Pooled_string() {if( owned_ ) delete[] reinterpret_cast<char*>(p_);}
+
+   void swap(Pooled_string& ps) {
+      std::swap(p_, ps.p_);
+      std::swap(owned_, ps.owned_);
+   }
+
+   char const* data() const {return p_ ? chars(p_) : "";}
+   std::size_t size() const {return p_ ? p_->size_ : 0;}
+   bool empty() const {return ! p_;}
+   const_iterator begin() const {return data();}
+   const_iterator end() const {return data() + size();}
+   std::string str() const {return std::string(begin(), end());}
+   operator boost::string_ref() const {return boost::string_ref(data(), size());}
+
+   /**@return true if the string is interned in a pool */
+   bool pooled() const {return ! owned_ && p_;}
+
+   friend bool operator==(Pooled_string const& ps1, Pooled_string const& ps2) {
+      return
+               ps1.p_ == ps2.p_ ||
+               boost::string_ref(ps1) == boost::string_ref(ps2);
+   }
+
+   friend bool operator!=(Pooled_string const& ps1, Pooled_string const& ps2) {
+      return !(ps1 == ps2);
+   }
+
+private:
+   String_header* p_;
+   bool owned_;
+
+   explicit Pooled_string(String_header* p) : p_(p), owned_(false) {}
+
+   static char* chars(String_header* p) {return reinterpret_cast<char*>(p + 1);}
+
+   static String_header* make(boost::string_ref const& s) {
+      if( s.empty() ) return 0;
+      String_header* p = reinterpret_cast<String_header*>(
+               new char[sizeof(String_header) + s.size()]
+      );
+      p->size_ = s.size();
+      p->n_ = 0;
+      std::memcpy(chars(p), s.data(), s.size());
+      return p;
+   }
+};
+
+/**@brief Interning pool of strings
+@details String records (header and characters) are bump-allocated in large
+blocks; their addresses do not change while they are in the pool.
+Records longer than a quarter of a block get blocks of their own.
+Equal strings are stored once and counted: each intern() increments and
+each release() decrements the count.
+Records of strings that are no longer used are reused by subsequent
+insertions of strings of the same rounded size.
+Lookup uses Node_hash_index of 1-based positions in a table of records.
+Empty strings are not pooled.
+*******************************************************************************/
+class String_pool : boost::noncopyable {
+   static const std::size_t block_size = 64 * 1024;
+   typedef std::map<std::size_t, std::vector<String_header*> > free_map_t;
+
+   class Equal {
+   public:
+      Equal(String_pool const& sp, boost::string_ref const& s) : sp_(sp), s_(s) {}
+      bool operator()(const Node_id pos) const {
+         return s_ == String_pool::str(sp_.record(pos));
+      }
+   private:
+      String_pool const& sp_;
+      boost::string_ref s_;
+   };
+
+public:
+   String_pool() : top_(0), left_(0) {}
+
+   ~String_pool() {clear();}
+
+   /**@return number of distinct pooled strings */
+   std::size_t size() const {return index_.size();}
+
+   /**@return handle of pooled string equal to @b s */
+   Pooled_string intern(boost::string_ref const& s) {
+      if( s.empty() ) return Pooled_string();
+      const std::size_t h = hash(s);
+      if( Node_id const* pos = index_.find(h, Equal(*this, s)) ) {
+         String_header* p = record(*pos);
+         ++p->n_;
+         return Pooled_string(p);
+      }
+      String_header* p = allocate(record_size(s.size()));
+      p->size_ = s.size();
+      p->n_ = 1;
+      std::memcpy(Pooled_string::chars(p), s.data(), s.size());
+      Node_id pos;
+      if( free_pos_.empty() ) {
+         records_.push_back(p);
+         pos = Node_id(records_.size());
+      } else {
+         pos = free_pos_.back();
+         free_pos_.pop_back();
+         records_[pos() - 1] = p;
+      }
+      index_.insert(h, pos);
+      return Pooled_string(p);
+   }
+
+   /**@param ps string previously returned by intern() */
+   void release(Pooled_string const& ps) {
+      if( ps.empty() ) return;
+      BOOST_ASSERT( ps.pooled() );
+      String_header* p = ps.p_;
+      if( --p->n_ ) return;
+      const std::size_t h = hash(ps);
+      Node_id const* ppos = index_.find(h, Equal(*this, ps));
+      BOOST_ASSERT( ppos && record(*ppos) == p );
+      const Node_id pos = *ppos;
+      index_.erase(h, pos);
+      free_pos_.push_back(pos);
+      free_[record_size(p->size_)].push_back(p);
+   }
+
+   void clear() {
+      index_.clear();
+      free_pos_.clear();
+      records_.clear();
+      free_.clear();
+      for(std::size_t i = 0; i != blocks_.size(); ++i) delete[] blocks_[i];
+      blocks_.clear();
+      top_ = 0;
+      left_ = 0;
+   }
+
+private:
+   std::vector<char*> blocks_;
+   char* top_;
+   std::size_t left_;
+   std::vector<String_header*> records_;
+   std::vector<Node_id> free_pos_;
+   free_map_t free_;
+   Node_hash_index index_;
+
+   static std::size_t hash(boost::string_ref const& s) {
+      return boost::hash_range(s.begin(), s.end());
+   }
+
+   /** record size rounded up to keep headers aligned */
+   static std::size_t record_size(const std::size_t len) {
+      const std::size_t a = sizeof(std::size_t);
+      return (sizeof(String_header) + len + a - 1) / a * a;
+   }
+
+   String_header* record(const Node_id pos) const {return records_[pos() - 1];}
+
+   static boost::string_ref str(String_header* p) {
+      return boost::string_ref(Pooled_string::chars(p), p->size_);
+   }
+
+   String_header* allocate(const std::size_t n) {
+      const free_map_t::iterator i = free_.find(n);
+      if( i != free_.end() ) {
+         String_header* p = i->second.back();
+         i->second.pop_back();
+         if( i->second.empty() ) free_.erase(i);
+         return p;
+      }
+      if( n > block_size / 4 ) {
+         return reinterpret_cast<String_header*>(new_block(n));
+      }
+      if( n > left_ ) {
+         top_ = new_block(block_size);
+         left_ = block_size;
+      }
+      char* p = top_;
+      top_ += n;
+      left_ -= n;
+      return reinterpret_cast<String_header*>(p);
+   }
+
+   char* new_block(const std::size_t n) {
+      blocks_.push_back(0);
+      blocks_.back() = new char[n];
+      return blocks_.back();
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* STRING_POOL_HPP_ */
@@ -5,12 +5,19 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef TRIPLE_INDEX_HPP_
 #define TRIPLE_INDEX_HPP_
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "boost/bind.hpp"
+#include "boost/function.hpp"
 #include "boost/fusion/container/vector.hpp"
 #include "boost/fusion/sequence/intrinsic/at.hpp"
 #include "boost/iterator/filter_iterator.hpp"
 #include "boost/iterator/iterator_facade.hpp"
+#include "boost/iterator/iterator_traits.hpp"
 #include "boost/mpl/assert.hpp"
 #include "boost/mpl/at.hpp"
+#include "boost/mpl/bool.hpp"
 #include "boost/mpl/equal.hpp"
 #include "boost/mpl/sort.hpp"
 #include "boost/mpl/transform.hpp"
@@ -18,6 +25,7 @@ part of owlcpp project.
 #include "boost/type_traits/has_equal_to.hpp"
 #include "boost/type_traits/remove_reference.hpp"
 
+#include "owlcpp/detail/parallel_for.hpp"
 #include "owlcpp/rdf/any_triple_element.hpp"
 #include "owlcpp/rdf/detail/adapt_triple.hpp"
 #include "owlcpp/rdf/exception.hpp"
@@ -26,7 +34,20 @@ part of owlcpp project.
 
 namespace owlcpp{ namespace map_triple_detail{
 
-/**@brief
+/**@brief Type of triple references of fragment search results
+*******************************************************************************/
+template<class Id_set_iter, class Q1, class Q2, class Q3>
+struct Fragment_reference {
+   typedef typename Id_set_iter::value_type value1;
+   typedef typename boost::remove_reference<typename value1::second_type>::type
+            triple_set;
+   typedef typename triple_set::template query<Q1,Q2,Q3>::iterator iterator;
+   typedef typename boost::iterator_reference<iterator>::type type;
+};
+
+/**@brief Iterate over triples matching a query in a sequence of fragments
+@details Triples are returned by reference or, if fragments are decoded on
+the fly, by value.
 *******************************************************************************/
 template<
    class Id_set_iter,
@@ -36,13 +57,14 @@ template<
               Triple_merge_iterator<Id_set_iter, Q1, Q2, Q3>,
               Triple,
               boost::forward_traversal_tag,
-              Triple const&
+              typename Fragment_reference<Id_set_iter,Q1,Q2,Q3>::type
            > {
    typedef typename Id_set_iter::value_type value1;
    typedef typename boost::remove_reference<typename value1::second_type>::type
             triple_set;
    typedef typename triple_set::template query<Q1,Q2,Q3> query;
    typedef typename query::range t_range;
+   typedef typename Fragment_reference<Id_set_iter,Q1,Q2,Q3>::type ref_t;
 
 public:
    Triple_merge_iterator(const Id_set_iter begin, const Id_set_iter end,
@@ -72,12 +94,15 @@ private:
       ensure_end_or_match();
    }
 
+   /* fragment ranges of past-the-end iterators are not compared */
    bool equal(Triple_merge_iterator const& i) const {
-      return begin_ == i.begin_ && tr_.begin() == i.tr_.begin();
+      return
+               begin_ == i.begin_ &&
+               (begin_ == end_ || tr_.begin() == i.tr_.begin());
    }
 
-   Triple const& dereference() const {
-      return tr_.front();
+   ref_t dereference() const {
+      return *tr_.begin();
    }
 
    void ensure_end_or_match() {
@@ -87,12 +112,46 @@ private:
       }
    }
 
+   /* past-the-end iterators search an empty fragment rather than hold
+   a default-constructed range with singular iterators */
    t_range get_fragment_range() {
-      if( begin_ == end_ ) return t_range();
+      static const triple_set empty;
+      if( begin_ == end_ ) return empty.find(q1_,q2_,q3_);
       return begin_->second.find(q1_,q2_,q3_);
    }
 };
 
+/**@brief Select query element by triple element tag
+@details Query elements are passed by reference rather than collected in a
+temporary sequence, which, for empty elements such as @b Any, confuses
+-Wmaybe-uninitialized.
+*******************************************************************************/
+template<class Subj, class Pred, class Obj, class Doc> inline Subj const&
+query_element(Subj_tag, Subj const& s, Pred const&, Obj const&, Doc const&) {
+   return s;
+}
+
+template<class Subj, class Pred, class Obj, class Doc> inline Pred const&
+query_element(Pred_tag, Subj const&, Pred const& p, Obj const&, Doc const&) {
+   return p;
+}
+
+template<class Subj, class Pred, class Obj, class Doc> inline Obj const&
+query_element(Obj_tag, Subj const&, Pred const&, Obj const& o, Doc const&) {
+   return o;
+}
+
+template<class Subj, class Pred, class Obj, class Doc> inline Doc const&
+query_element(Doc_tag, Subj const&, Pred const&, Obj const&, Doc const& d) {
+   return d;
+}
+
+/**@brief Query cost indicating that all index fragments are searched
+*******************************************************************************/
+inline std::size_t query_cost_all() {
+   return std::numeric_limits<std::size_t>::max();
+}
+
 /**@brief relative diversity of elements in each triple position
 *******************************************************************************/
 struct Element_diversity : public boost::mpl::vector4_c<int,4, 2, 3, 1> {};
@@ -138,6 +197,11 @@ public:
                iterator(r.end(), r.end(), q1,q2,q3)
       );
    }
+
+   /**@return query_cost_all, since all fragments are searched */
+   static std::size_t cost(storage const&, Q0 const&) {
+      return query_cost_all();
+   }
 };
 
 /**@brief Specialize to search within single set
@@ -174,6 +238,11 @@ public:
    ) {
       return v[q0].find(q1,q2,q3);
    }
+
+   /**@return number of triples in the searched fragment */
+   static std::size_t cost(storage const& v, Q0 const& q0) {
+      return v.fragment_size(q0);
+   }
 };
 
 /**@brief Store RDF triples in a searchable fashion
@@ -190,7 +259,10 @@ template<
    class Tag2,
    class Tag3
 > class Triple_index {
+public:
    typedef boost::mpl::vector4<Tag0,Tag1,Tag2,Tag3> sort_order;
+
+private:
    BOOST_MPL_ASSERT((
             boost::mpl::equal<
                typename boost::mpl::sort<sort_order>::type,
@@ -228,15 +300,22 @@ public:
          BOOST_MPL_ASSERT((boost::has_equal_to<el1,qt1,bool>));
          BOOST_MPL_ASSERT((boost::has_equal_to<el2,qt2,bool>));
          BOOST_MPL_ASSERT((boost::has_equal_to<el3,qt3,bool>));
-         const bfvect_t q(subj, pred, obj, doc);
          return dispatch::find(
                   v,
-                  boost::fusion::at<Tag0>(q),
-                  boost::fusion::at<Tag1>(q),
-                  boost::fusion::at<Tag2>(q),
-                  boost::fusion::at<Tag3>(q)
+                  query_element(Tag0(), subj, pred, obj, doc),
+                  query_element(Tag1(), subj, pred, obj, doc),
+                  query_element(Tag2(), subj, pred, obj, doc),
+                  query_element(Tag3(), subj, pred, obj, doc)
          );
       }
+
+      static std::size_t cost(
+               storage const& v,
+               Subj const& subj, Pred const& pred,
+               Obj const& obj, Doc const& doc
+      ) {
+         return dispatch::cost(v, query_element(Tag0(), subj, pred, obj, doc));
+      }
    };
 
    typedef typename query<Any,Any,Any,Any>::iterator iterator;
@@ -258,8 +337,34 @@ public:
       return query<Subj,Pred,Obj,Doc>::find(v_, subj, pred, obj, doc);
    }
 
+   /**@return number of triples, which are searched for the query,
+    or query_cost_all() if all fragments are searched
+    @details Unlike query::efficiency, the cost depends on stored triples.
+   */
+   template<class Subj, class Pred, class Obj, class Doc> std::size_t
+   cost(Subj const& subj, Pred const& pred, Obj const& obj, Doc const& doc) const {
+      return query<Subj,Pred,Obj,Doc>::cost(v_, subj, pred, obj, doc);
+   }
+
    bool insert(Triple const& t) {return v_.insert(t);}
 
+   std::size_t insert_batch(std::vector<Triple>& v, const unsigned n_threads = 1) {
+      return v_.insert_batch(v, n_threads);
+   }
+
+   /**@brief Insert a batch of triples sorted by Index_order<sort_order>
+    @details The batch is not modified, so that several indices with the
+    same order may share it.
+   */
+   std::size_t insert_sorted_batch(
+            std::vector<Triple> const& v,
+            const unsigned n_threads = 1
+   ) {
+      return v_.insert_sorted_batch(v, n_threads);
+   }
+
+   std::size_t erase_batch(std::vector<Triple>& v) {return v_.erase_batch(v);}
+
    void erase(Triple const& t) {
       try{v_.erase(t);} catch(Rdf_err const&) {
          BOOST_THROW_EXCEPTION(
@@ -272,6 +377,11 @@ public:
 
    void clear() {v_.clear();}
 
+   /**@brief Compact index storage for read-mostly use
+    @details Index is thawed automatically when modified.
+   */
+   void freeze() {v_.freeze();}
+
 private:
    storage v_;
 };
@@ -291,6 +401,106 @@ private:
    bool& inserted_;
 };
 
+/**@brief Insert a batch of triples into index
+*******************************************************************************/
+class Insert_batch {
+public:
+   Insert_batch(std::vector<Triple>& v, std::size_t& inserted)
+   : v_(v), inserted_(inserted) {}
+
+   template<class Index> void operator()(Index& i) const {
+      inserted_ = i.insert_batch(v_);
+   }
+
+private:
+   std::vector<Triple>& v_;
+   std::size_t& inserted_;
+};
+
+/**@brief Insert same batch of triples into several indices concurrently
+@details Indices are registered by boost::fusion::for_each through add();
+each index is then filled in a separate task.
+The batch should be sorted by Triple::operator<(), i.e., in SPOD order;
+indices with this order insert it directly, other indices sort their own
+copy.
+Remaining threads are shared between the indices for sorting the batch and
+merging it into index fragments.
+*******************************************************************************/
+class Insert_batch_parallel {
+   typedef boost::function<std::size_t(unsigned)> task_t;
+
+   typedef boost::mpl::vector4<Subj_tag,Pred_tag,Obj_tag,Doc_tag> batch_order;
+
+   template<class Index> static std::size_t insert(
+            Index& i,
+            std::vector<Triple> const& v,
+            const unsigned n_threads
+   ) {
+      std::vector<Triple> v1(v);
+      return i.insert_batch(v1, n_threads);
+   }
+
+   template<class Index> static std::size_t insert_sorted(
+            Index& i,
+            std::vector<Triple> const& v,
+            const unsigned n_threads
+   ) {
+      return i.insert_sorted_batch(v, n_threads);
+   }
+
+   template<class Index> static task_t task(
+            Index& i,
+            std::vector<Triple> const& v,
+            boost::mpl::false_
+   ) {
+      return boost::bind(&insert<Index>, boost::ref(i), boost::cref(v), _1);
+   }
+
+   template<class Index> static task_t task(
+            Index& i,
+            std::vector<Triple> const& v,
+            boost::mpl::true_
+   ) {
+      return boost::bind(&insert_sorted<Index>, boost::ref(i), boost::cref(v), _1);
+   }
+
+public:
+   /**@brief register indices; function object for boost::fusion::for_each */
+   struct Add {
+      explicit Add(Insert_batch_parallel& ibp) : ibp_(ibp) {}
+      template<class Index> void operator()(Index& i) const {ibp_.add(i);}
+      Insert_batch_parallel& ibp_;
+   };
+
+   explicit Insert_batch_parallel(std::vector<Triple> const& v)
+   : v_(v), nt_index_(1) {}
+
+   template<class Index> void add(Index& i) {
+      typedef typename boost::mpl::equal<
+               typename Index::sort_order, batch_order
+               >::type same_order;
+      tasks_.push_back(task(i, v_, same_order()));
+   }
+
+   /**@return number of triples inserted into each index */
+   std::vector<std::size_t> const& run(const unsigned n_threads) {
+      const unsigned nt = detail::n_threads_default(n_threads);
+      nt_index_ = std::max(1U, nt / static_cast<unsigned>(tasks_.size()));
+      n_.assign(tasks_.size(), 0);
+      detail::parallel_for(tasks_.size(), *this, nt);
+      return n_;
+   }
+
+   /**@brief run task @b i; called by parallel_for */
+   void operator()(const std::size_t i) {n_[i] = tasks_[i](nt_index_);}
+
+private:
+   std::vector<Triple> const& v_;
+   std::vector<task_t> tasks_;
+   std::vector<std::size_t> n_;
+   unsigned nt_index_;
+};
+
 /**@brief Erase triple from index
 *******************************************************************************/
 class Erase {
@@ -301,12 +511,28 @@ private:
    Triple const& t_;
 };
 
+/**@brief Erase a batch of triples from index
+*******************************************************************************/
+class Erase_batch {
+public:
+   explicit Erase_batch(std::vector<Triple>& v) : v_(v) {}
+   template<class Index> void operator()(Index& i) const {i.erase_batch(v_);}
+private:
+   std::vector<Triple>& v_;
+};
+
 /**@brief Clear index
 *******************************************************************************/
 struct Clear {
    template<class Index> void operator()(Index& i) const {i.clear();}
 };
 
+/**@brief Compact index storage
+*******************************************************************************/
+struct Freeze {
+   template<class Index> void operator()(Index& i) const {i.freeze();}
+};
+
 }//namespace map_triple_detail
 }//namespace owlcpp
 #endif /* TRIPLE_INDEX_HPP_ */
@@ -0,0 +1,371 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/triple_index_dynamic.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef TRIPLE_INDEX_DYNAMIC_HPP_
+#define TRIPLE_INDEX_DYNAMIC_HPP_
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "boost/iterator/iterator_facade.hpp"
+#include "boost/range.hpp"
+
+#include "owlcpp/rdf/any_triple_element.hpp"
+#include "owlcpp/rdf/exception.hpp"
+#include "owlcpp/rdf/print_triple.hpp"
+#include "owlcpp/rdf/triple.hpp"
+#include "owlcpp/rdf/triple_permutation.hpp"
+
+namespace owlcpp{ namespace map_triple_detail{
+
+/**@brief Triple search pattern with elements specified at run time
+@details Elements are numbered as in triple_element().
+*******************************************************************************/
+class Triple_pattern {
+public:
+   Triple_pattern() {
+      for( unsigned n = 0; n != 4; ++n ) {
+         val_[n] = 0;
+         bound_[n] = false;
+      }
+   }
+
+   template<class Subj, class Pred, class Obj, class Doc>
+   Triple_pattern(const Subj subj, const Pred pred, const Obj obj, const Doc doc) {
+      set(0, subj);
+      set(1, pred);
+      set(2, obj);
+      set(3, doc);
+   }
+
+   bool bound(const unsigned n) const {return bound_[n];}
+   unsigned value(const unsigned n) const {return val_[n];}
+
+   bool matches(Triple const& t) const {
+      return
+               (! bound_[0] || t.subj_() == val_[0]) &&
+               (! bound_[1] || t.pred_() == val_[1]) &&
+               (! bound_[2] || t.obj_() == val_[2]) &&
+               (! bound_[3] || t.doc_() == val_[3]);
+   }
+
+   /**@return triple with the specified elements; others are 0 */
+   Triple triple() const {
+      return Triple::make(
+               Node_id(val_[0]), Node_id(val_[1]), Node_id(val_[2]), Doc_id(val_[3])
+      );
+   }
+
+private:
+   unsigned val_[4];
+   bool bound_[4];
+
+   void set(const unsigned n, Any const&) {
+      val_[n] = 0;
+      bound_[n] = false;
+   }
+
+   void set(const unsigned n, Node_id const& id) {
+      val_[n] = id();
+      bound_[n] = true;
+   }
+
+   void set(const unsigned n, Doc_id const& id) {
+      val_[n] = id();
+      bound_[n] = true;
+   }
+};
+
+/**@brief Compare triples by elements at permutation positions
+[@b first, @b last)
+*******************************************************************************/
+class Permutation_order : public std::binary_function<Triple, Triple, bool> {
+public:
+   Permutation_order(
+            Triple_permutation const& p,
+            const unsigned first = 0,
+            const unsigned last = 4
+   )
+   : p_(p), first_(first), last_(last)
+   {}
+
+   bool operator()(Triple const& t1, Triple const& t2) const {
+      for( unsigned n = first_; n != last_; ++n ) {
+         const unsigned e1 = p_.element(t1, n);
+         const unsigned e2 = p_.element(t2, n);
+         if( e1 < e2 ) return true;
+         if( e2 < e1 ) return false;
+      }
+      return false;
+   }
+
+private:
+   Triple_permutation p_;
+   unsigned first_;
+   unsigned last_;
+};
+
+class Triple_index_dynamic;
+
+/**@brief Iterate over triples of Triple_index_dynamic that match a pattern
+@details If leading element of the index permutation is specified,
+only one fragment is searched; otherwise all fragments are scanned.
+Within a fragment, the range of triples matching the specified elements
+that immediately follow the leading one is found by binary search;
+remaining specified elements are matched sequentially.
+*******************************************************************************/
+class Dynamic_triple_iterator
+         : public boost::iterator_facade<
+              Dynamic_triple_iterator,
+              Triple,
+              boost::forward_traversal_tag,
+              Triple const&
+           > {
+public:
+   /** end iterator */
+   Dynamic_triple_iterator()
+   : ti_(0), q_(), prefix_(0), key_(0), key_end_(0), i_(0), end_(0)
+   {}
+
+   inline Dynamic_triple_iterator(
+            Triple_index_dynamic const& ti,
+            Triple_pattern const& q
+   );
+
+private:
+   Triple_index_dynamic const* ti_;
+   Triple_pattern q_;
+   unsigned prefix_; ///< number of permutation positions searched by key
+   std::size_t key_;
+   std::size_t key_end_;
+   Triple const* i_;
+   Triple const* end_;
+
+   friend class boost::iterator_core_access;
+
+   void increment() {
+      ++i_;
+      ensure_end_or_match();
+   }
+
+   bool equal(Dynamic_triple_iterator const& i) const {return i_ == i.i_;}
+
+   Triple const& dereference() const {return *i_;}
+
+   inline void fragment();
+
+   void ensure_end_or_match() {
+      for( ; ; ) {
+         for( ; i_ != end_; ++i_ ) if( q_.matches(*i_) ) return;
+         if( ++key_ >= key_end_ ) {
+            i_ = end_ = 0;
+            return;
+         }
+         fragment();
+      }
+   }
+};
+
+/**@brief Triple index with element order selected at run time
+@details Triples are stored in fragments mapped against the value of the
+leading element of the permutation; each fragment is sorted by the
+remaining elements in permutation order.
+*******************************************************************************/
+class Triple_index_dynamic {
+   typedef std::vector<Triple> fragment_type;
+   typedef fragment_type::iterator iter_t;
+
+public:
+   typedef Dynamic_triple_iterator iterator;
+   typedef iterator const_iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   explicit Triple_index_dynamic(Triple_permutation const& p)
+   : p_(p), f_(), n_(0)
+   {}
+
+   Triple_permutation const& permutation() const {return p_;}
+   std::size_t size() const {return n_;}
+   bool empty() const {return ! n_;}
+
+   /**@return number of leading element values, including empty fragments */
+   std::size_t n_keys() const {return f_.size();}
+
+   /**@return pointers to the first and past-the-last triples of fragment
+    @b key */
+   std::pair<Triple const*, Triple const*> fragment(const std::size_t key) const {
+      if( key >= f_.size() || f_[key].empty() ) {
+         return std::pair<Triple const*, Triple const*>(0, 0);
+      }
+      fragment_type const& f = f_[key];
+      return std::make_pair(&f[0], &f[0] + f.size());
+   }
+
+   /**@return number of leading permutation elements specified in @b q */
+   unsigned prefix(Triple_pattern const& q) const {
+      unsigned n = 0;
+      while( n != 4 && q.bound(p_[n]) ) ++n;
+      return n;
+   }
+
+   range find(Triple_pattern const& q) const {
+      return range(iterator(*this, q), iterator());
+   }
+
+   /**@return number of triples, which are searched for pattern @b q after
+    the leading elements specified in @b q are found by key and binary search
+    @details Takes logarithmic time.
+   */
+   std::size_t cost(Triple_pattern const& q) const {
+      const unsigned n = prefix(q);
+      if( ! n ) return n_;
+      const std::pair<Triple const*, Triple const*> p =
+               fragment(q.value(p_[0]));
+      if( n < 2 || p.first == p.second ) return p.second - p.first;
+      const std::pair<Triple const*, Triple const*> r = std::equal_range(
+               p.first, p.second, q.triple(), Permutation_order(p_, 1, n)
+      );
+      return r.second - r.first;
+   }
+
+   bool contains(Triple const& t) const {
+      const unsigned k = p_.element(t, 0);
+      if( k >= f_.size() ) return false;
+      return std::binary_search(f_[k].begin(), f_[k].end(), t, order());
+   }
+
+   bool insert(Triple const& t) {
+      const unsigned k = p_.element(t, 0);
+      if( k >= f_.size() ) f_.resize(k + 1);
+      fragment_type& f = f_[k];
+      const iter_t i = std::lower_bound(f.begin(), f.end(), t, order());
+      if( i != f.end() && *i == t ) return false;
+      f.insert(i, t);
+      ++n_;
+      return true;
+   }
+
+   /**@brief Insert a batch of triples
+    @param v triples, which are re-ordered in place
+    @return number of triples actually inserted
+   */
+   std::size_t insert_batch(std::vector<Triple>& v) {
+      if( v.empty() ) return 0;
+      std::sort(v.begin(), v.end(), Permutation_order(p_));
+      const unsigned k_max = p_.element(v.back(), 0);
+      if( k_max >= f_.size() ) f_.resize(k_max + 1);
+      std::size_t n = 0;
+      const Permutation_order ord = order();
+      typedef std::vector<Triple>::const_iterator citer_t;
+      for( citer_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const unsigned k = p_.element(*i1, 0);
+         for( i2 = i1 + 1; i2 != v.end() && p_.element(*i2, 0) == k; ++i2 );
+         fragment_type& f = f_[k];
+         const std::size_t n0 = f.size();
+         f.insert(f.end(), i1, i2);
+         std::inplace_merge(f.begin(), f.begin() + n0, f.end(), ord);
+         f.erase(std::unique(f.begin(), f.end()), f.end());
+         n += f.size() - n0;
+      }
+      n_ += n;
+      return n;
+   }
+
+   /**@brief Erase a batch of triples
+    @param v triples, which are re-ordered in place
+    @return number of triples actually erased
+   */
+   std::size_t erase_batch(std::vector<Triple>& v) {
+      std::sort(v.begin(), v.end(), Permutation_order(p_));
+      std::size_t n = 0;
+      const Permutation_order ord = order();
+      typedef std::vector<Triple>::const_iterator citer_t;
+      for( citer_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const unsigned k = p_.element(*i1, 0);
+         for( i2 = i1 + 1; i2 != v.end() && p_.element(*i2, 0) == k; ++i2 );
+         if( k >= f_.size() ) continue;
+         fragment_type& f = f_[k];
+         const std::size_t n0 = f.size();
+         iter_t out = f.begin();
+         citer_t j = i1;
+         for( iter_t i = f.begin(); i != f.end(); ++i ) {
+            while( j != i2 && ord(*j, *i) ) ++j;
+            if( j != i2 && *j == *i ) continue;
+            *out++ = *i;
+         }
+         f.erase(out, f.end());
+         n += n0 - f.size();
+      }
+      n_ -= n;
+      return n;
+   }
+
+   void erase(Triple const& t) {
+      const unsigned k = p_.element(t, 0);
+      if( k < f_.size() ) {
+         fragment_type& f = f_[k];
+         const iter_t i = std::lower_bound(f.begin(), f.end(), t, order());
+         if( i != f.end() && *i == t ) {
+            f.erase(i);
+            --n_;
+            return;
+         }
+      }
+      BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("triple not found")
+               << Rdf_err::str1_t(to_string(t))
+      );
+   }
+
+   void clear() {
+      f_.clear();
+      n_ = 0;
+   }
+
+private:
+   Triple_permutation p_;
+   std::vector<fragment_type> f_;
+   std::size_t n_;
+
+   /** order of triples within fragment */
+   Permutation_order order() const {return Permutation_order(p_, 1);}
+};
+
+/*
+*******************************************************************************/
+inline Dynamic_triple_iterator::Dynamic_triple_iterator(
+         Triple_index_dynamic const& ti,
+         Triple_pattern const& q
+)
+: ti_(&ti), q_(q), prefix_(ti.prefix(q)), key_(0), key_end_(ti.n_keys()),
+  i_(0), end_(0)
+{
+   if( prefix_ ) {
+      key_ = q.value(ti.permutation()[0]);
+      key_end_ = key_ + 1;
+   }
+   if( key_ >= key_end_ ) return;
+   fragment();
+   ensure_end_or_match();
+}
+
+/*
+*******************************************************************************/
+inline void Dynamic_triple_iterator::fragment() {
+   const std::pair<Triple const*, Triple const*> p = ti_->fragment(key_);
+   i_ = p.first;
+   end_ = p.second;
+   if( prefix_ < 2 || i_ == end_ ) return;
+   const std::pair<Triple const*, Triple const*> r = std::equal_range(
+            i_, end_, q_.triple(),
+            Permutation_order(ti_->permutation(), 1, prefix_)
+   );
+   i_ = r.first;
+   end_ = r.second;
+}
+
+}//namespace map_triple_detail
+}//namespace owlcpp
+#endif /* TRIPLE_INDEX_DYNAMIC_HPP_ */
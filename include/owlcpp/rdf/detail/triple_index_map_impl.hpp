@@ -5,13 +5,17 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef TRIPLE_INDEX_MAP_IMPL_HPP_
 #define TRIPLE_INDEX_MAP_IMPL_HPP_
+#include <algorithm>
 #include <map>
+#include <vector>
 #include "boost/foreach.hpp"
 #include "boost/fusion/sequence/intrinsic/at.hpp"
 #include "boost/iterator/filter_iterator.hpp"
 #include "boost/range.hpp"
 
+#include "owlcpp/detail/parallel_sort.hpp"
 #include "owlcpp/rdf/any_triple_element.hpp"
+#include "owlcpp/rdf/detail/fragment_inserter.hpp"
 #include "owlcpp/rdf/detail/triple_set.hpp"
 #include "owlcpp/rdf/exception.hpp"
 
@@ -99,9 +103,65 @@ public:
       return s_[id].insert(t);
    }
 
+   /**@brief Insert a batch of triples
+    @param v triples, which are re-ordered in place
+    @param n_threads maximal number of threads for sorting the batch and
+    merging it into fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+    @details New fragments are created in the calling thread.
+   */
+   std::size_t insert_batch(std::vector<Triple>& v, const unsigned n_threads = 1) {
+      detail::parallel_sort(
+               v.begin(), v.end(), Index_order<Tag0,Tag1,Tag2,Tag3>(), n_threads
+      );
+      return insert_sorted_batch(v, n_threads);
+   }
+
+   /**@brief Insert a batch of triples sorted in index order
+    @param v triples sorted by Index_order<Tag0,Tag1,Tag2,Tag3>
+    @param n_threads maximal number of threads for merging the batch into
+    fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+   */
+   std::size_t insert_sorted_batch(
+            std::vector<Triple> const& v,
+            const unsigned n_threads = 1
+   ) {
+      Fragment_inserter<set_type> fi;
+      typename storage::iterator hint = s_.begin();
+      typedef std::vector<Triple>::const_iterator iter_t;
+      for( iter_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const id_type id = boost::fusion::at<Tag0>(*i1);
+         for( i2 = i1 + 1; i2 != v.end() && boost::fusion::at<Tag0>(*i2) == id; ++i2 );
+         hint = s_.insert(hint, typename storage::value_type(id, set_type()));
+         fi.add(hint->second, i1, i2);
+      }
+      return fi.run(n_threads);
+   }
+
+   /**@brief Erase a batch of triples
+    @param v triples, which are re-ordered in place
+    @return number of triples actually erased
+    @details Fragments that become empty are removed.
+   */
+   std::size_t erase_batch(std::vector<Triple>& v) {
+      std::sort(v.begin(), v.end(), Index_order<Tag0,Tag1,Tag2,Tag3>());
+      std::size_t n = 0;
+      typedef std::vector<Triple>::const_iterator iter_t;
+      for( iter_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const id_type id = boost::fusion::at<Tag0>(*i1);
+         for( i2 = i1 + 1; i2 != v.end() && boost::fusion::at<Tag0>(*i2) == id; ++i2 );
+         const typename storage::iterator i = s_.find(id);
+         if( i == s_.end() ) continue;
+         n += i->second.erase_sorted(i1, i2);
+         if( i->second.empty() ) s_.erase(i);
+      }
+      return n;
+   }
+
    void erase(Triple const& t) {
       const id_type id = boost::fusion::at<Tag0>(t);
-      const_iterator i = s_.find(id);
+      const typename storage::iterator i = s_.find(id);
       if( i == s_.end() ) BOOST_THROW_EXCEPTION(
                Rdf_err()
                << Rdf_err::msg_t("element not found")
@@ -112,6 +172,20 @@ public:
 
    void clear() {s_.clear();}
 
+   /**@brief Release unused capacity of fragments
+    @details Fragments remain modifiable.
+   */
+   void freeze() {
+      for( typename storage::iterator i = s_.begin(); i != s_.end(); ++i ) {
+         i->second.shrink();
+      }
+   }
+
+   /**@return number of triples with leading element @b id */
+   std::size_t fragment_size(const id_type id) const {
+      return (*this)[id].size();
+   }
+
    set_type const& operator[](const id_type id) const {
       const_iterator i = s_.find(id);
       if( i == s_.end() ) return set_type::empty_set();
@@ -0,0 +1,512 @@
+/** @file "/owlcpp/include/owlcpp/rdf/detail/triple_index_packed_impl.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef TRIPLE_INDEX_PACKED_IMPL_HPP_
+#define TRIPLE_INDEX_PACKED_IMPL_HPP_
+#include <functional>
+#include <utility>
+#include <vector>
+#include "boost/assert.hpp"
+#include "boost/dynamic_bitset.hpp"
+#include "boost/fusion/sequence/intrinsic/at.hpp"
+#include "boost/iterator/filter_iterator.hpp"
+#include "boost/iterator/iterator_facade.hpp"
+#include "boost/mpl/at.hpp"
+#include "boost/range.hpp"
+
+#include "owlcpp/rdf/any_triple_element.hpp"
+#include "owlcpp/rdf/detail/triple_index_vector_impl.hpp"
+#include "owlcpp/rdf/detail/triple_set.hpp"
+#include "owlcpp/rdf/triple.hpp"
+
+namespace owlcpp{ namespace map_triple_detail{
+
+/**@brief Append unsigned integer in variable-length (LEB128) encoding
+@details Seven bits are stored per byte, least significant first;
+high bit is set in all bytes but the last one.
+*******************************************************************************/
+inline void pack_varint(std::vector<unsigned char>& v, unsigned n) {
+   while( n >= 0x80 ) {
+      v.push_back(static_cast<unsigned char>(n | 0x80));
+      n >>= 7;
+   }
+   v.push_back(static_cast<unsigned char>(n));
+}
+
+/**@brief Decode unsigned integer written by pack_varint() and advance @b p
+*******************************************************************************/
+inline unsigned unpack_varint(unsigned char const*& p) {
+   if( *p < 0x80 ) return *p++;
+   unsigned n = *p & 0x7f;
+   for( unsigned shift = 7; *p++ & 0x80; shift += 7 ) {
+      n |= static_cast<unsigned>(*p & 0x7f) << shift;
+   }
+   return n;
+}
+
+/**@brief Append triples of one index fragment in delta encoding
+@param v output bytes
+@param first,last triples sorted by Value_predicate<Tag1,Tag2,Tag3>
+@details Leading element is not stored.
+For each triple, difference of @b Tag1 element from the previous triple is
+written first; if it is 0, difference of @b Tag2 element follows, otherwise
+@b Tag2 element itself.
+@b Tag3 element is written in the same way.
+*******************************************************************************/
+template<class Tag1, class Tag2, class Tag3, class Iter>
+void pack_fragment(
+         std::vector<unsigned char>& v,
+         Iter first,
+         const Iter last
+) {
+   using boost::fusion::at;
+   unsigned e1 = 0, e2 = 0, e3 = 0;
+   for( ; first != last; ++first ) {
+      const unsigned n1 = at<Tag1>(*first)();
+      const unsigned n2 = at<Tag2>(*first)();
+      const unsigned n3 = at<Tag3>(*first)();
+      BOOST_ASSERT(e1 <= n1);
+      pack_varint(v, n1 - e1);
+      if( n1 != e1 ) {
+         pack_varint(v, n2);
+         pack_varint(v, n3);
+      } else {
+         BOOST_ASSERT(e2 <= n2);
+         pack_varint(v, n2 - e2);
+         pack_varint(v, n2 != e2 ? n3 : n3 - e3);
+      }
+      e1 = n1;
+      e2 = n2;
+      e3 = n3;
+   }
+}
+
+/**@brief Iterate over triples of an index fragment, which are either stored
+as an array or packed by pack_fragment()
+@details Packed triples are decoded on the fly;
+dereferencing returns triples by value.
+*******************************************************************************/
+template<class Tag1, class Tag2, class Tag3> class Packed_triple_iterator
+         : public boost::iterator_facade<
+              Packed_triple_iterator<Tag1,Tag2,Tag3>,
+              Triple,
+              boost::forward_traversal_tag,
+              Triple
+           > {
+   typedef typename boost::mpl::at<Triple, Tag1>::type el1;
+   typedef typename boost::mpl::at<Triple, Tag2>::type el2;
+   typedef typename boost::mpl::at<Triple, Tag3>::type el3;
+
+public:
+   Packed_triple_iterator()
+   : t_(), i_(0), p_(0), next_(0), end_(0)
+   {}
+
+   /** iterate over array of triples */
+   explicit Packed_triple_iterator(Triple const* i)
+   : t_(), i_(i), p_(0), next_(0), end_(0)
+   {}
+
+   /**
+    @param t0 triple with the leading element of the fragment
+    @param p first byte of the packed triple
+    @param end past-the-end byte of the fragment
+   */
+   Packed_triple_iterator(
+            Triple const& t0,
+            unsigned char const* p,
+            unsigned char const* end
+   )
+   : t_(t0), i_(0), p_(p), next_(p), end_(end)
+   {
+      decode();
+   }
+
+private:
+   Triple t_; ///< last decoded triple
+   Triple const* i_;
+   unsigned char const* p_; ///< start of current packed triple
+   unsigned char const* next_; ///< start of next packed triple
+   unsigned char const* end_;
+
+   friend class boost::iterator_core_access;
+
+   void increment() {
+      if( i_ ) {
+         ++i_;
+         return;
+      }
+      p_ = next_;
+      decode();
+   }
+
+   bool equal(Packed_triple_iterator const& i) const {
+      return i_ == i.i_ && p_ == i.p_;
+   }
+
+   Triple dereference() const {return i_ ? *i_ : t_;}
+
+   void decode() {
+      if( next_ == end_ ) return;
+      using boost::fusion::at;
+      const unsigned d1 = unpack_varint(next_);
+      if( d1 ) {
+         at<Tag1>(t_) = el1(at<Tag1>(t_)() + d1);
+         at<Tag2>(t_) = el2(unpack_varint(next_));
+         at<Tag3>(t_) = el3(unpack_varint(next_));
+         return;
+      }
+      const unsigned d2 = unpack_varint(next_);
+      if( d2 ) {
+         at<Tag2>(t_) = el2(at<Tag2>(t_)() + d2);
+         at<Tag3>(t_) = el3(unpack_varint(next_));
+         return;
+      }
+      at<Tag3>(t_) = el3(at<Tag3>(t_)() + unpack_varint(next_));
+   }
+};
+
+/**@brief Search packed fragment
+@details All searches are sequential.
+*******************************************************************************/
+template<
+   class Tag1, class Tag2, class Tag3,
+   class Q1, class Q2, class Q3
+> class Packed_query_dispatch {
+   typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Q2,Q3> predicate;
+   typedef Packed_triple_iterator<Tag1,Tag2,Tag3> iter;
+public:
+   typedef boost::filter_iterator<predicate, iter> iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   static range find(
+            iter const& begin, iter const& end,
+            const Q1 q1, const Q2 q2, const Q3 q3
+   ) {
+      const predicate p(q1, q2, q3);
+      return range(iterator(p, begin, end), iterator(p, end, end));
+   }
+
+   static const int efficiency = 0;
+};
+
+template<class Tag1, class Tag2, class Tag3>
+class Packed_query_dispatch<Tag1,Tag2,Tag3,Any,Any,Any> {
+public:
+   typedef Packed_triple_iterator<Tag1,Tag2,Tag3> iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   static range find(
+            iterator const& begin, iterator const& end,
+            const Any, const Any, const Any
+   ) {
+      return range(begin, end);
+   }
+
+   static const int efficiency = 0;
+};
+
+/**@brief Read-only view of an index fragment, which is either stored as an
+array of triples or packed
+*******************************************************************************/
+template<class Tag0, class Tag1, class Tag2, class Tag3> class Packed_fragment {
+   typedef typename boost::mpl::at<Triple, Tag0>::type el0;
+public:
+   typedef Triple value_type;
+   typedef Packed_triple_iterator<Tag1,Tag2,Tag3> iterator;
+   typedef iterator const_iterator;
+
+   Packed_fragment() : t0_(), first_(0), last_(0), p_(0), end_(0) {}
+
+   Packed_fragment(Triple const* first, Triple const* last)
+   : t0_(), first_(first), last_(last), p_(0), end_(0)
+   {}
+
+   Packed_fragment(
+            const el0 id,
+            unsigned char const* p,
+            unsigned char const* end
+   )
+   : t0_(), first_(0), last_(0), p_(p), end_(end)
+   {
+      boost::fusion::at<Tag0>(t0_) = id;
+   }
+
+   const_iterator begin() const {
+      return p_ ? const_iterator(t0_, p_, end_) : const_iterator(first_);
+   }
+
+   const_iterator end() const {
+      return p_ ? const_iterator(t0_, end_, end_) : const_iterator(last_);
+   }
+
+   bool empty() const {return p_ ? p_ == end_ : first_ == last_;}
+
+   template<class Q1, class Q2, class Q3> struct query {
+      typedef Packed_query_dispatch<Tag1,Tag2,Tag3,Q1,Q2,Q3> dispatch;
+      typedef typename dispatch::iterator iterator;
+      typedef typename dispatch::range range;
+      static const int efficiency = dispatch::efficiency;
+   };
+
+   template<class Q1, class Q2, class Q3>
+   typename query<Q1,Q2,Q3>::range
+   find(const Q1 q1, const Q2 q2, const Q3 q3) const {
+      return query<Q1,Q2,Q3>::dispatch::find(begin(), end(), q1, q2, q3);
+   }
+
+private:
+   Triple t0_;
+   Triple const* first_;
+   Triple const* last_;
+   unsigned char const* p_;
+   unsigned char const* end_;
+};
+
+template<class Tag0,class Tag1, class Tag2, class Tag3>
+class Triple_index_packed_impl;
+
+/**@brief Packed fragment map configuration
+*******************************************************************************/
+template<class Tag0,class Tag1, class Tag2, class Tag3> struct Tip_config {
+   typedef typename boost::mpl::at<Triple, Tag0>::type id_type;
+   typedef Packed_fragment<Tag0,Tag1,Tag2,Tag3> set_type;
+   typedef std::pair<id_type, set_type> value_type;
+   typedef Triple_index_packed_impl<Tag0,Tag1,Tag2,Tag3> impl;
+   typedef Tiv_iterator<id_type, set_type, impl> iterator;
+};
+
+/**@brief
+*******************************************************************************/
+template<class Tag0,class Tag1, class Tag2, class Tag3, class Q0>
+class Tip_query_dispatch {
+   typedef Tip_config<Tag0,Tag1,Tag2,Tag3> config;
+   typedef typename config::impl impl;
+   typedef typename config::value_type value_type;
+
+   class Equal : public std::unary_function<value_type, bool> {
+   public:
+      explicit Equal(const Q0 q) : q_(q) {}
+      bool operator()(value_type const& p) const {return p.first == q_;}
+   private:
+      Q0 q_;
+   };
+
+public:
+   typedef boost::filter_iterator<Equal, typename config::iterator> iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   static range find(impl const& s, const Q0 q0) {
+      const Equal eq(q0);
+      return range(
+               iterator(eq, s.begin(), s.end()),
+               iterator(eq, s.end(), s.end())
+      );
+   }
+};
+
+template<class Tag0,class Tag1, class Tag2, class Tag3>
+class Tip_query_dispatch<Tag0,Tag1,Tag2,Tag3,Any> {
+   typedef Tip_config<Tag0,Tag1,Tag2,Tag3> config;
+   typedef typename config::impl impl;
+public:
+   typedef typename config::iterator iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   static range find(impl const& s, Any const&) {
+      return range(s.begin(), s.end());
+   }
+};
+
+/**@brief Container of triple fragments mapped against @b ID -s, which are
+delta-encoded when the index is frozen
+@details Until freeze() is called, triples are stored in
+Triple_index_vector_impl.
+Frozen index keeps all fragments in one array of bytes encoded by
+pack_fragment() and one array of fragment offsets, indexed by the leading
+element ID.
+Triples are decoded on the fly by the iterators of search results, so
+searching packed fragments is always sequential.
+Frozen index is automatically thawed by the first modification.
+*******************************************************************************/
+template<class Tag0,class Tag1, class Tag2, class Tag3>
+class Triple_index_packed_impl {
+   typedef Tip_config<Tag0,Tag1,Tag2,Tag3> config;
+   typedef Triple_index_vector_impl<Tag0,Tag1,Tag2,Tag3> unpacked_type;
+
+public:
+   typedef typename config::set_type set_type;
+   typedef typename config::id_type id_type;
+   typedef typename config::value_type value_type;
+   typedef typename config::iterator iterator;
+   typedef iterator const_iterator;
+   typedef boost::iterator_range<iterator> range;
+
+   Triple_index_packed_impl() : v_(), off_(), b_(), k_(), n_(0) {}
+
+   const_iterator begin() const {return const_iterator(*this, next_key(0));}
+   const_iterator end() const {return const_iterator(*this, n_keys());}
+
+   std::size_t n_fragments() const {return frozen() ? n_ : v_.n_fragments();}
+
+   /**@return true if triples are packed */
+   bool frozen() const {return ! off_.empty();}
+
+   /**@return number of leading element IDs, including those without triples */
+   std::size_t n_keys() const {return frozen() ? off_.size() - 1 : v_.n_keys();}
+
+   /**@return smallest ID with triples, which is not less than @b i,
+    or n_keys() */
+   std::size_t next_key(const std::size_t i) const {
+      return frozen() ? next_set_bit(k_, i) : v_.next_key(i);
+   }
+
+   /**@return number of bytes of packed triples */
+   std::size_t n_bytes() const {return b_.size();}
+
+   /**@return number of triples with leading element @b id;
+    for packed fragments, the number is estimated from their length */
+   std::size_t fragment_size(const id_type id) const {
+      if( ! frozen() ) return v_.fragment_size(id);
+      if( id() >= n_keys() ) return 0;
+      const std::size_t n = off_[id() + 1] - off_[id()];
+      return n ? (n * n_ + b_.size() - 1) / b_.size() : 0;
+   }
+
+   /**@return view of triples with leading element ID @b i;
+    @b i should be less than n_keys() */
+   set_type fragment(const std::size_t i) const {
+      BOOST_ASSERT(i < n_keys());
+      if( ! frozen() ) {
+         const typename unpacked_type::set_type f = v_.fragment(i);
+         return set_type(f.begin(), f.end());
+      }
+      if( off_[i] == off_[i + 1] ) return set_type();
+      unsigned char const* const p = &b_[0];
+      return set_type(
+               id_type(static_cast<unsigned>(i)), p + off_[i], p + off_[i + 1]
+      );
+   }
+
+   /**@brief Pack all triples */
+   void freeze() {
+      if( frozen() ) return;
+      std::vector<unsigned char> b;
+      std::vector<std::size_t> off;
+      off.reserve(v_.n_keys() + 1);
+      off.push_back(0);
+      for( std::size_t i = 0; i != v_.n_keys(); ++i ) {
+         if( v_.keys().test(i) ) {
+            const typename unpacked_type::set_type f = v_.fragment(i);
+            pack_fragment<Tag1,Tag2,Tag3>(b, f.begin(), f.end());
+         }
+         off.push_back(b.size());
+      }
+      std::vector<unsigned char>(b).swap(b_);
+      off_.swap(off);
+      k_ = v_.keys();
+      n_ = v_.n_fragments();
+      unpacked_type().swap(v_);
+   }
+
+   bool insert(Triple const& t) {
+      thaw();
+      return v_.insert(t);
+   }
+
+   /**@brief Insert a batch of triples
+    @param v triples, which are re-ordered in place
+    @param n_threads maximal number of threads for sorting the batch and
+    merging it into fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+   */
+   std::size_t insert_batch(std::vector<Triple>& v, const unsigned n_threads = 1) {
+      if( v.empty() ) return 0;
+      thaw();
+      return v_.insert_batch(v, n_threads);
+   }
+
+   /**@brief Insert a batch of triples sorted in index order
+    @param v triples sorted by Index_order<Tag0,Tag1,Tag2,Tag3>
+    @param n_threads maximal number of threads for merging the batch into
+    fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+   */
+   std::size_t insert_sorted_batch(
+            std::vector<Triple> const& v,
+            const unsigned n_threads = 1
+   ) {
+      if( v.empty() ) return 0;
+      thaw();
+      return v_.insert_sorted_batch(v, n_threads);
+   }
+
+   /**@brief Erase a batch of triples
+    @param v triples, which are re-ordered in place
+    @return number of triples actually erased
+   */
+   std::size_t erase_batch(std::vector<Triple>& v) {
+      thaw();
+      return v_.erase_batch(v);
+   }
+
+   void erase(Triple const& t) {
+      thaw();
+      v_.erase(t);
+   }
+
+   void clear() {
+      v_.clear();
+      off_.clear();
+      b_.clear();
+      k_.clear();
+      n_ = 0;
+   }
+
+   set_type operator[](const id_type id) const {
+      if( id() >= n_keys() ) return set_type();
+      return fragment(id());
+   }
+
+   template<class Q0> struct query {
+      typedef typename Tip_query_dispatch<Tag0,Tag1,Tag2,Tag3,Q0>::iterator
+               iterator;
+
+      typedef typename Tip_query_dispatch<Tag0,Tag1,Tag2,Tag3,Q0>::range
+               range;
+   };
+
+   template<class Q0> typename query<Q0>::range
+   find(Q0 const& q) const {
+      return Tip_query_dispatch<Tag0,Tag1,Tag2,Tag3,Q0>::find(*this, q);
+   }
+
+private:
+   unpacked_type v_;
+   std::vector<std::size_t> off_; ///< packed fragment offsets, n_keys() + 1
+   std::vector<unsigned char> b_; ///< packed triples
+   boost::dynamic_bitset<> k_; ///< IDs with packed triples
+   std::size_t n_; ///< number of packed triples
+
+   /** unpack triples */
+   void thaw() {
+      if( ! frozen() ) return;
+      std::vector<Triple> v;
+      v.reserve(n_);
+      for( std::size_t i = next_key(0); i != n_keys(); i = next_key(i + 1) ) {
+         const set_type f = fragment(i);
+         v.insert(v.end(), f.begin(), f.end());
+      }
+      std::vector<std::size_t>().swap(off_);
+      std::vector<unsigned char>().swap(b_);
+      boost::dynamic_bitset<>().swap(k_);
+      n_ = 0;
+      v_.insert_batch(v);
+   }
+};
+
+}//namespace map_triple_detail
+}//namespace owlcpp
+#endif /* TRIPLE_INDEX_PACKED_IMPL_HPP_ */
@@ -5,6 +5,8 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef TRIPLE_INDEX_SELECTOR_HPP_
 #define TRIPLE_INDEX_SELECTOR_HPP_
+#include <cstddef>
+#include <vector>
 #include "boost/mpl/distance.hpp"
 #include "boost/mpl/bool.hpp"
 #include "boost/mpl/max_element.hpp"
@@ -36,6 +38,59 @@ template<
             >::type index;
 };
 
+/**@brief Collect costs of a query in each index;
+function object for boost::fusion::for_each
+*******************************************************************************/
+template<class QSubj, class QPred, class QObj, class QDoc> class Query_cost {
+public:
+   Query_cost(
+            QSubj const& subj, QPred const& pred, QObj const& obj, QDoc const& doc,
+            std::vector<std::size_t>& v
+   )
+   : subj_(subj), pred_(pred), obj_(obj), doc_(doc), v_(v)
+   {}
+
+   template<class Index> void operator()(Index const& i) const {
+      v_.push_back(i.cost(subj_, pred_, obj_, doc_));
+   }
+
+private:
+   QSubj const& subj_;
+   QPred const& pred_;
+   QObj const& obj_;
+   QDoc const& doc_;
+   std::vector<std::size_t>& v_;
+};
+
+/**@brief Search index at given position and convert result to @b Range;
+function object for boost::fusion::for_each
+*******************************************************************************/
+template<
+   class Range,
+   class QSubj, class QPred, class QObj, class QDoc
+> class Find_at {
+public:
+   Find_at(
+            QSubj const& subj, QPred const& pred, QObj const& obj, QDoc const& doc,
+            const std::size_t pos, std::size_t& n, Range& r
+   )
+   : subj_(subj), pred_(pred), obj_(obj), doc_(doc), pos_(pos), n_(n), r_(r)
+   {}
+
+   template<class Index> void operator()(Index const& i) const {
+      if( n_++ == pos_ ) r_ = Range(i.find(subj_, pred_, obj_, doc_));
+   }
+
+private:
+   QSubj const& subj_;
+   QPred const& pred_;
+   QObj const& obj_;
+   QDoc const& doc_;
+   std::size_t pos_;
+   std::size_t& n_;
+   Range& r_;
+};
+
 }//namespace map_triple_detail
 }//namespace owlcpp
 #endif /* TRIPLE_INDEX_SELECTOR_HPP_ */
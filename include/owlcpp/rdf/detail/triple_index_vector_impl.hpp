@@ -5,10 +5,12 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef TRIPLE_INDEX_VECTOR_IMPL_HPP_
 #define TRIPLE_INDEX_VECTOR_IMPL_HPP_
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
 #include "boost/assert.hpp"
+#include "boost/dynamic_bitset.hpp"
 #include "boost/foreach.hpp"
 #include "boost/fusion/sequence/intrinsic/at.hpp"
 #include "boost/iterator/filter_iterator.hpp"
@@ -16,48 +18,72 @@ part of owlcpp project.
 #include "boost/mpl/at.hpp"
 #include "boost/range.hpp"
 
+#include "owlcpp/detail/parallel_sort.hpp"
 #include "owlcpp/rdf/any_triple_element.hpp"
+#include "owlcpp/rdf/detail/fragment_inserter.hpp"
+#include "owlcpp/rdf/detail/fragment_table.hpp"
 #include "owlcpp/rdf/detail/triple_set.hpp"
 #include "owlcpp/rdf/exception.hpp"
 #include "owlcpp/rdf/triple.hpp"
 
 namespace owlcpp{ namespace map_triple_detail{
 
+template<class Tag0,class Tag1, class Tag2, class Tag3>
+class Triple_index_vector_impl;
+
+/**@return smallest position of set bit, which is not less than @b i,
+or b.size()
+*******************************************************************************/
+inline std::size_t next_set_bit(
+         boost::dynamic_bitset<> const& b,
+         const std::size_t i
+) {
+   if( i >= b.size() ) return b.size();
+   if( b.test(i) ) return i;
+   const std::size_t n = b.find_next(i);
+   return n == boost::dynamic_bitset<>::npos ? b.size() : n;
+}
+
 /**@brief Iterator for a vector of triple indices
+@details Dereferences to a pair of leading element ID and a view of the
+fragment of triples.
+IDs without triples are skipped.
 *******************************************************************************/
-template<class Id, class Iter> class Tiv_iterator
+template<class Id, class Fragment, class Impl> class Tiv_iterator
          : public boost::iterator_facade<
-              Tiv_iterator<Id,Iter>,
-              std::pair<Id, typename Iter::value_type const&>,
-              boost::random_access_traversal_tag,
-              std::pair<Id, typename Iter::value_type const&>
+              Tiv_iterator<Id,Fragment,Impl>,
+              std::pair<Id, Fragment>,
+              boost::forward_traversal_tag,
+              std::pair<Id, Fragment>
 > {
 public:
-   typedef std::pair<Id, typename Iter::value_type const&> value_type;
+   typedef std::pair<Id, Fragment> value_type;
 
-   Tiv_iterator(const Iter begin, const Iter i)
-   : begin_(begin), i_(i) {}
+   /**
+    @param s container
+    @param i non-empty ID or s.n_keys()
+   */
+   Tiv_iterator(Impl const& s, const std::size_t i)
+   : s_(&s), i_(i) {}
 
 private:
-   Iter begin_;
-   Iter i_;
+   Impl const* s_;
+   std::size_t i_;
 
    friend class boost::iterator_core_access;
 
-   void increment() {++i_;}
+   void increment() {i_ = s_->next_key(i_ + 1);}
 
    bool equal(Tiv_iterator const& i) const {
       BOOST_ASSERT(
-               begin_ == i.begin_ &&
+               s_ == i.s_ &&
                "only compare iterators for same container"
       );
       return  i_ == i.i_;
    }
 
    value_type dereference() const {
-      BOOST_ASSERT(begin_ <= i_);
-      const Id id(static_cast<unsigned>(i_ - begin_));
-      return value_type(id, *i_);
+      return value_type(Id(static_cast<unsigned>(i_)), s_->fragment(i_));
    }
 };
 
@@ -65,10 +91,12 @@ private:
 *******************************************************************************/
 template<class Tag0,class Tag1, class Tag2, class Tag3> struct Tiv_config {
    typedef typename boost::mpl::at<Triple, Tag0>::type id_type;
-   typedef Triple_set<Tag1,Tag2,Tag3> set_type;
-   typedef std::pair<id_type, set_type const&> value_type;
-   typedef std::vector<set_type> storage;
-   typedef Tiv_iterator<id_type, typename storage::const_iterator> iterator;
+   typedef Triple_fragment<Tag1,Tag2,Tag3> set_type;
+   typedef std::pair<id_type, set_type> value_type;
+   typedef Triple_set<Tag1,Tag2,Tag3> stored_set;
+   typedef Fragment_table<stored_set> storage;
+   typedef Triple_index_vector_impl<Tag0,Tag1,Tag2,Tag3> impl;
+   typedef Tiv_iterator<id_type, set_type, impl> iterator;
 };
 
 /**@brief
@@ -76,9 +104,7 @@ template<class Tag0,class Tag1, class Tag2, class Tag3> struct Tiv_config {
 template<class Tag0,class Tag1, class Tag2, class Tag3, class Q0>
 class Tiv_query_dispatch {
    typedef Tiv_config<Tag0,Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
-   typedef typename config::set_type set_type;
-   typedef typename config::id_type id_type;
+   typedef typename config::impl impl;
    typedef typename config::value_type value_type;
 
    class Equal : public std::unary_function<value_type, bool> {
@@ -93,7 +119,7 @@ public:
    typedef boost::filter_iterator<Equal, typename config::iterator> iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& s, const Q0 q0) {
+   static range find(impl const& s, const Q0 q0) {
       const Equal eq(q0);
       return range(
                iterator(eq, s.begin(), s.end()),
@@ -105,26 +131,33 @@ public:
 template<class Tag0,class Tag1, class Tag2, class Tag3>
 class Tiv_query_dispatch<Tag0,Tag1,Tag2,Tag3,Any> {
    typedef Tiv_config<Tag0,Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::impl impl;
 public:
    typedef typename config::iterator iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& s, Any const&) {
-      return range(
-               iterator(s.begin(), s.begin()),
-               iterator(s.begin(), s.end())
-      );
+   static range find(impl const& s, Any const&) {
+      return range(s.begin(), s.end());
    }
 };
 
-/**@brief Container of @b Set -s mapped against @b ID -s
-@details
+/**@brief Container of triple fragments mapped against @b ID -s
+@details Triple fragments are either stored in separate sets, which can be
+modified, or, after freeze(), in a compressed sparse row (CSR) layout:
+one contiguous array of triples sorted in index order and one array of
+offsets of each fragment, indexed by the leading element ID.
+Frozen index is automatically thawed by the first modification.
+@n Separate sets are kept in Fragment_table, which does not allocate sets
+for sparse ranges of IDs.
+In either layout, a bitmap of IDs with non-empty fragments lets iterators
+skip empty IDs, and the number of triples is maintained incrementally.
+@n Fragments are accessed through Triple_fragment views.
 *******************************************************************************/
 template<class Tag0,class Tag1, class Tag2, class Tag3>
 class Triple_index_vector_impl {
    typedef Tiv_config<Tag0,Tag1,Tag2,Tag3> config;
    typedef typename config::storage storage;
+   typedef typename config::stored_set stored_set;
 
 public:
    typedef typename config::set_type set_type;
@@ -134,36 +167,177 @@ public:
    typedef iterator const_iterator;
    typedef boost::iterator_range<iterator> range;
 
-   const_iterator begin() const {return const_iterator(s_.begin(), s_.begin());}
-   const_iterator end() const {return const_iterator(s_.begin(), s_.end());}
+   Triple_index_vector_impl() : s_(), off_(), t_(), b_(), n_(0) {}
 
-   std::size_t n_fragments() const {
-      std::size_t n = 0;
-      BOOST_FOREACH(set_type const& set, s_) {n += set.size();}
-      return n;
+   const_iterator begin() const {return const_iterator(*this, next_key(0));}
+   const_iterator end() const {return const_iterator(*this, n_keys());}
+
+   std::size_t n_fragments() const {return n_;}
+
+   /**@return true if triples are stored in CSR layout */
+   bool frozen() const {return ! off_.empty();}
+
+   /**@return number of leading element IDs, including those without triples */
+   std::size_t n_keys() const {return b_.size();}
+
+   /**@return smallest ID with triples, which is not less than @b i,
+    or n_keys() */
+   std::size_t next_key(const std::size_t i) const {return next_set_bit(b_, i);}
+
+   /**@return bitmap of IDs with triples */
+   boost::dynamic_bitset<> const& keys() const {return b_;}
+
+   /**@return number of triples with leading element @b id */
+   std::size_t fragment_size(const id_type id) const {
+      return id() < n_keys() ? fragment(id()).size() : 0;
+   }
+
+   /**@return view of triples with leading element ID @b i;
+    @b i should be less than n_keys() */
+   set_type fragment(const std::size_t i) const {
+      BOOST_ASSERT(i < n_keys());
+      if( ! frozen() ) {
+         stored_set const* const ts = s_.find(i);
+         return ts ? set_type(*ts) : set_type();
+      }
+      if( t_.empty() ) return set_type();
+      Triple const* const p = &t_[0];
+      return set_type(p + off_[i], p + off_[i + 1]);
+   }
+
+   /**@brief Move all triples into CSR layout
+    @details Fragment sets are released while their triples are copied,
+    so that peak memory use stays close to the size of the index.
+   */
+   void freeze() {
+      if( frozen() ) return;
+      std::vector<Triple> t;
+      t.reserve(n_);
+      std::vector<std::size_t> off;
+      off.reserve(n_keys() + 1);
+      off.push_back(0);
+      for( std::size_t i = 0; i != n_keys(); ++i ) {
+         if( b_.test(i) ) {
+            stored_set& set = s_.get(i);
+            t.insert(t.end(), set.begin(), set.end());
+            stored_set().swap(set);
+         }
+         off.push_back(t.size());
+      }
+      s_.clear();
+      t_.swap(t);
+      off_.swap(off);
    }
 
    bool insert(Triple const& t) {
+      thaw();
       const id_type id = boost::fusion::at<Tag0>(t);
-      if( id() >= s_.size() ) s_.resize(id() + 1);
-      return s_[id()].insert(t);
+      if( ! s_.get(id()).insert(t) ) return false;
+      mark(id());
+      ++n_;
+      return true;
+   }
+
+   /**@brief Insert a batch of triples
+    @param v triples, which are re-ordered in place
+    @param n_threads maximal number of threads for sorting the batch and
+    merging it into fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+   */
+   std::size_t insert_batch(std::vector<Triple>& v, const unsigned n_threads = 1) {
+      detail::parallel_sort(
+               v.begin(), v.end(), Index_order<Tag0,Tag1,Tag2,Tag3>(), n_threads
+      );
+      return insert_sorted_batch(v, n_threads);
+   }
+
+   /**@brief Insert a batch of triples sorted in index order
+    @param v triples sorted by Index_order<Tag0,Tag1,Tag2,Tag3>
+    @param n_threads maximal number of threads for merging the batch into
+    fragments; 0 selects the number of hardware threads
+    @return number of triples actually inserted
+   */
+   std::size_t insert_sorted_batch(
+            std::vector<Triple> const& v,
+            const unsigned n_threads = 1
+   ) {
+      if( v.empty() ) return 0;
+      thaw();
+      typedef std::vector<Triple>::const_iterator iter_t;
+
+      //create all sets first, since inserting sets may move other sets
+      for( iter_t i = v.begin(); i != v.end(); ) {
+         const id_type id = boost::fusion::at<Tag0>(*i);
+         s_.get(id());
+         mark(id());
+         for( ++i; i != v.end() && boost::fusion::at<Tag0>(*i) == id; ++i );
+      }
+
+      Fragment_inserter<stored_set> fi;
+      for( iter_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const id_type id = boost::fusion::at<Tag0>(*i1);
+         for( i2 = i1 + 1; i2 != v.end() && boost::fusion::at<Tag0>(*i2) == id; ++i2 );
+         fi.add(s_.get(id()), i1, i2);
+      }
+      const std::size_t n = fi.run(n_threads);
+      n_ += n;
+      return n;
+   }
+
+   /**@brief Erase a batch of triples
+    @param v triples, which are re-ordered in place
+    @return number of triples actually erased
+   */
+   std::size_t erase_batch(std::vector<Triple>& v) {
+      thaw();
+      std::sort(v.begin(), v.end(), Index_order<Tag0,Tag1,Tag2,Tag3>());
+      std::size_t n = 0;
+      typedef std::vector<Triple>::const_iterator iter_t;
+      for( iter_t i1 = v.begin(), i2; i1 != v.end(); i1 = i2 ) {
+         const id_type id = boost::fusion::at<Tag0>(*i1);
+         for( i2 = i1 + 1; i2 != v.end() && boost::fusion::at<Tag0>(*i2) == id; ++i2 );
+         if( id() >= n_keys() || ! b_.test(id()) ) continue;
+         stored_set& set = s_.get(id());
+         n += set.erase_sorted(i1, i2);
+         if( set.empty() ) unmark(id());
+      }
+      n_ -= n;
+      return n;
    }
 
    void erase(Triple const& t) {
+      thaw();
       const id_type id = boost::fusion::at<Tag0>(t);
-      if( id() >= s_.size() ) BOOST_THROW_EXCEPTION(
+      if( id() >= n_keys() || ! b_.test(id()) ) BOOST_THROW_EXCEPTION(
                Rdf_err()
                << Rdf_err::msg_t("element not found")
                << Rdf_err::int1_t(id())
       );
-      s_[id()].erase(t);
+      stored_set& set = s_.get(id());
+      set.erase(t);
+      --n_;
+      if( set.empty() ) unmark(id());
    }
 
-   void clear() {s_.clear();}
+   void clear() {
+      s_.clear();
+      off_.clear();
+      t_.clear();
+      b_.clear();
+      n_ = 0;
+   }
 
-   set_type const& operator[](const id_type id) const {
-      if( id() >= s_.size() ) return set_type::empty_set();
-      return s_[id()];
+   void swap(Triple_index_vector_impl& v) {
+      s_.swap(v.s_);
+      off_.swap(v.off_);
+      t_.swap(v.t_);
+      b_.swap(v.b_);
+      std::swap(n_, v.n_);
+   }
+
+   set_type operator[](const id_type id) const {
+      if( id() >= n_keys() ) return set_type();
+      return fragment(id());
    }
 
    template<class Q0> struct query {
@@ -176,11 +350,36 @@ public:
 
    template<class Q0> typename query<Q0>::range
    find(Q0 const& q) const {
-      return Tiv_query_dispatch<Tag0,Tag1,Tag2,Tag3,Q0>::find(s_, q);
+      return Tiv_query_dispatch<Tag0,Tag1,Tag2,Tag3,Q0>::find(*this, q);
    }
 
 private:
    storage s_;
+   std::vector<std::size_t> off_; ///< CSR fragment offsets, n_keys() + 1
+   std::vector<Triple> t_; ///< CSR triples
+   boost::dynamic_bitset<> b_; ///< IDs with non-empty fragments
+   std::size_t n_; ///< number of triples
+
+   void mark(const std::size_t i) {
+      if( i >= b_.size() ) b_.resize(i + 1);
+      b_.set(i);
+   }
+
+   void unmark(const std::size_t i) {
+      b_.reset(i);
+      s_.erase(i);
+   }
+
+   /** move triples from CSR layout back into fragment sets */
+   void thaw() {
+      if( ! frozen() ) return;
+      for( std::size_t i = next_key(0); i != n_keys(); i = next_key(i + 1) ) {
+         Triple const* const p = &t_[0];
+         s_.get(i).insert_sorted(p + off_[i], p + off_[i + 1]);
+      }
+      std::vector<std::size_t>().swap(off_);
+      std::vector<Triple>().swap(t_);
+   }
 };
 
 }//namespace map_triple_detail
@@ -89,13 +89,30 @@ private:
    Q3 q3_;
 };
 
+/**@brief Order triples by all four elements, starting with @b Tag0
+@details Used for sorting batches of triples before merging them into
+triple index fragments.
+*******************************************************************************/
+template<class Tag0, class Tag1, class Tag2, class Tag3> struct Index_order
+: public std::binary_function<Triple, Triple, bool> {
+   bool operator() (Triple const& t1, Triple const& t2) const {
+      using boost::fusion::at;
+      if( at<Tag0>(t1) < at<Tag0>(t2) ) return true;
+      if( at<Tag0>(t2) < at<Tag0>(t1) ) return false;
+      return Value_predicate<Tag1,Tag2,Tag3>()(t1, t2);
+   }
+};
+
 /**@brief Define elements of Triple_set used by other classes
+@details Sorted triples are searched through pointer ranges, so that same
+search algorithms and range types apply to Triple_set and to fragments of
+frozen triple indices.
 *******************************************************************************/
 template<class Tag1, class Tag2, class Tag3> struct Triple_set_config {
    typedef std::vector<Triple> storage;
    typedef Triple value_type;
    typedef storage::iterator iterator;
-   typedef storage::const_iterator const_iterator;
+   typedef Triple const* const_iterator;
    typedef boost::iterator_range<const_iterator> range;
 };
 
@@ -108,13 +125,13 @@ template<
 > class Ts_query_dispatch {
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Q2,Q3> predicate;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
    typedef typename config::const_iterator iter;
 public:
    typedef boost::filter_iterator<predicate, iter> iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
+   static range find(frange const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
       const predicate p(q1,q2,q3);
       return range(
                iterator(p, v.begin(), v.end()),
@@ -131,14 +148,14 @@ public:
 template<class Tag1, class Tag2, class Tag3>
 class Ts_query_dispatch<Tag1,Tag2,Tag3,Any,Any,Any> {
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
 
 public:
    typedef typename config::const_iterator iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Any, const Any, const Any) {
-      return range(v);
+   static range find(frange const& v, const Any, const Any, const Any) {
+      return v;
    }
 
    static const int efficiency = 0;
@@ -159,14 +176,14 @@ template<
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Any,Any> pred1;
    typedef Value_predicate<Tag1,Tag2,Tag3,Any,Q2,Q3> pred2;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
    typedef typename config::const_iterator iter1;
    typedef boost::iterator_range<iter1> range1;
 public:
    typedef boost::filter_iterator<pred2, iter1> iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
+   static range find(frange const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
       const pred1 p1(q1, any, any);
       BOOST_ASSERT(boost::is_sorted(v, p1));
       range1 r = boost::equal_range(v, p1);
@@ -193,12 +210,12 @@ template<
    typedef typename boost::mpl::at<Triple, Tag1>::type Q1;
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Any,Any> pred;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
 public:
    typedef typename config::const_iterator iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Any, const Any) {
+   static range find(frange const& v, const Q1 q1, const Any, const Any) {
       const pred p(q1, any, any);
       BOOST_ASSERT(boost::is_sorted(v, p));
       return boost::equal_range(v, p);
@@ -224,14 +241,14 @@ template<
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Q2,Any> pred1;
    typedef Value_predicate<Tag1,Tag2,Tag3,Any,Any,Q3> pred2;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
    typedef typename config::const_iterator iter1;
    typedef boost::iterator_range<iter1> range1;
 public:
    typedef boost::filter_iterator<pred2, iter1> iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
+   static range find(frange const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
       const pred1 p1(q1, q2, any);
       BOOST_ASSERT(boost::is_sorted(v, p1));
       range1 r = boost::equal_range(v, p1);
@@ -260,12 +277,12 @@ template<
    typedef typename boost::mpl::at<Triple, Tag2>::type Q2;
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Q2,Any> pred1;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
 public:
    typedef typename config::const_iterator iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Q2 q2, const Any) {
+   static range find(frange const& v, const Q1 q1, const Q2 q2, const Any) {
       const pred1 p1(q1, q2, any);
       BOOST_ASSERT(boost::is_sorted(v, p1));
       return boost::equal_range(v, p1);
@@ -290,12 +307,12 @@ template<
    typedef typename boost::mpl::at<Triple, Tag3>::type Q3;
    typedef Value_predicate<Tag1,Tag2,Tag3,Q1,Q2,Q3> pred1;
    typedef Triple_set_config<Tag1,Tag2,Tag3> config;
-   typedef typename config::storage storage;
+   typedef typename config::range frange;
 public:
    typedef typename config::const_iterator iterator;
    typedef boost::iterator_range<iterator> range;
 
-   static range find(storage const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
+   static range find(frange const& v, const Q1 q1, const Q2 q2, const Q3 q3) {
       const pred1 p1(q1, q2, q3);
       BOOST_ASSERT(boost::is_sorted(v, p1));
       return boost::equal_range(v, p1);
@@ -323,8 +340,8 @@ public:
 
    Triple_set() {}
 
-   const_iterator begin() const {return v_.begin();}
-   const_iterator end() const {return v_.end();}
+   const_iterator begin() const {return v_.empty() ? 0 : &v_[0];}
+   const_iterator end() const {return v_.empty() ? 0 : &v_[0] + v_.size();}
    std::size_t size() const {return v_.size();}
    bool empty() const {return v_.empty();}
 
@@ -341,6 +358,48 @@ public:
       return false;
    }
 
+   /**@brief Merge a range of triples into the set
+    @param first,last range of triples sorted by
+    Value_predicate<Tag1,Tag2,Tag3>; duplicates are allowed
+    @return number of triples actually inserted
+    @details Triples are appended to the end of the storage and merged in
+    a single pass, which avoids shifting the storage for every triple.
+   */
+   template<class Iter> std::size_t insert_sorted(const Iter first, const Iter last) {
+      const Value_predicate<Tag1,Tag2,Tag3> vp;
+      BOOST_ASSERT(std::is_sorted(first, last, vp));
+      const std::size_t n0 = v_.size();
+      v_.insert(v_.end(), first, last);
+      std::inplace_merge(v_.begin(), v_.begin() + n0, v_.end(), vp);
+      v_.erase(std::unique(v_.begin(), v_.end()), v_.end());
+      return v_.size() - n0;
+   }
+
+   /**@brief Remove a range of triples from the set
+    @param first,last range of triples sorted by
+    Value_predicate<Tag1,Tag2,Tag3>
+    @return number of triples actually removed
+    @details Remaining triples are shifted in a single pass.
+   */
+   template<class Iter> std::size_t erase_sorted(Iter first, const Iter last) {
+      const Value_predicate<Tag1,Tag2,Tag3> vp;
+      BOOST_ASSERT(std::is_sorted(first, last, vp));
+      if( first == last ) return 0;
+      const std::size_t n0 = v_.size();
+      iterator out = std::lower_bound(v_.begin(), v_.end(), *first, vp);
+      iterator i = out;
+      for( ; i != v_.end() && first != last; ++i ) {
+         while( first != last && vp(*first, *i) ) ++first;
+         if( first != last && *first == *i ) {
+            ++first;
+            continue;
+         }
+         *out++ = *i;
+      }
+      v_.erase(std::copy(i, v_.end(), out), v_.end());
+      return n0 - v_.size();
+   }
+
    void erase(Triple const& t) {
       Value_predicate<Tag1,Tag2,Tag3> vp(t);
       iterator i = boost::lower_bound(v_, vp);
@@ -350,6 +409,13 @@ public:
       v_.erase(i);
    }
 
+   void swap(Triple_set& ts) {v_.swap(ts.v_);}
+
+   /**@brief Release unused storage capacity */
+   void shrink() {
+      if( v_.capacity() != v_.size() ) storage(v_).swap(v_);
+   }
+
    template<class Q1, class Q2, class Q3> struct query {
       typedef Ts_query_dispatch<Tag1,Tag2,Tag3,Q1,Q2,Q3> dispatch;
       typedef typename dispatch::iterator iterator;
@@ -360,13 +426,57 @@ public:
    template<class Q1, class Q2, class Q3>
    typename query<Q1,Q2,Q3>::range
    find(const Q1 q1, const Q2 q2, const Q3 q3) const {
-      return query<Q1,Q2,Q3>::dispatch::find(v_, q1, q2, q3);
+      return query<Q1,Q2,Q3>::dispatch::find(range(begin(), end()), q1, q2, q3);
    }
 
 private:
    storage v_;
 };
 
+/**@brief Read-only view of sorted triples
+@details Refers to the triples of a Triple_set or to a part of contiguous
+array of a frozen triple index; searched in the same way as Triple_set.
+The view is invalidated by any modification of the referred triples.
+*******************************************************************************/
+template<class Tag1, class Tag2, class Tag3> class Triple_fragment {
+   typedef Triple_set_config<Tag1,Tag2,Tag3> config;
+
+public:
+   typedef Triple value_type;
+   typedef typename config::const_iterator const_iterator;
+   typedef const_iterator iterator;
+   typedef boost::iterator_range<const_iterator> range;
+
+   Triple_fragment() : begin_(0), end_(0) {}
+
+   Triple_fragment(const const_iterator begin, const const_iterator end)
+   : begin_(begin), end_(end) {}
+
+   Triple_fragment(Triple_set<Tag1,Tag2,Tag3> const& ts)
+   : begin_(ts.begin()), end_(ts.end()) {}
+
+   const_iterator begin() const {return begin_;}
+   const_iterator end() const {return end_;}
+   std::size_t size() const {return end_ - begin_;}
+   bool empty() const {return begin_ == end_;}
+
+   /** for testing only */
+   Triple const& operator[](const std::size_t n) const {return begin_[n];}
+
+   template<class Q1, class Q2, class Q3> struct query
+            : public Triple_set<Tag1,Tag2,Tag3>::template query<Q1,Q2,Q3> {};
+
+   template<class Q1, class Q2, class Q3>
+   typename query<Q1,Q2,Q3>::range
+   find(const Q1 q1, const Q2 q2, const Q3 q3) const {
+      return query<Q1,Q2,Q3>::dispatch::find(range(begin_, end_), q1, q2, q3);
+   }
+
+private:
+   const_iterator begin_;
+   const_iterator end_;
+};
+
 }//namespace map_triple_detail
 }//namespace owlcpp
 #endif /* TRIPLE_SET_HPP_ */
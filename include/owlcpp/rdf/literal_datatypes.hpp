@@ -12,6 +12,7 @@ internal representations, default datatypes, conversions
 #include "boost/cstdint.hpp"
 #include "boost/lexical_cast.hpp"
 #include "boost/numeric/conversion/cast.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/rdf/config.hpp"
 #include "owlcpp/rdf/exception.hpp"
@@ -29,7 +30,11 @@ struct OWLCPP_RDF_DECL Datatype_bool {
    static const std::string true_str;
    static const std::string false_str;
 
-   static value_type convert(std::string const& str, const Node_id);
+   static value_type convert(boost::string_ref const str, const Node_id dt);
+
+   static value_type convert(std::string const& str, const Node_id dt) {
+      return convert(boost::string_ref(str), dt);
+   }
 
    template<class T> static value_type convert(const T x, const Node_id) {
       return boost::numeric_cast<value_type>(x);
@@ -51,7 +56,11 @@ struct OWLCPP_RDF_DECL Datatype_int{
    typedef boost::intmax_t value_type;
    typedef owlcpp::terms::xsd_int default_datatype;
 
-   static value_type convert(std::string const& str, const Node_id);
+   static value_type convert(boost::string_ref const str, const Node_id dt);
+
+   static value_type convert(std::string const& str, const Node_id dt) {
+      return convert(boost::string_ref(str), dt);
+   }
 
    template<class T> static value_type convert(const T x, const Node_id) {
       return boost::numeric_cast<value_type>(x);
@@ -73,7 +82,11 @@ struct OWLCPP_RDF_DECL Datatype_unsigned{
    typedef boost::uintmax_t value_type;
    typedef owlcpp::terms::xsd_unsignedInt default_datatype;
 
-   static value_type convert(std::string const& str, const Node_id dt);
+   static value_type convert(boost::string_ref const str, const Node_id dt);
+
+   static value_type convert(std::string const& str, const Node_id dt) {
+      return convert(boost::string_ref(str), dt);
+   }
 
    template<class T> static value_type convert(const T x, const Node_id) {
       return boost::numeric_cast<value_type>(x);
@@ -95,7 +108,11 @@ struct OWLCPP_RDF_DECL Datatype_real{
    typedef double value_type;
    typedef owlcpp::terms::xsd_double default_datatype;
 
-   static value_type convert(std::string const& str, const Node_id dt);
+   static value_type convert(boost::string_ref const str, const Node_id dt);
+
+   static value_type convert(std::string const& str, const Node_id dt) {
+      return convert(boost::string_ref(str), dt);
+   }
 
    template<class T> static value_type convert(const T x, const Node_id) {
       return boost::numeric_cast<value_type>(x);
@@ -207,6 +207,54 @@ public:
       return std::make_pair(id, true);
    }
 
+   /**@brief Add document info with known ID, e.g., when restoring saved store
+    @throw Err if document with ID @b did is already present or if document
+    info is not valid
+   */
+   void insert(
+            const Doc_id did,
+            const Node_id iri,
+            std::string const& path,
+            const Node_id vers
+   ) {
+      if( find(did) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("document ID is reserved")
+               << Err::int1_t(did())
+      );
+      if( iri == terms::empty_::id() || iri == vers ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid ontologyIRI")
+               << Err::str1_t(path)
+      );
+      if( check_existing(iri, vers, path) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("duplicate document")
+               << Err::str1_t(path)
+      );
+      idt_.reserve(did);
+      m_.insert(Doc_meta_wrap(iri, vers, path, did));
+   }
+
+   /**@return ID that will be assigned to the next inserted document */
+   Doc_id next_id() const {return idt_.next();}
+
+   /**@brief Remove document info
+    @details Document ID may be reused by subsequently inserted documents.
+    @throw Err if document with ID @b did is not present
+   */
+   void erase(const Doc_id did) {
+      id_index_t& index = m_.get<id_tag>();
+      const id_index_t::iterator iter = index.find(did);
+      if( iter == index.end() ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid document ID")
+               << Err::int1_t(did())
+      );
+      index.erase(iter);
+      idt_.push(did);
+   }
+
    void clear() {
       m_.clear();
       idt_ = detail::Id_tracker<Doc_id>();
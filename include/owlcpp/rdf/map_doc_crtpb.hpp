@@ -6,11 +6,14 @@ part of owlcpp project.
 #ifndef MAP_DOC_CRTPB_HPP_
 #define MAP_DOC_CRTPB_HPP_
 #include "boost/assert.hpp"
+#include "boost/foreach.hpp"
 
 #include "owlcpp/detail/map_traits.hpp"
 #include "owlcpp/doc_id.hpp"
 #include "owlcpp/exception.hpp"
+#include "owlcpp/rdf/node_blank.hpp"
 #include "owlcpp/rdf/store_concepts.hpp"
+#include "owlcpp/rdf/triple.hpp"
 #include "owlcpp/terms/node_tags_system.hpp"
 
 namespace owlcpp{
@@ -34,6 +37,15 @@ template<class Super> class Map_doc_crtpb {
       return static_cast<Super&>(*this).map_doc_;
    }
 
+   /** erase @b nid if it is a blank node of document @b did */
+   void erase_blank(const Node_id nid, const Doc_id did) {
+      map_node_t& map_node = static_cast<Super&>(*this).map_node_;
+      Node const*const node = map_node.find(nid);
+      if( ! node || ! is_blank(node->ns_id()) ) return;
+      if( static_cast<Node_blank const*>(node)->document() != did ) return;
+      map_node.erase(nid);
+   }
+
 public:
    typedef typename map_doc_type::iri_range doc_iri_range;
    typedef typename map_doc_type::version_range doc_version_range;
@@ -131,6 +143,28 @@ public:
          );
       }
    }
+
+   /**@brief Remove document info, triples, and blank nodes of a document
+    @param did document ID
+    @return number of removed triples
+    @throw Err if document is not found
+    @details Time is proportional to the number of the document's triples
+    rather than to the size of the store if the triple map has an index
+    leading with document ID (see Map_triple).
+    IRI and literal nodes are kept even when no remaining triples refer to them.
+    The removed document ID may be assigned to a subsequently inserted document.
+   */
+   std::size_t remove_doc(const Doc_id did) {
+      _map_doc().at(did);
+      Super& super = static_cast<Super&>(*this);
+      BOOST_FOREACH(Triple const& t, super.map_triple_.doc_triples(did)) {
+         erase_blank(t.subj_, did);
+         erase_blank(t.obj_, did);
+      }
+      const std::size_t n = super.map_triple_.erase_doc(did);
+      _map_doc().erase(did);
+      return n;
+   }
 };
 
 }//namespace owlcpp
@@ -9,11 +9,9 @@ part of owlcpp project.
 #include <vector>
 #include <memory>
 #include "boost/assert.hpp"
-#include "boost/ptr_container/ptr_vector.hpp"
-#include "boost/ptr_container/indirect_fun.hpp"
-#include "boost/unordered_map.hpp"
-#include "boost/foreach.hpp"
-#include "boost/concept_check.hpp"
+#include "boost/functional/hash.hpp"
+#include "boost/iterator/iterator_facade.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/rdf/node.hpp"
 #include "owlcpp/rdf/node_blank.hpp"
@@ -21,9 +19,10 @@ part of owlcpp project.
 #include "owlcpp/rdf/node_literal.hpp"
 #include "owlcpp/rdf/exception.hpp"
 #include "owlcpp/rdf/print_node.hpp"
+#include "owlcpp/rdf/detail/node_hash_index.hpp"
+#include "owlcpp/rdf/detail/node_store.hpp"
 #include "owlcpp/doc_id.hpp"
 #include "owlcpp/node_id.hpp"
-#include "owlcpp/detail/iterator_member_pair.hpp"
 #include "owlcpp/detail/datatype_impl.hpp"
 #include "owlcpp/terms/detail/max_standard_id.hpp"
 
@@ -31,6 +30,15 @@ namespace owlcpp{
 
 /**@brief Store polymorphic RDF nodes
 @details
+Nodes are stored by value in contiguous type-segregated blocks
+(detail::Node_stores).
+IRI fragments and string literal values are interned in a string pool,
+so accessors of stored nodes return references to interned strings.
+Node lookup uses open addressing hash table of node IDs
+(detail::Node_hash_index), which stores truncated hash values to avoid
+comparing most of non-matching nodes.
+Iteration is in the order of node IDs.
+
 Validity of node IDs is assumed and asserted in debug mode.
 Calling node map methods with invalid node IDs results in undefined behavior.
 *******************************************************************************/
@@ -40,21 +48,70 @@ public:
    typedef Node node_type;
 private:
    typedef std::auto_ptr<node_type> ptr_t;
-   typedef boost::ptr_vector<boost::nullable<Node> > vector_t;
-   typedef boost::unordered_map<
-            Node const*,
-            Node_id,
-            boost::indirect_fun<boost::hash<Node> >,
-            boost::indirect_fun<std::equal_to<Node> >
-   > map_t;
-
-   typedef map_t::iterator map_iter_t;
-   typedef map_t::const_iterator map_citer_t;
-   typedef std::pair<map_iter_t,bool> insert_t;
-   typedef std::pair<Node const*,Node_id> map_element_t;
+   typedef std::vector<Node const*> vector_t;
+
+   class Equal_node {
+   public:
+      Equal_node(Map_node const& mn, Node const& node) : mn_(mn), node_(node) {}
+      bool operator()(const Node_id id) const {return mn_.get(id) == node_;}
+   private:
+      Map_node const& mn_;
+      Node const& node_;
+   };
+
+   /** compare stored node of type T with a key of different type */
+   template<class T, class Ref, class Eq> class Equal_ref {
+   public:
+      Equal_ref(Map_node const& mn, Ref const& ref) : mn_(mn), ref_(ref) {}
+      bool operator()(const Node_id id) const {
+         T const* p = dynamic_cast<T const*>(&mn_.get(id));
+         return p && Eq()(ref_, *p);
+      }
+   private:
+      Map_node const& mn_;
+      Ref ref_;
+   };
+
+   typedef Equal_ref<
+            Node_iri, detail::Node_iri_ref, detail::Node_iri_ref_equal
+   > equal_iri_t;
+
+   typedef Equal_ref<
+            Node_string, detail::Node_string_ref, detail::Node_string_ref_equal
+   > equal_string_t;
 
 public:
-   typedef Iterator_member_pair<map_citer_t, Node_id const, 2> iterator;
+   class iterator
+   : public boost::iterator_facade<
+        iterator,
+        const Node_id,
+        boost::forward_traversal_tag,
+        Node_id
+     > {
+   public:
+      iterator() : i_(), end_(), n_(0) {}
+
+      iterator(
+               const vector_t::const_iterator i,
+               const vector_t::const_iterator end,
+               const std::size_t n
+      )
+      : i_(i), end_(end), n_(n)
+      {skip();}
+
+   private:
+      vector_t::const_iterator i_;
+      vector_t::const_iterator end_;
+      std::size_t n_;
+
+      friend class boost::iterator_core_access;
+
+      void skip() {for( ; i_ != end_ && ! *i_; ++i_, ++n_ );}
+      void increment() {++i_; ++n_; skip();}
+      bool equal(iterator const& i) const {return i_ == i.i_;}
+      Node_id dereference() const {return Node_id(n_ + detail::min_node_id()());}
+   };
+
    typedef iterator const_iterator;
 
    struct Err : public Rdf_err {};
@@ -62,7 +119,11 @@ public:
    Map_node() {}
 
    Map_node(Map_node const& mn)
-   : vid_(mn.vid_.size()), map_(), erased_(mn.erased_)
+   : vid_(mn.vid_.size(), 0),
+     stores_(),
+     index_(mn.index_),
+     erased_(mn.erased_),
+     listed_(mn.listed_)
    {
       copy(mn);
    }
@@ -70,23 +131,25 @@ public:
    Map_node& operator=(Map_node const& mn) {
       if( this != &mn) {
          clear();
-         vid_.reserve(mn.vid_.size());
+         vid_.resize(mn.vid_.size(), 0);
          copy(mn);
+         index_ = mn.index_;
          erased_ = mn.erased_;
+         listed_ = mn.listed_;
       }
       return *this;
    }
 
-   std::size_t size() const { return map_.size(); }
-   const_iterator begin() const {return map_.begin();}
-   const_iterator end() const {return map_.end();}
-   bool empty() const {return map_.empty();}
+   std::size_t size() const { return index_.size(); }
+   const_iterator begin() const {return iterator(vid_.begin(), vid_.end(), 0);}
+   const_iterator end() const {return iterator(vid_.end(), vid_.end(), vid_.size());}
+   bool empty() const {return index_.empty();}
 
    Node const& operator[](const Node_id id) const {
       const std::size_t n = vpos(id);
       BOOST_ASSERT( n < vid_.size() );
-      BOOST_ASSERT( ! vid_.is_null(n) );
-      return vid_[n];
+      BOOST_ASSERT( vid_[n] );
+      return *vid_[n];
    }
 
    Node const& at(const Node_id id) const {
@@ -103,20 +166,29 @@ public:
                id < detail::min_node_id() ||
                id() >= vid_.size() + detail::min_node_id()()
       ) return 0;
-      return  &vid_[vpos(id)];
+      return vid_[vpos(id)];
    }
 
+   /**
+    @return pointer to node ID or NULL;
+    the pointer is invalidated by subsequent node insertion or removal
+   */
    Node_id const* find(Node const& node) const {
-      const map_citer_t i = map_.find(&node);
-      return i == map_.end() ? 0 : &i->second;
+      return index_.find(hash(node), Equal_node(*this, node));
    }
 
-   Node_id const* find_iri(const Ns_id ns, std::string const& val) const {
-      return find(Node_iri(ns, val));
+   Node_id const* find_iri(const Ns_id ns, boost::string_ref const& val) const {
+      const detail::Node_iri_ref ref(ns, val);
+      return index_.find(
+               detail::Node_iri_ref_hash()(ref),
+               equal_iri_t(*this, ref)
+      );
    }
 
    Node_id const* find_literal(
-            std::string const& val, const Node_id dt, std::string const& lang
+            boost::string_ref const& val,
+            const Node_id dt,
+            boost::string_ref const& lang
    ) const {
       switch(internal_type_id(dt)) {
       case detail::Bool_tid:
@@ -129,10 +201,10 @@ public:
          return find(Node_double(val, dt));
       case detail::String_tid:
       case detail::Unknown_tid:
-         return find( Node_string(val, dt, lang) );
+         return find_string(detail::Node_string_ref(val, dt, lang));
       case detail::Empty_tid:
       default:
-         return find( Node_string(val, lang) );
+         return find_string(detail::Node_string_ref(val, string_dt(), lang));
       }
    }
 
@@ -140,35 +212,25 @@ public:
       return find(Node_blank(n, doc));
    }
 
-   /** insert a clone of the %node */
+   /** insert a copy of the %node */
    Node_id insert(Node const& node) {
-      if( Node_id const* id = find(node) ) return *id;
-      Node* np = node.clone();
-
-      //make new ID
-      if( erased_.empty() ) {
-         const Node_id id = nid(vid_.size());
-         vid_.push_back(np);
-         map_.emplace(np, id);
-         return id;
-      }
-      const Node_id id = erased_.back();
-      erased_.pop_back();
-      const std::size_t n = vpos(id);
-      BOOST_ASSERT(vid_.is_null(n));
-      vid_.replace(n, np);
-      map_.emplace(np, id);
-      return id;
+      const std::size_t h = hash(node);
+      if( Node_id const* id = index_.find(h, Equal_node(*this, node)) ) return *id;
+      return insert_new(h, stores_.insert(node));
    }
 
-   Node_id insert_iri(const Ns_id ns, std::string const& val) {
-      return insert(Node_iri(ns,val));
+   /** insert IRI node; the fragment is only copied if the node is new */
+   Node_id insert_iri(const Ns_id ns, boost::string_ref const& val) {
+      const detail::Node_iri_ref ref(ns, val);
+      const std::size_t h = detail::Node_iri_ref_hash()(ref);
+      if( Node_id const* id = index_.find(h, equal_iri_t(*this, ref)) ) return *id;
+      return insert_new(h, stores_.insert_iri(ns, val));
    }
 
    Node_id insert_literal(
-            std::string const& val,
+            boost::string_ref const& val,
             const Node_id dt,
-            std::string const& lang = ""
+            boost::string_ref const& lang = ""
    ) {
       switch(internal_type_id(dt)) {
       case detail::Bool_tid:
@@ -181,10 +243,10 @@ public:
          return insert( Node_double(val, dt) );
       case detail::String_tid:
       case detail::Unknown_tid:
-         return insert( Node_string(val, dt, lang) );
+         return insert_string(detail::Node_string_ref(val, dt, lang));
       case detail::Empty_tid:
       default:
-         return insert( Node_string(val, lang) );
+         return insert_string(detail::Node_string_ref(val, string_dt(), lang));
       }
    }
 
@@ -192,26 +254,96 @@ public:
       return insert(Node_blank(n, doc));
    }
 
+   /**@brief insert node with known ID, e.g., when restoring saved store
+    @throw Err if @b id is not a valid user node ID, if it is already taken,
+    or if an equal node is stored under a different ID
+    @details If @b id belonged to an erased node, it is no longer reused for
+    new nodes. IDs skipped below @b id are used for subsequently inserted nodes.
+   */
+   void insert(const Node_id id, std::auto_ptr<Node> np) {
+      if( id < detail::min_node_id() ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid node ID")
+               << Err::int1_t(id())
+      );
+      if( find(id) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("node ID is reserved")
+               << Err::int1_t(id())
+      );
+      if( Node_id const* id0 = find(*np) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("node already exists")
+               << Err::node_id_t(*id0)
+               << Err::str1_t(to_string(*np))
+      );
+      place(id, stores_.insert(*np));
+      index_.insert(hash(*np), id);
+   }
+
+   /**@brief append node with known ID, e.g., when restoring saved store
+    from an array of nodes ordered by ID
+    @throw Err if @b id is not greater than IDs of all stored nodes
+    @details Unlike insert(const Node_id, std::auto_ptr<Node>), the node is
+    not looked up, so the caller is responsible for not appending equal nodes.
+    IDs skipped between appended nodes are used for subsequently inserted nodes.
+   */
+   void append(const Node_id id, Node const& node) {
+      if( id < nid(vid_.size()) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("node ID is out of order")
+               << Err::int1_t(id())
+      );
+      place(id, stores_.insert(node));
+      index_.insert(hash(node), id);
+   }
+
+   /**@brief reserve space for nodes with IDs below @b id */
+   void reserve(const Node_id id) {
+      if( id <= detail::min_node_id() ) return;
+      vid_.reserve(vpos(id));
+      index_.reserve(vpos(id));
+   }
+
    std::auto_ptr<Node> remove(const Node_id id) {
       BOOST_ASSERT(find(id));
-      const std::size_t n = map_.erase(&get(id));
-      boost::ignore_unused_variable_warning(n);
-      BOOST_ASSERT(n);
+      ptr_t p(get(id).clone());
+      erase(id);
+      return p;
+   }
 
-      erased_.push_back(id);
-      return ptr_t( vid_.replace(vpos(id), 0).release() );
+   /**@brief remove node without returning its copy */
+   void erase(const Node_id id) {
+      BOOST_ASSERT(find(id));
+      Node const& node = get(id);
+      index_.erase(hash(node), id);
+      stores_.remove(node);
+      vid_[vpos(id)] = 0;
+      push_erased(vpos(id));
    }
 
    void clear() {
       erased_.clear();
-      map_.clear();
+      listed_.clear();
+      index_.clear();
       vid_.clear();
+      stores_.clear();
    }
 
 private:
    vector_t vid_;
-   map_t map_;
+   detail::Node_stores stores_;
+   detail::Node_hash_index index_;
+   /** free IDs below the largest ID; entries that were taken by
+   insert(const Node_id, std::auto_ptr<Node>) are skipped when popped */
    std::vector<Node_id> erased_;
+   std::vector<bool> listed_; ///< true for positions listed in erased_
+
+   static std::size_t hash(Node const& node) {return boost::hash<Node>()(node);}
+
+   static Node_id string_dt() {
+      return detail::Datatype_string::default_datatype::id();
+   }
 
    std::size_t vpos(const Node_id id) const {
       BOOST_ASSERT(id >= detail::min_node_id());
@@ -220,43 +352,66 @@ private:
 
    Node_id nid(const std::size_t n) const {return Node_id(n + detail::min_node_id()());}
 
-   Node const& get(const Node_id id) const {return vid_[vpos(id)];}
-
-   void check_insert(const Node_id id, ptr_t np) {
-      Node_id const* id0 = find(*np);
-      if( id0 ) {
-         if( *id0 == id ) return;
-         BOOST_THROW_EXCEPTION(
-                  Err()
-                  << Err::msg_t("node already exists")
-                  << Err::node_id_t(*id0)
-                  << Err::str1_t(to_string(*np))
-         );
-      }
-      if( find(id) ) BOOST_THROW_EXCEPTION(
-               Err()
-               << Err::msg_t("node ID is reserved")
-               << Err::int1_t(id())
+   Node const& get(const Node_id id) const {return *vid_[vpos(id)];}
+
+   /** assign ID to newly stored node; @b h is its hash value */
+   Node_id insert_new(const std::size_t h, Node const* np) {
+      //make new ID
+      const std::size_t n = pop_erased();
+      if( n == vid_.size() ) vid_.push_back(np);
+      else vid_[n] = np;
+      const Node_id id = nid(n);
+      index_.insert(h, id);
+      return id;
+   }
+
+   Node_id const* find_string(detail::Node_string_ref const& ref) const {
+      return index_.find(
+               detail::Node_string_ref_hash()(ref),
+               equal_string_t(*this, ref)
       );
-      insert(id, np.release());
    }
 
-   void insert(const Node_id id, Node* np) {
+   Node_id insert_string(detail::Node_string_ref const& ref) {
+      const std::size_t h = detail::Node_string_ref_hash()(ref);
+      if( Node_id const* id = index_.find(h, equal_string_t(*this, ref)) ) return *id;
+      return insert_new(h, stores_.insert_string(ref.val_, ref.dt_, ref.lang_));
+   }
+
+   /** store node under given ID; skipped IDs are listed as erased */
+   void place(const Node_id id, Node const* np) {
       const std::size_t n = vpos(id);
-      if( n < vid_.size() ) {
-         vid_.replace(n, np);
-      } else {
-         vid_.reserve(n);
-         for( ; vid_.size() < n; vid_.push_back(0));
-         vid_.push_back(np);
+      while( vid_.size() < n ) {
+         push_erased(vid_.size());
+         vid_.push_back(0);
+      }
+      if( n == vid_.size() ) vid_.push_back(np);
+      else vid_[n] = np;
+   }
+
+   void push_erased(const std::size_t n) {
+      if( listed_.size() <= n ) listed_.resize(n + 1, false);
+      if( listed_[n] ) return;
+      erased_.push_back(nid(n));
+      listed_[n] = true;
+   }
+
+   /** @return position of a free ID or vid_.size() */
+   std::size_t pop_erased() {
+      while( ! erased_.empty() ) {
+         const std::size_t n = vpos(erased_.back());
+         erased_.pop_back();
+         listed_[n] = false;
+         if( ! vid_[n] ) return n;
       }
-      map_.emplace(np, id);
+      return vid_.size();
    }
 
+   /** copy nodes; node IDs and index are copied separately */
    void copy(Map_node const& mn) {
-      BOOST_FOREACH(map_element_t const& p, mn.map_) {
-         Node* np = p.first->clone();
-         insert(p.second, np);
+      BOOST_ASSERT(vid_.size() == mn.vid_.size());
+      for( std::size_t n = 0; n != vid_.size(); ++n ) {
+         if( mn.vid_[n] ) vid_[n] = stores_.insert(*mn.vid_[n]);
       }
    }
 
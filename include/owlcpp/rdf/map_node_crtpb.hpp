@@ -6,6 +6,7 @@ part of owlcpp project.
 #ifndef MAP_NODE_CRTPB_HPP_
 #define MAP_NODE_CRTPB_HPP_
 
+#include "boost/utility/string_ref.hpp"
 #include "owlcpp/detail/map_traits.hpp"
 
 namespace owlcpp{
@@ -46,7 +47,7 @@ public:
     @param name fragment name
     @return node ID
    */
-   Node_id insert_node_iri(const Ns_id nsid, std::string const& name) {
+   Node_id insert_node_iri(const Ns_id nsid, boost::string_ref const& name) {
       BOOST_ASSERT(
                static_cast<Super const&>(*this).find(nsid) &&
                "invalid namespace ID"
@@ -56,13 +57,13 @@ public:
          BOOST_THROW_EXCEPTION(
                   Err()
                   << typename Err::msg_t("blank namespace for IRI node")
-                  << typename Err::str1_t(name)
+                  << typename Err::str1_t(name.to_string())
          );
       }
       return _map_node().insert_iri(nsid, name);
    }
 
-   Node_id const* find_node_iri(const Ns_id nsid, std::string const& name) const {
+   Node_id const* find_node_iri(const Ns_id nsid, boost::string_ref const& name) const {
       BOOST_ASSERT(
                static_cast<Super const&>(*this).find(nsid) &&
                "invalid namespace ID"
@@ -11,6 +11,7 @@ part of owlcpp project.
 #include "boost/foreach.hpp"
 #include "boost/unordered_map.hpp"
 #include "boost/concept_check.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/rdf/node_iri.hpp"
 #include "owlcpp/node_id.hpp"
@@ -53,12 +54,17 @@ public:
    Node_iri const* find(const Node_id id) const {return map_.find(id);}
    Node_id const* find(Node_iri const& node) const {return map_.find(node);}
 
-   Node_id const* find_iri(const Ns_id ns, std::string const& val) const {
-      return map_.find(Node_iri(ns,val));
+   Node_id const* find_iri(const Ns_id ns, boost::string_ref const& val) const {
+      return map_.find(
+               detail::Node_iri_ref(ns, val),
+               detail::Node_iri_ref_hash(),
+               detail::Node_iri_ref_equal()
+      );
    }
 
-   Node_id insert_iri(const Ns_id ns, std::string const& val) {
-      return map_.insert(Node_iri(ns, val));
+   Node_id insert_iri(const Ns_id ns, boost::string_ref const& val) {
+      if( Node_id const* id = find_iri(ns, val) ) return *id;
+      return map_.insert(Node_iri(ns, val.to_string()));
    }
 
    Node_id insert(Node_iri const& node) {return map_.insert(node);}
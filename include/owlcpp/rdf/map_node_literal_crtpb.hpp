@@ -7,6 +7,7 @@ part of owlcpp project.
 #define MAP_NODE_LITERAL_CRTPB_HPP_
 #include "boost/assert.hpp"
 #include "boost/foreach.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/detail/map_traits.hpp"
 #include "owlcpp/rdf/store_concepts.hpp"
@@ -36,9 +37,9 @@ public:
     @param lang language
     */
    Node_id const* find_literal(
-            std::string const& value,
-            std::string const& dt_iri,
-            std::string const& lang = ""
+            boost::string_ref const& value,
+            boost::string_ref const& dt_iri,
+            boost::string_ref const& lang = ""
    ) const {
       Node_id const* dt = static_cast<Super const&>(*this).find_node_iri(dt_iri);
       if( ! dt ) return 0;
@@ -57,9 +58,9 @@ public:
     @return node ID
    */
    Node_id insert_literal(
-            std::string const& value,
+            boost::string_ref const& value,
             const Node_id dt_id,
-            std::string const& lang = ""
+            boost::string_ref const& lang = ""
    ) {
       BOOST_CONCEPT_ASSERT((Iri_node_store<Super>));
       BOOST_ASSERT(
@@ -80,9 +81,9 @@ public:
     @return node ID
    */
    Node_id insert_literal(
-            std::string const& value,
-            std::string const& dt_iri,
-            std::string const& lang = ""
+            boost::string_ref const& value,
+            boost::string_ref const& dt_iri,
+            boost::string_ref const& lang = ""
    ) {
       BOOST_CONCEPT_ASSERT((Ns_iri_node_store<Super>));
       const Node_id dt_id = static_cast<Super&>(*this).insert_node_iri(dt_iri);
@@ -54,10 +54,21 @@ public:
     @return pointer to namespace IRI ID or NULL if iri is unknown
    */
    Ns_id const* find(Ns_iri const& iri) const {return iri_.find(iri);}
-   Ns_id const* find(std::string const& iri) const {return iri_.find(Ns_iri(iri));}
+   Ns_id const* find(boost::string_ref const& iri) const {
+      return iri_.find(iri, detail::Ns_iri_ref_hash(), detail::Ns_iri_ref_equal());
+   }
 
    Ns_id insert(Ns_iri const& iri) {return iri_.insert(iri);}
-   Ns_id insert(std::string const& iri) {return insert(Ns_iri(iri));}
+
+   Ns_id insert(boost::string_ref const& iri) {
+      if( Ns_id const* id = find(iri) ) return *id;
+      return insert(Ns_iri(iri.data(), iri.size()));
+   }
+
+   /**@brief insert namespace IRI with known ID, e.g., when restoring saved store
+    @throw Rdf_err if @b id is invalid or taken or if @b iri has different ID
+   */
+   void insert(const Ns_id id, Ns_iri const& iri) {iri_.insert(id, iri);}
 
    void set_prefix(const Ns_id id, std::string const& pref = "") {
       if( ! find(id) ) BOOST_THROW_EXCEPTION(
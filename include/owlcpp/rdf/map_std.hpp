@@ -77,6 +77,10 @@ public:
    }
 
    Ns_id const* find(Ns_iri const& iri) const {return map_ns_.find(iri);}
+
+   Ns_id const* find(boost::string_ref const& iri) const {
+      return map_ns_.find(iri, detail::Ns_iri_ref_hash(), detail::Ns_iri_ref_equal());
+   }
    Ns_id const* find_prefix(std::string const& pref) const {return map_pref_.find(pref);}
    Ns_iri const& operator[](const Ns_id nsid) const {return map_ns_[nsid];}
    Ns_iri const& at(const Ns_id nsid) const {return map_ns_.at(nsid);}
@@ -88,9 +92,13 @@ public:
    Node_iri const* find(const Node_id nid) const {return map_node_.find(nid);}
    Node_id const* find(Node_iri const& node) const {return map_node_.find(node);}
 
-   Node_id const* find(const Ns_id ns, std::string const& val) const {
+   Node_id const* find(const Ns_id ns, boost::string_ref const& val) const {
       if( is_blank(ns) || ns >= detail::min_ns_id() ) return 0;
-      return map_node_.find(Node_iri(ns, val));
+      return map_node_.find(
+               detail::Node_iri_ref(ns, val),
+               detail::Node_iri_ref_hash(),
+               detail::Node_iri_ref_equal()
+      );
    }
 
 private:
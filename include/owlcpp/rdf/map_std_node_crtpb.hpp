@@ -7,6 +7,7 @@ part of owlcpp project.
 #define MAP_STD_NODE_CRTPB_HPP_
 #include "boost/assert.hpp"
 #include "boost/concept/assert.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/detail/map_traits.hpp"
 #include "owlcpp/terms/detail/max_standard_id.hpp"
@@ -63,7 +64,7 @@ public:
                ;
    }
 
-   Node_id const* find_node_iri(const Ns_id nsid, std::string const& name) const {
+   Node_id const* find_node_iri(const Ns_id nsid, boost::string_ref const& name) const {
       BOOST_ASSERT(
                static_cast<Super const&>(*this).find(nsid) &&
                "invalid namespace ID"
@@ -77,7 +78,7 @@ public:
     @param name fragment name
     @return node ID
    */
-   Node_id insert_node_iri(const Ns_id nsid, std::string const& name) {
+   Node_id insert_node_iri(const Ns_id nsid, boost::string_ref const& name) {
       BOOST_ASSERT(
                static_cast<Super const&>(*this).find(nsid) &&
                "invalid namespace ID"
@@ -87,7 +88,7 @@ public:
          BOOST_THROW_EXCEPTION(
                   Err()
                   << typename Err::msg_t("blank namespace for IRI node")
-                  << typename Err::str1_t(name)
+                  << typename Err::str1_t(name.to_string())
          );
       }
       if( Node_id const*const nid = _map_std().find(nsid, name) ) return *nid;
@@ -96,7 +97,7 @@ public:
          BOOST_THROW_EXCEPTION(
                   Err()
                   << typename Err::msg_t("unknown term in standard namespace")
-                  << typename Err::str1_t( name )
+                  << typename Err::str1_t( name.to_string() )
                   << typename Err::str2_t( _map_std().at(nsid).str() )
          );
       }
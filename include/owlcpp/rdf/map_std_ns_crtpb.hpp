@@ -6,6 +6,7 @@ part of owlcpp project.
 #ifndef MAP_STD_NS_CRTPB_HPP_
 #define MAP_STD_NS_CRTPB_HPP_
 #include "boost/assert.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/detail/map_traits.hpp"
 #include "owlcpp/rdf/store_concepts.hpp"
@@ -69,6 +70,15 @@ public:
       return _map_ns().find(iri);
    }
 
+   /**
+    @param iri namespace IRI string
+    @return pointer to namespace IRI ID or NULL if iri is unknown
+   */
+   Ns_id const* find(boost::string_ref const& iri) const {
+      if( Ns_id const*const id = _map_std().find(iri) ) return id;
+      return _map_ns().find(iri);
+   }
+
    /**
     @param pref prefix for namespace IRI
     @return pointer to namespace IRI ID or NULL if prefix is unknown
@@ -83,6 +93,12 @@ public:
       return _map_ns().insert(iri);
    }
 
+   /**@brief insert namespace IRI; Ns_iri object is only created if IRI is new */
+   Ns_id insert(boost::string_ref const& iri) {
+      if( Ns_id const*const iid = find(iri) ) return *iid;
+      return _map_ns().insert(Ns_iri(iri.data(), iri.size()));
+   }
+
    /**
     @param nsid namespace IRI ID
     @param pref namespace IRI prefix
@@ -5,17 +5,28 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef MAP_TRIPLE_HPP_
 #define MAP_TRIPLE_HPP_
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "boost/fusion/algorithm/iteration/for_each.hpp"
 #include "boost/fusion/container/vector.hpp"
 #include "boost/fusion/include/mpl.hpp"
 #include "boost/fusion/sequence/intrinsic/at.hpp"
 #include "boost/fusion/sequence/intrinsic/front.hpp"
+#include "boost/fusion/sequence/intrinsic/size.hpp"
 #include "boost/fusion/sequence/intrinsic/value_at.hpp"
 #include "boost/mpl/fold.hpp"
 #include "boost/mpl/front.hpp"
 #include "boost/mpl/push_back.hpp"
+#include "boost/range/adaptor/filtered.hpp"
+#include "boost/range/any_range.hpp"
+#include "boost/range/begin.hpp"
+#include "boost/range/empty.hpp"
+#include "boost/range/end.hpp"
 
+#include "owlcpp/detail/parallel_sort.hpp"
 #include "owlcpp/rdf/detail/triple_index_map_impl.hpp"
+#include "owlcpp/rdf/detail/triple_index_packed_impl.hpp"
 #include "owlcpp/rdf/detail/triple_index_selector.hpp"
 #include "owlcpp/rdf/detail/triple_index_vector_impl.hpp"
 #include "owlcpp/rdf/detail/triple_index.hpp"
@@ -24,6 +35,11 @@ part of owlcpp project.
 namespace owlcpp{
 
 /**@brief Store, index, and search RDF triples
+@details Triples of a document are found with an index that leads with
+the document ID, if one is configured, e.g.,
+@code ((Doc) (Subj) (Pred) (Obj)) @endcode in OWLCPP_TRIPLE_INDICES.
+Such index is required for erasing all triples of a document in time
+proportional to the size of the document; otherwise another index is scanned.
 *******************************************************************************/
 template<class Config, bool> class Map_triple {
    typedef typename boost::mpl::fold<
@@ -55,18 +71,133 @@ public:
       if( inserted ) ++size_;
    }
 
-   void erase(Triple const& t) {
+   /**@brief minimal batch size for building indices concurrently */
+   static std::size_t parallel_batch_min() {return 1 << 16;}
+
+   /**@brief Insert a range of triples
+    @param first,last range of triples
+    @param n_threads maximal number of threads; 0 selects the number of
+    hardware threads
+    @details The triples are sorted once for each index and merged into
+    the index fragments, which is much faster than inserting them one by one
+    when many triples share same leading element.
+    Batches of at least parallel_batch_min() triples are inserted into all
+    indices concurrently; indices in SPOD order share the sorted batch,
+    others sort their own copy, and each index merges the batch into
+    its fragments using several threads.
+    @n Threads are run by the rdf library; see detail::run_parallel().
+   */
+   template<class Iter> void insert(
+            const Iter first,
+            const Iter last,
+            const unsigned n_threads = 0
+   ) {
+      std::vector<Triple> v;
+      for( Iter i = first; i != last; ++i ) {
+         if( ! contains(*i) ) v.push_back(*i);
+      }
+      const unsigned nt = v.size() < parallel_batch_min() ? 1 : n_threads;
+      detail::parallel_sort(v.begin(), v.end(), std::less<Triple>(), nt);
+      v.erase(std::unique(v.begin(), v.end()), v.end());
+      if( nt == 1 ) {
+         std::size_t inserted = 0;
+         map_triple_detail::Insert_batch insert(v, inserted);
+         boost::fusion::for_each(store_, insert);
+         BOOST_ASSERT(inserted == v.size());
+      } else {
+         map_triple_detail::Insert_batch_parallel ibp(v);
+         boost::fusion::for_each(store_, map_triple_detail::Insert_batch_parallel::Add(ibp));
+         const std::vector<std::size_t> n = ibp.run(nt);
+         BOOST_ASSERT(
+                  std::count(n.begin(), n.end(), v.size()) ==
+                  static_cast<std::ptrdiff_t>(n.size())
+         );
+      }
+      size_ += v.size();
+   }
+
+   /**@brief Insert unique triples sorted by Triple::operator<(),
+    e.g., when restoring saved store
+    @param v triples in strictly increasing SPOD order
+    @param n_threads maximal number of threads; 0 selects the number of
+    hardware threads
+    @throw Rdf_err if triples are not in strictly increasing order
+    @details Unlike insert(first, last), triples are not looked up and
+    the batch is not sorted again; indices in SPOD order merge it directly,
+    other indices sort their own copy.
+   */
+   void insert_sorted(
+            std::vector<Triple> const& v,
+            const unsigned n_threads = 0
+   ) {
+      check_sorted(v);
+      const unsigned nt = v.size() < parallel_batch_min() ? 1 : n_threads;
+      map_triple_detail::Insert_batch_parallel ibp(v);
+      boost::fusion::for_each(store_, map_triple_detail::Insert_batch_parallel::Add(ibp));
+      const std::vector<std::size_t> n = ibp.run(nt);
+      BOOST_ASSERT(
+               std::count(n.begin(), n.end(), n.front()) ==
+               static_cast<std::ptrdiff_t>(n.size())
+      );
+      size_ += n.front();
+   }
+
+   bool contains(Triple const& t) const {
+      return ! boost::empty(
+               boost::fusion::front(store_).find(t.subj_, t.pred_, t.obj_, t.doc_)
+      );
+   }
+
+   /**@brief Erase triple
+    @throw Rdf_err if triple is not stored
+    @details @b t0 may refer to a triple stored in the map.
+   */
+   void erase(Triple const& t0) {
+      const Triple t = t0;
+      if( ! contains(t) ) BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("triple not found")
+               << Rdf_err::str1_t(to_string(t))
+      );
       map_triple_detail::Erase erase(t);
       boost::fusion::for_each(store_, erase);
       --size_;
    }
 
+   /**@brief Erase all triples of a document
+    @return number of erased triples
+    @details Each index fragment that contains triples of the document
+    is compacted once.
+    Time does not depend on the size of other documents if an index leading
+    with document ID is configured, as in the default configuration.
+   */
+   std::size_t erase_doc(const Doc_id did) {
+      const doc_range r = doc_triples(did);
+      std::vector<Triple> v(boost::begin(r), boost::end(r));
+      if( v.empty() ) return 0;
+      map_triple_detail::Erase_batch erase(v);
+      boost::fusion::for_each(store_, erase);
+      size_ -= v.size();
+      return v.size();
+   }
+
    void clear() {
       map_triple_detail::Clear clear;
       boost::fusion::for_each(store_, clear);
       size_ = 0;
    }
 
+   /**@brief Compact storage after loading triples
+    @details Fragments of vector-based indices are moved into a single
+    contiguous array per index; other storage is shrunk to fit.
+    Ranges returned by find() are invalidated.
+    Indices are thawed automatically by the next modification.
+   */
+   void freeze() {
+      map_triple_detail::Freeze freeze;
+      boost::fusion::for_each(store_, freeze);
+   }
+
    /**
 
    */
@@ -89,6 +220,15 @@ public:
      >
    {};
 
+   typedef typename query<Any,Any,Any,Doc_id>::range doc_range;
+
+   /**@return range of triples of document @b did
+    @details Same as <tt>find(any, any, any, did)</tt>
+   */
+   doc_range doc_triples(const Doc_id did) const {
+      return find(any, any, any, did);
+   }
+
    /**@brief Search triples by subject, predicate, object, or document IDs.
     @details Polymorphically search stored triples to find ones that match
     specified node IDs for subject, predicate, or object nodes or document ID.
@@ -122,17 +262,91 @@ public:
       return boost::fusion::at<index_pos>(store_).find(subj, pred, obj, doc);
    }
 
+   /**@return number of triples searched by find() for the query,
+    or query_cost_all() if all index fragments are searched
+   */
+   template<class Subj, class Pred, class Obj, class Doc> std::size_t
+   cost(const Subj subj, const Pred pred, const Obj obj, const Doc doc) const {
+      typedef typename query<Subj,Pred,Obj,Doc>::index_pos index_pos;
+      return boost::fusion::at<index_pos>(store_).cost(subj, pred, obj, doc);
+   }
+
+   /**@brief type-erased range of triples returned by find_planned() */
+   typedef boost::any_range<
+            Triple, boost::single_pass_traversal_tag, Triple, std::ptrdiff_t
+            > any_range;
+
+   /**@return position of the index searched by find_planned()
+    @details The index selected at compile time by find() is used unless
+    another index searches fewer triples for this query, e.g., when
+    the leading element of the selected index is a hub with many triples
+    while another index leads with a rare element.
+    The cost of each index is the size of the fragment it searches;
+    it takes constant or logarithmic time to obtain.
+   */
+   template<class Subj, class Pred, class Obj, class Doc> std::size_t
+   plan(const Subj subj, const Pred pred, const Obj obj, const Doc doc) const {
+      std::vector<std::size_t> v;
+      v.reserve(boost::fusion::result_of::size<store>::value);
+      boost::fusion::for_each(
+               store_,
+               map_triple_detail::Query_cost<Subj,Pred,Obj,Doc>(subj, pred, obj, doc, v)
+      );
+      std::size_t best = query<Subj,Pred,Obj,Doc>::index_pos::value;
+      for( std::size_t n = 0; n != v.size(); ++n ) {
+         if( v[n] < v[best] ) best = n;
+      }
+      return best;
+   }
+
+   /**@brief Search triples using the index chosen at run time by plan()
+    @details Same triples are found as by find(), but through a type-erased
+    range, so that its type does not depend on the chosen index.
+    Iterating over the range is slower than over the range returned by find();
+    the planned search pays off when it avoids scanning large fragments.
+   */
+   template<class Subj, class Pred, class Obj, class Doc> any_range
+   find_planned(const Subj subj, const Pred pred, const Obj obj, const Doc doc) const {
+      any_range r;
+      std::size_t n = 0;
+      boost::fusion::for_each(
+               store_,
+               map_triple_detail::Find_at<any_range,Subj,Pred,Obj,Doc>(
+                        subj, pred, obj, doc, plan(subj, pred, obj, doc), n, r
+               )
+      );
+      return r;
+   }
+
 private:
    store store_;
    std::size_t size_;
+
+   static void check_sorted(std::vector<Triple> const& v) {
+      const std::vector<Triple>::const_iterator i = std::adjacent_find(
+               v.begin(), v.end(), std::not2(std::less<Triple>())
+      );
+      if( i != v.end() ) BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("triples are not sorted")
+               << Rdf_err::str1_t(to_string(*i))
+      );
+   }
 };
 
 /**@brief Store, index, and search RDF triples
 *******************************************************************************/
 template<class Config> class Map_triple<Config, true> {
    typedef std::vector<Triple> store_t;
+
+   struct Same_doc {
+      explicit Same_doc(const Doc_id did) : did_(did) {}
+      bool operator()(Triple const& t) const {return t.doc_ == did_;}
+      Doc_id did_;
+   };
 public:
    typedef store_t::const_iterator const_iterator;
+   typedef boost::filtered_range<Same_doc, const store_t> doc_range;
 
    std::size_t size() const {return v_.size();}
    bool empty() const {return v_.empty();}
@@ -141,12 +355,45 @@ public:
 
    void insert(Triple const& t) {v_.push_back(t);}
 
+   template<class Iter> void insert(const Iter first, const Iter last) {
+      v_.insert(v_.end(), first, last);
+   }
+
+   void insert_sorted(std::vector<Triple> const& v, const unsigned = 0) {
+      v_.insert(v_.end(), v.begin(), v.end());
+   }
+
    void erase(Triple const& t) {
-      v_.erase(find(v_.begin(), v_.end(), t));
+      const store_t::iterator i = std::find(v_.begin(), v_.end(), t);
+      if( i == v_.end() ) BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("triple not found")
+               << Rdf_err::str1_t(to_string(t))
+      );
+      v_.erase(i);
+   }
+
+   /**@brief Erase all triples of a document
+    @return number of erased triples
+   */
+   std::size_t erase_doc(const Doc_id did) {
+      const std::size_t n = v_.size();
+      v_.erase(std::remove_if(v_.begin(), v_.end(), Same_doc(did)), v_.end());
+      return n - v_.size();
+   }
+
+   /**@return range of triples of document @b did */
+   doc_range doc_triples(const Doc_id did) const {
+      return doc_range(Same_doc(did), v_);
    }
 
    void clear() {v_.clear();}
 
+   /**@brief Release unused capacity */
+   void freeze() {
+      if( v_.capacity() != v_.size() ) store_t(v_).swap(v_);
+   }
+
 private:
    store_t v_;
 };
@@ -5,31 +5,55 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef MAP_TRIPLE_CONFIG_HPP_
 #define MAP_TRIPLE_CONFIG_HPP_
-#include "boost/mpl/vector.hpp"
+#include "boost/mpl/assert.hpp"
 #include "boost/mpl/at.hpp"
+#include "boost/mpl/size.hpp"
+#include "boost/mpl/vector.hpp"
+#include "boost/type_traits/is_same.hpp"
 
 #include "owlcpp/rdf/detail/map_triple_config_macro.hpp"
 #include "owlcpp/rdf/detail/triple_index_fwd.hpp"
 #include "owlcpp/rdf/triple_tags.hpp"
 
+/* Document-leading index makes finding and erasing triples of a document
+independent of the size of other documents */
 #ifndef OWLCPP_TRIPLE_INDICES
 #define OWLCPP_TRIPLE_INDICES \
          ((Subj) (Pred) (Obj) (Doc)) \
          ((Obj) (Pred) (Subj) (Doc)) \
+         ((Doc) (Subj) (Pred) (Obj)) \
 /*
 */
 #endif
 
-namespace owlcpp{ namespace map_triple_detail{
+namespace owlcpp{
+
+/**@brief Optional fifth element of triple index configuration requesting
+that fragments of the frozen index are delta-encoded
+@details e.g., @code mpl::vector5<Obj_tag,Pred_tag,Subj_tag,Doc_tag,Packed_tag>
+@endcode or @code ((Obj) (Pred) (Subj) (Doc) (Packed)) @endcode in
+OWLCPP_TRIPLE_INDEX_CONFIG.
+Search results of packed indices return triples by value.
+*******************************************************************************/
+struct Packed_tag {};
+
+namespace map_triple_detail{
 
 /**@brief
 *******************************************************************************/
 template<class,class,class,class> class Triple_index_vector_impl;
 template<class,class,class,class> class Triple_index_map_impl;
+template<class,class,class,class> class Triple_index_packed_impl;
 
 typedef OWLCPP_TRIPLE_INDEX_CONFIG(OWLCPP_TRIPLE_INDICES)
 index_config_default;
 
+typedef OWLCPP_TRIPLE_INDEX_CONFIG(
+         ((Subj) (Pred) (Obj) (Doc) (Packed))
+         ((Obj) (Pred) (Subj) (Doc) (Packed))
+)
+index_config_packed;
+
 typedef OWLCPP_TRIPLE_INDEX_CONFIG()
 config_unindexed;
 
@@ -53,7 +77,7 @@ struct Triple_index_selector2<Pred_tag,Tag1,Tag2,Tag3> {
 
 /**@brief
 *******************************************************************************/
-template<class Config> struct Triple_index_selector
+template<class Config, bool Packed> struct Triple_index_selector3
          : public Triple_index_selector2<
               typename boost::mpl::at_c<Config,0>::type,
               typename boost::mpl::at_c<Config,1>::type,
@@ -62,6 +86,29 @@ template<class Config> struct Triple_index_selector
            >
 {};
 
+template<class Config> struct Triple_index_selector3<Config, true> {
+   BOOST_MPL_ASSERT((
+            boost::is_same<typename boost::mpl::at_c<Config,4>::type, Packed_tag>
+   ));
+
+   typedef Triple_index<
+            Triple_index_packed_impl,
+            typename boost::mpl::at_c<Config,0>::type,
+            typename boost::mpl::at_c<Config,1>::type,
+            typename boost::mpl::at_c<Config,2>::type,
+            typename boost::mpl::at_c<Config,3>::type
+            > type;
+};
+
+/**@brief
+*******************************************************************************/
+template<class Config> struct Triple_index_selector
+         : public Triple_index_selector3<
+              Config,
+              boost::mpl::size<Config>::value == 5
+           >
+{};
+
 }//namespace map_triple_detail
 }//namespace owlcpp
 #endif /* MAP_TRIPLE_CONFIG_HPP_ */
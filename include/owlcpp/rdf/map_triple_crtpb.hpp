@@ -103,10 +103,25 @@ public:
       _map_triple().insert(t);
    }
 
+   /**@brief Insert a range of triples
+    @details Faster than inserting triples one by one, especially for
+    large ranges.
+   */
+   template<class Iter> void insert(const Iter first, const Iter last) {
+      BOOST_CONCEPT_ASSERT((Node_store<Super>));
+      _map_triple().insert(first, last);
+   }
+
    void erase(Triple const& t) {
       _map_triple().erase(t);
    }
 
+   /**@brief Compact triple indices after loading
+    @details Previously returned triple ranges are invalidated;
+    see Map_triple::freeze().
+   */
+   void freeze_triples() {_map_triple().freeze();}
+
 };
 
 }//namespace owlcpp
@@ -0,0 +1,264 @@
+/** @file "/owlcpp/include/owlcpp/rdf/map_triple_dynamic.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef MAP_TRIPLE_DYNAMIC_HPP_
+#define MAP_TRIPLE_DYNAMIC_HPP_
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "boost/foreach.hpp"
+#include "boost/ptr_container/ptr_vector.hpp"
+
+#include "owlcpp/detail/parallel_for.hpp"
+#include "owlcpp/rdf/detail/triple_index_dynamic.hpp"
+#include "owlcpp/rdf/exception.hpp"
+#include "owlcpp/rdf/triple_permutation.hpp"
+
+namespace owlcpp{
+
+/**@brief Store, index, and search RDF triples using triple indices selected
+at run time
+@details Unlike Map_triple, whose indices are fixed at compile time,
+each instance keeps its own set of index permutations, which can be
+extended or reduced after construction.
+A query is answered by the index that searches the fewest stored triples
+after looking up the specified elements that lead its permutation;
+if no index starts with a specified element, all triples are scanned.
+All queries return ranges of the same type.
+@n Index permutations are specified as strings, e.g., "SPOD" or "POS";
+see Triple_permutation.
+*******************************************************************************/
+class Map_triple_dynamic {
+   typedef map_triple_detail::Triple_index_dynamic index_type;
+   typedef boost::ptr_vector<index_type> store_t;
+
+   /** Insert same batch into several indices concurrently */
+   class Insert_batches {
+   public:
+      Insert_batches(store_t& s, std::vector<Triple> const& v)
+      : s_(s), v_(v) {}
+
+      void operator()(const std::size_t i) {
+         std::vector<Triple> v(v_);
+         s_[i].insert_batch(v);
+      }
+
+   private:
+      store_t& s_;
+      std::vector<Triple> const& v_;
+   };
+
+public:
+   typedef index_type::iterator iterator;
+   typedef iterator const_iterator;
+   typedef index_type::range range;
+
+   /**@brief minimal batch size for building indices concurrently */
+   static std::size_t parallel_batch_min() {return 1 << 16;}
+
+   /**
+    @param indices permutations of triple indices separated by spaces or
+    commas, e.g., "SPOD OPSD PSOD"
+    @throw Rdf_err if a permutation is invalid or no permutations are given
+   */
+   explicit Map_triple_dynamic(std::string const& indices = "SPOD OPSD")
+   : s_(), size_(0)
+   {
+      std::string p;
+      for( std::size_t n = 0; n <= indices.size(); ++n ) {
+         if( n == indices.size() || indices[n] == ' ' || indices[n] == ',' ) {
+            if( ! p.empty() && ! find_index(Triple_permutation(p)) ) {
+               s_.push_back(new index_type(Triple_permutation(p)));
+            }
+            p.clear();
+         } else {
+            p += indices[n];
+         }
+      }
+      if( s_.empty() ) BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("no triple indices specified")
+               << Rdf_err::str1_t(indices)
+      );
+   }
+
+   std::size_t size() const {return size_;}
+   bool empty() const {return ! size_;}
+   const_iterator begin() const {
+      return s_.front().find(map_triple_detail::Triple_pattern()).begin();
+   }
+
+   const_iterator end() const {return const_iterator();}
+
+   /**@return number of triple indices */
+   std::size_t n_indices() const {return s_.size();}
+
+   /**@return permutation of triple index @b n */
+   Triple_permutation const& permutation(const std::size_t n) const {
+      return s_[n].permutation();
+   }
+
+   bool has_index(Triple_permutation const& p) const {return find_index(p);}
+
+   /**@brief Build new triple index from stored triples
+    @details Nothing is done if such index already exists.
+   */
+   void add_index(Triple_permutation const& p) {
+      if( find_index(p) ) return;
+      std::auto_ptr<index_type> ti(new index_type(p));
+      std::vector<Triple> v(begin(), end());
+      ti->insert_batch(v);
+      s_.push_back(ti.release());
+   }
+
+   /**@brief Remove triple index
+    @throw Rdf_err if the index is the last one
+    @details Nothing is done if there is no such index.
+   */
+   void erase_index(Triple_permutation const& p) {
+      for( store_t::iterator i = s_.begin(); i != s_.end(); ++i ) {
+         if( i->permutation() != p ) continue;
+         if( s_.size() == 1 ) BOOST_THROW_EXCEPTION(
+                  Rdf_err()
+                  << Rdf_err::msg_t("cannot remove the last triple index")
+                  << Rdf_err::str1_t(p.str())
+         );
+         s_.erase(i);
+         return;
+      }
+   }
+
+   void insert(Triple const& t) {
+      if( ! s_.front().insert(t) ) return;
+      for( std::size_t n = 1; n != s_.size(); ++n ) s_[n].insert(t);
+      ++size_;
+   }
+
+   /**@brief Insert a range of triples
+    @param first,last range of triples
+    @param n_threads maximal number of threads; 0 selects the number of
+    hardware threads
+    @details Batches of at least parallel_batch_min() triples are inserted
+    into all indices concurrently.
+   */
+   template<class Iter> void insert(
+            const Iter first,
+            const Iter last,
+            const unsigned n_threads = 0
+   ) {
+      std::vector<Triple> v;
+      for( Iter i = first; i != last; ++i ) {
+         if( ! contains(*i) ) v.push_back(*i);
+      }
+      std::sort(v.begin(), v.end());
+      v.erase(std::unique(v.begin(), v.end()), v.end());
+      const unsigned nt = v.size() < parallel_batch_min() ? 1 : n_threads;
+      Insert_batches ib(s_, v);
+      detail::parallel_for(s_.size(), ib, nt);
+      size_ += v.size();
+   }
+
+   bool contains(Triple const& t) const {return s_.front().contains(t);}
+
+   /**@brief Erase triple
+    @throw Rdf_err if triple is not stored
+   */
+   void erase(Triple const& t0) {
+      const Triple t = t0; //t0 may refer to stored triple
+      BOOST_FOREACH(index_type& ti, s_) ti.erase(t);
+      --size_;
+   }
+
+   /**@brief Erase all triples of a document
+    @return number of erased triples
+    @details Time is proportional to the number of triples in the document
+    if there is an index starting with D; otherwise all triples are scanned.
+   */
+   std::size_t erase_doc(const Doc_id did) {
+      const range r = find(any, any, any, did);
+      std::vector<Triple> v(r.begin(), r.end());
+      BOOST_FOREACH(index_type& ti, s_) {
+         std::vector<Triple> v1(v);
+         ti.erase_batch(v1);
+      }
+      size_ -= v.size();
+      return v.size();
+   }
+
+   void clear() {
+      BOOST_FOREACH(index_type& ti, s_) ti.clear();
+      size_ = 0;
+   }
+
+   /**@brief Search triples by subject, predicate, object, or document IDs.
+    @param subj subject node ID or @b any
+    @param pred predicate node ID or @b any
+    @param obj object node ID or @b any
+    @param doc document ID or @b any
+    @return range of triples matching the query; its type does not depend
+    on the query
+   */
+   template<class Subj, class Pred, class Obj, class Doc>
+   range find(const Subj subj, const Pred pred, const Obj obj, const Doc doc) const {
+      return find(map_triple_detail::Triple_pattern(subj, pred, obj, doc));
+   }
+
+   range find(map_triple_detail::Triple_pattern const& q) const {
+      return select(q).find(q);
+   }
+
+   /**@return permutation of the index used for answering query
+    @b subj, @b pred, @b obj, @b doc */
+   template<class Subj, class Pred, class Obj, class Doc>
+   Triple_permutation const& query_index(
+            const Subj subj, const Pred pred, const Obj obj, const Doc doc
+   ) const {
+      return select(map_triple_detail::Triple_pattern(subj, pred, obj, doc))
+               .permutation();
+   }
+
+private:
+   store_t s_;
+   std::size_t size_;
+
+   index_type const* find_index(Triple_permutation const& p) const {
+      BOOST_FOREACH(index_type const& ti, s_) {
+         if( ti.permutation() == p ) return &ti;
+      }
+      return 0;
+   }
+
+   /**@brief relative diversity of elements in each triple position,
+    same as map_triple_detail::Element_diversity */
+   static int diversity(const unsigned e) {
+      static const int d[4] = {4, 2, 3, 1};
+      return d[e];
+   }
+
+   /* Prefer the index that searches fewest triples, as measured by
+   Triple_index_dynamic::cost(); break ties by the longest specified
+   permutation prefix, then by the most diverse leading element. */
+   index_type const& select(map_triple_detail::Triple_pattern const& q) const {
+      index_type const* best = &s_.front();
+      std::size_t best_cost = std::numeric_limits<std::size_t>::max();
+      int best_score = -1;
+      BOOST_FOREACH(index_type const& ti, s_) {
+         const std::size_t cost = ti.cost(q);
+         const unsigned n = ti.prefix(q);
+         const int score = n ? 8 * n + diversity(ti.permutation()[0]) : 0;
+         if( cost < best_cost || (cost == best_cost && score > best_score) ) {
+            best = &ti;
+            best_cost = cost;
+            best_score = score;
+         }
+      }
+      return *best;
+   }
+};
+
+}//namespace owlcpp
+#endif /* MAP_TRIPLE_DYNAMIC_HPP_ */
@@ -5,17 +5,26 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef NODE_IRI_HPP_
 #define NODE_IRI_HPP_
+#include "boost/assert.hpp"
 #include "boost/functional/hash.hpp"
+#include "boost/utility/string_ref.hpp"
 #include "owlcpp/rdf/node.hpp"
 #include "owlcpp/rdf/exception.hpp"
+#include "owlcpp/rdf/detail/string_pool.hpp"
 #include "owlcpp/terms/ns_iri_tags.hpp"
 #include "owlcpp/rdf/visitor_node.hpp"
 
 namespace owlcpp{
+namespace detail{
+class Node_stores;
+}
 
-/**@brief 
+/**@brief IRI node
+@details Fragment of IRI node stored in Map_node is interned in the node map;
+copies of the node own their fragments.
 *******************************************************************************/
 class Node_iri : public Node {
+   friend class detail::Node_stores;
    friend inline std::size_t hash_value(Node_iri const& node)
    {return node.hash_impl();}
 
@@ -24,19 +33,41 @@ public:
    explicit Node_iri(const Ns_id ns = terms::empty::id(), std::string const& val = "")
    : val_(val), ns_(ns)
    {
-      if( is_blank(ns_) ) BOOST_THROW_EXCEPTION(
-               Rdf_err() << Rdf_err::msg_t("blank \"_\" namespace in IRI node")
-      );
+      check_ns();
+   }
+
+   Node_iri(Node_iri const& node)
+   : Node(node), val_(boost::string_ref(node.val_)), ns_(node.ns_)
+   {}
+
+   Node_iri& operator=(Node_iri const& node) {
+      detail::Pooled_string(boost::string_ref(node.val_)).swap(val_);
+      ns_ = node.ns_;
+      return *this;
    }
 
-   std::string const& fragment() const {return val_;}
+   boost::string_ref fragment() const {return val_;}
+
+   /**@return hash value of IRI node with namespace @b ns and fragment @b val */
+   static std::size_t hash(const Ns_id ns, boost::string_ref const& val) {
+      std::size_t h = 0;
+      boost::hash_combine(h, boost::hash_range(val.begin(), val.end()));
+      boost::hash_combine(h, ns);
+      return h;
+   }
 
 private:
-   std::string val_;
+   detail::Pooled_string val_;
    Ns_id ns_;
 
    OWLCPP_VISITABLE
 
+   void check_ns() const {
+      if( is_blank(ns_) ) BOOST_THROW_EXCEPTION(
+               Rdf_err() << Rdf_err::msg_t("blank \"_\" namespace in IRI node")
+      );
+   }
+
    Ns_id ns_id_impl() const { return ns_; }
 
    bool equal_impl(const Node& n) const {
@@ -47,15 +78,44 @@ private:
       return false;
    }
 
-   std::size_t hash_impl() const {
-      std::size_t h = 0;
-      boost::hash_combine(h, val_);
-      boost::hash_combine(h, ns_);
-      return h;
-   }
+   std::size_t hash_impl() const {return hash(ns_, val_);}
 
    Node* clone_impl() const {return new Node_iri(*this);}
+
+   /** refer to fragment interned in detail::String_pool */
+   void assign(const Ns_id ns, detail::Pooled_string const& val) {
+      BOOST_ASSERT(val.empty() || val.pooled());
+      val_ = val;
+      ns_ = ns;
+   }
+};
+
+namespace detail{
+
+/**@brief Namespace ID and fragment of IRI node;
+used for looking up nodes without constructing temporary Node_iri
+*******************************************************************************/
+struct Node_iri_ref {
+   Node_iri_ref(const Ns_id ns, boost::string_ref const& val) : ns_(ns), val_(val) {}
+   Ns_id ns_;
+   boost::string_ref val_;
+};
+
+struct Node_iri_ref_hash {
+   std::size_t operator()(Node_iri_ref const& r) const {
+      return Node_iri::hash(r.ns_, r.val_);
+   }
+};
+
+struct Node_iri_ref_equal {
+   bool operator()(Node_iri_ref const& r, Node_iri const& node) const {
+      return r.ns_ == node.ns_id() && r.val_ == node.fragment();
+   }
+   bool operator()(Node_iri const& node, Node_iri_ref const& r) const {
+      return (*this)(r, node);
+   }
 };
 
+}//namespace detail
 }//namespace owlcpp
 #endif /* NODE_IRI_HPP_ */
@@ -6,8 +6,10 @@ part of owlcpp project.
 #ifndef NODE_LITERAL_HPP_
 #define NODE_LITERAL_HPP_
 #include <string>
+#include "boost/assert.hpp"
 #include "boost/functional/hash.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/rdf/node.hpp"
 #include "owlcpp/rdf/exception.hpp"
@@ -16,6 +18,7 @@ part of owlcpp project.
 #include "owlcpp/rdf/literal_datatypes.hpp"
 #include "owlcpp/rdf/node_fwd.hpp"
 #include "owlcpp/rdf/visitor_node.hpp"
+#include "owlcpp/rdf/detail/string_pool.hpp"
 
 namespace owlcpp{
 
@@ -33,6 +36,8 @@ private:
 
 namespace detail{
 
+class Node_stores;
+
 /**@brief 
 *******************************************************************************/
 template<class Dt> class Node_literal_impl : public Node_literal {
@@ -112,26 +117,32 @@ private:
 /**@brief
 *******************************************************************************/
 template<> class Node_literal_impl<Datatype_string> : public Node_literal {
+   friend class Node_stores;
    typedef Node_literal_impl self_type;
    typedef Datatype_string::default_datatype default_datatype;
 
-   static std::size_t _hash(std::string const& val, const Node_id dt, std::string const& lang) {
+public:
+   typedef Datatype_string::value_type value_type;
+
+   /**@return hash value of string literal node */
+   static std::size_t hash(
+            boost::string_ref const& val,
+            const Node_id dt,
+            boost::string_ref const& lang
+   ) {
       std::size_t h = 0;
-      boost::hash_combine(h, val);
-      boost::hash_combine(h, lang);
+      boost::hash_combine(h, boost::hash_range(val.begin(), val.end()));
+      boost::hash_combine(h, boost::hash_range(lang.begin(), lang.end()));
       boost::hash_combine(h, dt);
       return h;
    }
 
-public:
-   typedef Datatype_string::value_type value_type;
-
    explicit Node_literal_impl(
             std::string const& val,
             const Node_id dt,
             std::string const& lang = ""
    )
-   : val_(val), lang_(lang), hash_(_hash(val, dt, lang)), dt_(dt)
+   : val_(val), lang_(lang), hash_(hash(val, dt, lang)), dt_(dt)
    {}
 
    explicit Node_literal_impl(
@@ -140,16 +151,32 @@ public:
    )
    : val_(val),
      lang_(lang),
-     hash_(_hash(val, default_datatype::id(), lang)),
+     hash_(hash(val, default_datatype::id(), lang)),
      dt_(default_datatype::id())
    {}
 
-   std::string const& language() const {return lang_;}
-   std::string const& value() const {return val_;}
+   Node_literal_impl(Node_literal_impl const& node)
+   : Node_literal(node),
+     val_(boost::string_ref(node.val_)),
+     lang_(boost::string_ref(node.lang_)),
+     hash_(node.hash_),
+     dt_(node.dt_)
+   {}
+
+   Node_literal_impl& operator=(Node_literal_impl const& node) {
+      Pooled_string(boost::string_ref(node.val_)).swap(val_);
+      Pooled_string(boost::string_ref(node.lang_)).swap(lang_);
+      hash_ = node.hash_;
+      dt_ = node.dt_;
+      return *this;
+   }
+
+   boost::string_ref language() const {return lang_;}
+   boost::string_ref value() const {return val_;}
 
 private:
-   std::string val_;
-   std::string lang_;
+   Pooled_string val_;
+   Pooled_string lang_;
    std::size_t hash_;
    Node_id dt_;
 
@@ -157,7 +184,7 @@ private:
 
    Node_id datatype_impl() const {return dt_;}
 
-   std::string value_str_impl() const {return val_;}
+   std::string value_str_impl() const {return val_.str();}
 
    bool empty_impl() const { return val_.empty() && lang_.empty() && is_empty(dt_); }
 
@@ -172,6 +199,58 @@ private:
    std::size_t hash_impl() const {return hash_;}
 
    Node* clone_impl() const {return new self_type(*this);}
+
+   /** refer to strings interned in String_pool */
+   void assign(Pooled_string const& val, const Node_id dt, Pooled_string const& lang) {
+      BOOST_ASSERT(val.empty() || val.pooled());
+      BOOST_ASSERT(lang.empty() || lang.pooled());
+      val_ = val;
+      lang_ = lang;
+      hash_ = hash(val, dt, lang);
+      dt_ = dt;
+   }
+};
+
+/**@brief Value, datatype, and language of string literal node;
+used for looking up nodes without constructing temporary Node_string
+*******************************************************************************/
+struct Node_string_ref {
+   Node_string_ref(
+            boost::string_ref const& val,
+            const Node_id dt,
+            boost::string_ref const& lang
+   )
+   : val_(val), lang_(lang), dt_(dt)
+   {}
+
+   boost::string_ref val_;
+   boost::string_ref lang_;
+   Node_id dt_;
+};
+
+struct Node_string_ref_hash {
+   std::size_t operator()(Node_string_ref const& r) const {
+      return Node_literal_impl<Datatype_string>::hash(r.val_, r.dt_, r.lang_);
+   }
+};
+
+struct Node_string_ref_equal {
+   bool operator()(
+            Node_string_ref const& r,
+            Node_literal_impl<Datatype_string> const& node
+   ) const {
+      return
+               r.dt_ == node.datatype() &&
+               r.lang_ == node.language() &&
+               r.val_ == node.value()
+               ;
+   }
+   bool operator()(
+            Node_literal_impl<Datatype_string> const& node,
+            Node_string_ref const& r
+   ) const {
+      return (*this)(r, node);
+   }
 };
 
 }//namespace detail
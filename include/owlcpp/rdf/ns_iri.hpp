@@ -8,6 +8,7 @@ part of owlcpp project.
 #include <string>
 #include <iosfwd>
 #include "boost/functional/hash.hpp"
+#include "boost/utility/string_ref.hpp"
 
 namespace owlcpp{
 
@@ -33,7 +34,29 @@ template<class Ch, class Tr> inline std::basic_ostream<Ch,Tr>&
 {return os << ns_iri.str();}
 
 inline std::size_t hash_value(Ns_iri const& n)
-{return boost::hash_value(n.str());}
+{return boost::hash_range(n.str().begin(), n.str().end());}
+
+namespace detail{
+
+/**@brief Hash and equality for looking up Ns_iri by string reference
+without constructing temporary Ns_iri
+*******************************************************************************/
+struct Ns_iri_ref_hash {
+   std::size_t operator()(boost::string_ref const& iri) const {
+      return boost::hash_range(iri.begin(), iri.end());
+   }
+};
+
+struct Ns_iri_ref_equal {
+   bool operator()(boost::string_ref const& iri, Ns_iri const& n) const {
+      return iri == boost::string_ref(n.str());
+   }
+   bool operator()(Ns_iri const& n, boost::string_ref const& iri) const {
+      return iri == boost::string_ref(n.str());
+   }
+};
+
+}//namespace detail
 
 /**@brief remove fragment identifier from the rest of IRI string
  @param[in] iri IRI string
@@ -59,6 +82,24 @@ inline Ns_iri remove_fragment(std::string const& iri) {
    return remove_fragment(iri, n);
 }
 
+/**@brief split IRI into namespace IRI and fragment identifier without copying
+ @param[in] iri IRI string
+ @param[out] frag fragment identifier or empty string if fragment not found
+ @return namespace IRI part, same as remove_fragment(iri).str()
+*/
+inline boost::string_ref split_fragment(
+         boost::string_ref const& iri,
+         boost::string_ref& frag
+) {
+   const std::size_t n = iri.find('#');
+   if( n == boost::string_ref::npos ) {
+      frag = boost::string_ref();
+      return iri;
+   }
+   frag = iri.substr(n + 1);
+   return iri.substr(0, n);
+}
+
 inline std::string add_fragment(Ns_iri const& nsiri, std::string const& frag) {
    return nsiri.str() + '#' + frag;
 }
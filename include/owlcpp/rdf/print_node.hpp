@@ -22,7 +22,7 @@ OWLCPP_RDF_DECL std::string to_string(Node const&);
 /**@return IRI node string with generated namespace prefix
 *******************************************************************************/
 inline std::string to_string(Node_iri const& node) {
-   return to_string(node.ns_id()) + ':' + node.fragment();
+   return to_string(node.ns_id()) + ':' + node.fragment().to_string();
 }
 
 /**@return node string
@@ -62,7 +62,7 @@ OWLCPP_RDF_DECL std::string to_string_full(const Node_id, Triple_store const&);
 template<class Store> inline std::string
 to_string_full(Node_iri const& node, Store const& store) {
    if( node.fragment().empty() ) return store[node.ns_id()].str();
-   return store[node.ns_id()].str() + '#' + node.fragment();
+   return store[node.ns_id()].str() + '#' + node.fragment().to_string();
 }
 
 /**@return IRI node string with namespace prefix, generated, if needed
@@ -80,7 +80,7 @@ to_string_pref(Node_iri const& node, Store const& store) {
    const Ns_id nsid = node.ns_id();
    const std::string pref = store.prefix(nsid);
    if( pref.empty() ) return to_string(node);
-   return pref + ':' + node.fragment();
+   return pref + ':' + node.fragment().to_string();
 }
 
 /**@return IRI node string with complete namespace or prefix (if defined)
@@ -98,7 +98,7 @@ to_string(Node_iri const& node, Store const& store) {
    const Ns_id nsid = node.ns_id();
    const std::string pref = store.prefix(nsid);
    if( pref.empty() ) return to_string_full<Store>(node, store);
-   return pref + ':' + node.fragment();
+   return pref + ':' + node.fragment().to_string();
 }
 
 /**
@@ -116,7 +116,7 @@ public:
    }
 
    void visit_impl(Node_string const& node) {
-      out_ = node.value();
+      out_.assign(node.value().data(), node.value().size());
    }
 };
 }//namespace detail
@@ -23,6 +23,7 @@ typedef boost::any_range<
          > triple_any_range;
 
 /**@brief search triples without using templates
+@details Index is chosen at run time by Map_triple::plan().
 *******************************************************************************/
 OWLCPP_RDF_DECL triple_any_range find_triple(
          Triple_store const& ts,
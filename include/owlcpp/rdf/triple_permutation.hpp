@@ -0,0 +1,100 @@
+/** @file "/owlcpp/include/owlcpp/rdf/triple_permutation.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef TRIPLE_PERMUTATION_HPP_
+#define TRIPLE_PERMUTATION_HPP_
+#include <string>
+
+#include "owlcpp/rdf/exception.hpp"
+#include "owlcpp/rdf/triple.hpp"
+
+namespace owlcpp{
+
+/**@return element @b n of triple: subject 0, predicate 1, object 2,
+or document 3; same numbering as triple tags
+*******************************************************************************/
+inline unsigned triple_element(Triple const& t, const unsigned n) {
+   switch (n) {
+   case 0: return t.subj_();
+   case 1: return t.pred_();
+   case 2: return t.obj_();
+   default: return t.doc_();
+   }
+}
+
+/**@brief Order in which triple elements are indexed
+@details Permutation is specified by a string of letters S, P, O, and D,
+e.g., "POS" or "DSPO".
+Elements that are not specified follow in S, P, O, D order,
+i.e., "POS" is same as "POSD".
+*******************************************************************************/
+class Triple_permutation {
+public:
+   /**@throw Rdf_err if @b s is not a valid permutation */
+   explicit Triple_permutation(std::string const& s = "SPOD") {
+      if( s.size() > 4 ) error(s);
+      bool used[4] = {false, false, false, false};
+      unsigned n = 0;
+      for( ; n != s.size(); ++n ) {
+         const unsigned e = element(s[n]);
+         if( e > 3 || used[e] ) error(s);
+         used[e] = true;
+         p_[n] = e;
+      }
+      for( unsigned e = 0; e != 4; ++e ) if( ! used[e] ) p_[n++] = e;
+   }
+
+   /**@return triple element indexed at position @b n */
+   unsigned operator[](const unsigned n) const {return p_[n];}
+
+   /**@return value of the element of @b t indexed at position @b n */
+   unsigned element(Triple const& t, const unsigned n) const {
+      return triple_element(t, p_[n]);
+   }
+
+   /**@return position at which triple element @b e is indexed */
+   unsigned position(const unsigned e) const {
+      for( unsigned n = 0; n != 3; ++n ) if( p_[n] == e ) return n;
+      return 3;
+   }
+
+   std::string str() const {
+      std::string s(4, ' ');
+      for( unsigned n = 0; n != 4; ++n ) s[n] = "SPOD"[p_[n]];
+      return s;
+   }
+
+   bool operator==(Triple_permutation const& p) const {
+      return
+               p_[0] == p.p_[0] && p_[1] == p.p_[1] &&
+               p_[2] == p.p_[2] && p_[3] == p.p_[3];
+   }
+
+   bool operator!=(Triple_permutation const& p) const {return !(*this == p);}
+
+private:
+   unsigned p_[4];
+
+   static unsigned element(const char c) {
+      switch (c) {
+      case 'S': case 's': return 0;
+      case 'P': case 'p': return 1;
+      case 'O': case 'o': return 2;
+      case 'D': case 'd': return 3;
+      default: return 4;
+      }
+   }
+
+   static void error(std::string const& s) {
+      BOOST_THROW_EXCEPTION(
+               Rdf_err()
+               << Rdf_err::msg_t("invalid triple index permutation")
+               << Rdf_err::str1_t(s)
+      );
+   }
+};
+
+}//namespace owlcpp
+#endif /* TRIPLE_PERMUTATION_HPP_ */
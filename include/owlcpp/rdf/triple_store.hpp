@@ -21,6 +21,11 @@ part of owlcpp project.
 #include "owlcpp/rdf/nodes_std.hpp"
 
 namespace owlcpp{
+namespace detail{
+class Doc_replacer;
+class Snapshot_loader;
+class Triple_store_direct;
+}
 
 /**@brief Store namespace IRIs, RDF nodes, document infos, and RDF triples
 
@@ -44,6 +49,9 @@ public Map_triple_crtpb<Triple_store>
    friend class Map_node_blank_crtpb<Triple_store>;
    friend class Map_doc_crtpb<Triple_store>;
    friend class Map_triple_crtpb<Triple_store>;
+   friend class detail::Doc_replacer;
+   friend class detail::Snapshot_loader;
+   friend class detail::Triple_store_direct;
 
    typedef detail::Map_traits<Triple_store> traits;
 
@@ -64,6 +72,11 @@ public:
    : map_std_(map_std_type::get(nodes_std))
    {}
 
+   /**@brief make empty store with same standard nodes as another store */
+   explicit Triple_store(map_std_type const& map_std)
+   : map_std_(map_std)
+   {}
+
    map_std_type const& map_std() const {return map_std_;}
    map_ns_type const& map_ns() const {return map_ns_;}
    map_node_type const& map_node() const {return map_node_;}
@@ -25,6 +25,8 @@ template<class T> inline std::string to_string_pref(const T&) {
 }
 
 /** compare string with standard terms
+@param str characters of the string; need not be null-terminated
+@param len number of characters
 *******************************************************************************/
 template<class T> inline bool
 comparison(char const* str, const std::size_t len, T const&) {
@@ -35,7 +37,6 @@ comparison(char const* str, const std::size_t len, T const&) {
                      0,
                      ns_t::iri().size(),
                      str,
-                     0,
                      ns_t::iri().size()
             ) != 0
    ) return false;
@@ -43,8 +44,7 @@ comparison(char const* str, const std::size_t len, T const&) {
    return T::fragment().compare(
             0,
             T::fragment().size(),
-            str,
-            ns_t::iri().size() + 1,
+            str + ns_t::iri().size() + 1,
             T::fragment().size()
    ) == 0;
 }
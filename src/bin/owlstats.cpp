@@ -11,7 +11,9 @@ part of owlcpp project.
 #include "boost/program_options.hpp"
 
 #include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/catalog_cache.hpp"
 #include "owlcpp/io/input.hpp"
+#include "owlcpp/io/stream_triples.hpp"
 #include "owlcpp/rdf/node_blank.hpp"
 #include "owlcpp/rdf/node_iri.hpp"
 #include "owlcpp/rdf/node_literal.hpp"
@@ -54,6 +56,50 @@ struct Node_stats : public owlcpp::Visitor_node {
    }
 };
 
+/** Count statements and terms without storing them
+*******************************************************************************/
+struct Stream_stats : public owlcpp::Statement_visitor {
+   std::size_t n_doc_;
+   std::size_t n_triple_;
+   std::size_t n_blank_;
+   std::size_t n_iri_;
+   std::size_t n_literal_;
+   std::size_t str_len_;
+
+   Stream_stats()
+   : n_doc_(0),
+     n_triple_(0),
+     n_blank_(0),
+     n_iri_(0),
+     n_literal_(0),
+     str_len_(0)
+   {}
+
+   void document_impl(std::string const&) {++n_doc_;}
+
+   void visit_impl(
+            owlcpp::Stream_term const& subj,
+            owlcpp::Stream_term const& pred,
+            owlcpp::Stream_term const& obj
+   ) {
+      ++n_triple_;
+      term(subj);
+      term(pred);
+      term(obj);
+   }
+
+   void term(owlcpp::Stream_term const& t) {
+      switch (t.kind) {
+      case owlcpp::Stream_term::Iri: ++n_iri_; break;
+      case owlcpp::Stream_term::Blank: ++n_blank_; break;
+      case owlcpp::Stream_term::Literal:
+         ++n_literal_;
+         str_len_ += t.value.size();
+         break;
+      }
+   }
+};
+
 /** Parse OWL ontology file and print triples
 *******************************************************************************/
 int main(int argc, char* argv[]) {
@@ -64,6 +110,9 @@ int main(int argc, char* argv[]) {
             ("include,i",
                      bpo::value<std::vector<std::string> >()->zero_tokens()
                      ->composing(), "search paths")
+            ("cache,c", bpo::value<std::string>(), "catalog cache file")
+            ("stream,s", "count statements and terms while parsing, "
+                     "without storing the triples")
             ;
    bpo::positional_options_description pod;
    pod.add("input-file", -1);
@@ -79,31 +128,42 @@ int main(int argc, char* argv[]) {
       std::cout
       << "Print OWL ontology statistics" << '\n'
       << "Usage:" << '\n'
-      << "owlstats [-i[path]] <OWL_ontology_file.owl>" << '\n'
+      << "owlstats [-s] [-i[path]] [-c cache] <OWL_ontology_file.owl>" << '\n'
       << od << '\n';
       return ! vm.count("help");
    }
 
    owlcpp::Triple_store ts;
+   Stream_stats ss;
+   const bool stream = vm.count("stream");
    const bfs::path in( vm["input-file"].as<std::string>());
    try {
       if( vm.count("include") ) { //load input-file and its includes
          owlcpp::Catalog cat;
+         owlcpp::Catalog_cache cache;
+         if( vm.count("cache") )
+            cache = owlcpp::Catalog_cache(vm["cache"].as<std::string>());
          //how far to look into each file for ontologyVersion
          const std::size_t search_depth = 100;
          std::vector<std::string> const& vin =
                   vm["include"].as<std::vector<std::string> >();
 
          if( vin.empty() ) {
-            add(cat, in.parent_path(), true, search_depth);
+            add(cat, cache, in.parent_path(), true, search_depth);
          } else {
             BOOST_FOREACH(std::string const& p, vin) {
-               add(cat, p, true, search_depth);
+               add(cat, cache, p, true, search_depth);
             }
          }
-         load_file(in, ts, cat);
+         if( vm.count("cache") ) {
+            cache.prune();
+            cache.save(vm["cache"].as<std::string>());
+         }
+         if( stream ) stream_file(in, ss, cat);
+         else load_file(in, ts, cat);
       } else { //load just input-file
-         load_file(in, ts);
+         if( stream ) stream_file(in, ss);
+         else load_file(in, ts);
       }
    } catch(...) {
       std::cerr
@@ -113,6 +173,18 @@ int main(int argc, char* argv[]) {
       return 1;
    }
 
+   if( stream ) {
+      std::cout
+      << "documents: " << ss.n_doc_ << '\n'
+      << "IRI terms: " << ss.n_iri_ << '\n'
+      << "blank node terms: " << ss.n_blank_ << '\n'
+      << "literal terms: " << ss.n_literal_ << ", "
+      << ((double)ss.str_len_ / ss.n_literal_) << " average length\n"
+      << "triples: " << ss.n_triple_ << '\n'
+      ;
+      return 0;
+   }
+
    Node_stats ns;
    BOOST_FOREACH(const owlcpp::Node_id nid, ts.map_node()) {
       ts[nid].accept(ns);
@@ -13,6 +13,7 @@ part of owlcpp project.
 #include "owlcpp/rdf/triple_store.hpp"
 #include "owlcpp/io/catalog.hpp"
 #include "owlcpp/io/input.hpp"
+#include "owlcpp/io/triple_writer.hpp"
 
 namespace bpo = boost::program_options;
 namespace bfs = boost::filesystem;
@@ -28,6 +29,8 @@ int main(int argc, char* argv[]) {
                      bpo::value<std::vector<std::string> >()->zero_tokens()
                      ->composing(), "search paths")
             ("count,c", "only print the number of triples")
+            ("format,f", bpo::value<std::string>(),
+                     "print triples in N-Triples (nt) or Turtle (ttl) format")
             ;
    bpo::positional_options_description pod;
    pod.add("input-file", -1);
@@ -39,7 +42,7 @@ int main(int argc, char* argv[]) {
       std::cout
       << "Parse OWL ontology and print triples" << '\n'
       << "Usage:" << '\n'
-      << "print_triples [-i[path]] [-c] <OWL_ontology_file.owl>" << '\n'
+      << "print_triples [-i[path]] [-c] [-f nt|ttl] <OWL_ontology_file.owl>" << '\n'
       << od << '\n';
       return ! vm.count("help");
    }
@@ -67,6 +70,14 @@ int main(int argc, char* argv[]) {
          << store.map_node().size() << " nodes" << '\n'
          << store.map_ns().size() << " namespace IRIs" << '\n'
          ;
+      } else if( vm.count("format") ) {
+         const std::string f = vm["format"].as<std::string>();
+         if( f != "nt" && f != "ttl" ) {
+            std::cerr << "unknown format " << f << std::endl;
+            return 1;
+         }
+         typedef owlcpp::Triple_writer tw_t;
+         write_triples(store, std::cout, f == "ttl" ? tw_t::Turtle : tw_t::Ntriples);
       } else {
          BOOST_FOREACH( owlcpp::Triple const& t, store.map_triple() ) {
             std::cout
@@ -16,6 +16,7 @@ part of owlcpp project.
 #include "owlcpp/rdf/query_triples.hpp"
 #include "owlcpp/io/input.hpp"
 #include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/catalog_cache.hpp"
 #include "owlcpp/logic/triple_to_fact.hpp"
 #include "owlcpp/terms/node_tags_owl.hpp"
 
@@ -33,6 +34,7 @@ int main(int argc, char* argv[]) {
    ("include,i",
           bpo::value<std::vector<std::string> >()->zero_tokens()->composing(),
           "search paths")
+   ("cache,c", bpo::value<std::string>(), "catalog cache file")
    ("strict", bpo::bool_switch()->default_value(true), "strict parsing")
    ("return-success,S", bpo::bool_switch(),
          "return 1 if ontology is not consistent")
@@ -63,12 +65,19 @@ int main(int argc, char* argv[]) {
    try {
       if( vm.count("include") ) { //load input-file and its includes
          owlcpp::Catalog cat;
+         owlcpp::Catalog_cache cache;
+         if( vm.count("cache") )
+            cache = owlcpp::Catalog_cache(vm["cache"].as<std::string>());
          std::vector<std::string> const& vin =
                   vm["include"].as<std::vector<std::string> >();
          if( vin.empty() ) {
-            add(cat, in.parent_path(), true);
+            add(cat, cache, in.parent_path(), true);
          } else {
-            BOOST_FOREACH(std::string const& p, vin) add(cat, p, true);
+            BOOST_FOREACH(std::string const& p, vin) add(cat, cache, p, true);
+         }
+         if( vm.count("cache") ) {
+            cache.prune();
+            cache.save(vm["cache"].as<std::string>());
          }
          load_file(in, store, cat);
       } else { //load just input-file
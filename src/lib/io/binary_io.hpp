@@ -0,0 +1,88 @@
+/** @file "/owlcpp/lib/io/binary_io.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef BINARY_IO_HPP_
+#define BINARY_IO_HPP_
+#include <cstring>
+#include <ostream>
+#include <string>
+#include "boost/cstdint.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Write value in native byte order
+*******************************************************************************/
+template<class T> inline void write_binary(std::ostream& os, const T t) {
+   os.write(reinterpret_cast<char const*>(&t), sizeof(T));
+}
+
+/**@brief Write string prefixed with its length
+*******************************************************************************/
+inline void write_binary(std::ostream& os, boost::string_ref const& str) {
+   write_binary(os, static_cast<boost::uint32_t>(str.size()));
+   os.write(str.data(), str.size());
+}
+
+inline void write_binary(std::ostream& os, std::string const& str) {
+   write_binary(os, boost::string_ref(str));
+}
+
+/**@brief Read values written by write_binary() from memory buffer
+*******************************************************************************/
+class Binary_reader {
+public:
+   struct Err : public Input_err {};
+
+   Binary_reader(char const* begin, char const* end) : p_(begin), end_(end) {}
+
+   template<class T> T read() {
+      T t;
+      std::memcpy(&t, take(sizeof(T)), sizeof(T));
+      return t;
+   }
+
+   std::string read_string() {
+      const std::size_t n = read<boost::uint32_t>();
+      return std::string(take(n), n);
+   }
+
+   /**@brief read number of elements of an array that follows
+    @param min_size minimal number of bytes taken by each element
+    @throw Err if remaining data are too short for that many elements
+   */
+   std::size_t read_count(const std::size_t min_size) {
+      const boost::uint64_t n = read<boost::uint64_t>();
+      if( n > remaining() / min_size ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid number of elements")
+      );
+      return static_cast<std::size_t>(n);
+   }
+
+   char const* take(const std::size_t n) {
+      if( remaining() < n ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("unexpected end of data")
+      );
+      char const* p = p_;
+      p_ += n;
+      return p;
+   }
+
+   bool empty() const {return p_ == end_;}
+
+   std::size_t remaining() const {return static_cast<std::size_t>(end_ - p_);}
+
+private:
+   char const* p_;
+   char const* const end_;
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* BINARY_IO_HPP_ */
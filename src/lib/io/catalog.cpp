@@ -8,8 +8,14 @@ part of owlcpp project.
 #endif
 #include "owlcpp/io/catalog.hpp"
 
+#include <vector>
 #include "boost/filesystem.hpp"
+#include "boost/foreach.hpp"
+#include "boost/thread/tss.hpp"
 
+#include "owlcpp/detail/parallel_for.hpp"
+#include "owlcpp/io/catalog_cache.hpp"
+#include "owlcpp/io/raptor_wrapper.hpp"
 #include "owlcpp/io/read_ontology_iri.hpp"
 #include "owlcpp/rdf/print_node.hpp"
 
@@ -28,57 +34,128 @@ std::string Catalog::version_iri_str(const Doc_id did) const {
 
 namespace{
 
+/**@brief Read ontology IDs of several documents.
+@details Each thread keeps its own parser and reuses it for all documents
+it reads.
+Documents that fail to parse get empty ontologyIRI.
+*******************************************************************************/
+class Read_ids {
+public:
+   Read_ids(
+            std::vector<std::string> const& paths,
+            std::vector<std::size_t> const& todo,
+            std::vector<Catalog_cache::Entry>& ids,
+            const std::size_t search_depth
+   )
+   : paths_(paths), todo_(todo), ids_(ids), search_depth_(search_depth)
+   {}
+
+   void operator()(const std::size_t n) {
+      if( ! parser_.get() ) parser_.reset(new Raptor_wrapper());
+      const std::size_t i = todo_[n];
+      std::pair<std::string,std::string> pair;
+      try{
+         pair = read_ontology_iri(paths_[i], *parser_, search_depth_);
+      } catch(Input_err const&) {
+         //ignore
+      }
+      ids_[i].iri = pair.first;
+      ids_[i].version = pair.second;
+   }
+
+private:
+   std::vector<std::string> const& paths_;
+   std::vector<std::size_t> const& todo_;
+   std::vector<Catalog_cache::Entry>& ids_;
+   const std::size_t search_depth_;
+   boost::thread_specific_ptr<Raptor_wrapper> parser_;
+};
+
 /*
 *******************************************************************************/
 inline std::size_t add_to_catalog(
          boost::filesystem::path const& path,
          Catalog& cat,
          const std::size_t search_depth,
-         const bool ignore_errors
+         Catalog_cache* cache
 ) {
-   const boost::filesystem::path cp = canonical(path);
-   std::pair<std::string,std::string> pair;
-   try{
-      pair = read_ontology_iri(cp, search_depth);
-   } catch(Input_err const&) {
-      //ignore
-      return 0;
-   }
-   if( pair.first.empty() ) {
-      if(ignore_errors) return 0;
-      BOOST_THROW_EXCEPTION(
-               Input_err()
-               << Input_err::msg_t("ontologyIRI not found")
-               << Input_err::str1_t(path.string())
-      );
+   const std::string cp = canonical(path).string();
+   Catalog_cache::Entry e = Catalog_cache::stamp(cp, search_depth);
+   if( Catalog_cache::Entry const* ce = cache ? cache->find(cp, e) : 0 ) {
+      e = *ce;
+   } else {
+      std::pair<std::string,std::string> pair;
+      try{
+         pair = read_ontology_iri(cp, search_depth);
+      } catch(Input_err const&) {
+         //ignore
+         return 0;
+      }
+      e.iri = pair.first;
+      e.version = pair.second;
+      if( cache ) cache->insert(cp, e);
    }
-   return cat.insert_doc(pair.first, cp.string(), pair.second).second ? 1 : 0;
+   if( e.iri.empty() ) BOOST_THROW_EXCEPTION(
+            Input_err()
+            << Input_err::msg_t("ontologyIRI not found")
+            << Input_err::str1_t(path.string())
+   );
+   return cat.insert_doc(e.iri, cp, e.version).second ? 1 : 0;
 }
 
 /*
+Documents missing from the cache are read concurrently.
+All documents are inserted into the catalog in the order of directory iteration.
 *******************************************************************************/
 template<class Iter> inline
 std::size_t add_to_catalog(
-         Iter i1, Iter i2, Catalog& cat, const std::size_t search_depth
+         Iter i1, Iter i2,
+         Catalog& cat,
+         const std::size_t search_depth,
+         const unsigned n_threads,
+         Catalog_cache* cache
 ) {
-   std::size_t n = 0;
+   std::vector<std::string> paths;
    for( ; i1 != i2; ++i1 ) {
       if( is_regular_file(*i1) )
-         n += add_to_catalog(i1->path(), cat, search_depth, true);
+         paths.push_back(canonical(i1->path()).string());
+   }
+
+   std::vector<Catalog_cache::Entry> ids(paths.size());
+   std::vector<std::size_t> todo;
+   for(std::size_t i = 0; i != paths.size(); ++i) {
+      ids[i] = Catalog_cache::stamp(paths[i], search_depth);
+      if( Catalog_cache::Entry const* ce = cache ? cache->find(paths[i], ids[i]) : 0 ) {
+         ids[i] = *ce;
+      } else {
+         todo.push_back(i);
+      }
+   }
+
+   Read_ids ri(paths, todo, ids, search_depth);
+   detail::parallel_for(todo.size(), ri, n_threads);
+   if( cache ) {
+      BOOST_FOREACH(const std::size_t i, todo) cache->insert(paths[i], ids[i]);
+   }
+
+   std::size_t n = 0;
+   for(std::size_t i = 0; i != paths.size(); ++i) {
+      if( ids[i].iri.empty() ) continue;
+      if( cat.insert_doc(ids[i].iri, paths[i], ids[i].version).second ) ++n;
    }
    return n;
 }
 
-}//namespace anonymous
-
 /*
 *******************************************************************************/
-std::size_t add(
+std::size_t add_path(
          Catalog& cat,
+         Catalog_cache* cache,
          boost::filesystem::path const& path,
          const bool recurse,
-         const std::size_t search_depth
-         ) {
+         const std::size_t search_depth,
+         const unsigned n_threads
+) {
    if( ! exists(path) ) BOOST_THROW_EXCEPTION(
             Input_err()
             << Input_err::msg_t("not found")
@@ -87,15 +164,42 @@ std::size_t add(
    if( is_directory(path) ) {
       if( recurse ) {
          boost::filesystem::recursive_directory_iterator i1(path), i2;
-         return add_to_catalog(i1, i2, cat, search_depth);
+         return add_to_catalog(i1, i2, cat, search_depth, n_threads, cache);
       } else {
          boost::filesystem::directory_iterator i1(path), i2;
-         return add_to_catalog(i1, i2, cat, search_depth);
+         return add_to_catalog(i1, i2, cat, search_depth, n_threads, cache);
       }
    } else if( is_regular_file(path) ) {
-      return add_to_catalog(path, cat, search_depth, false);
+      return add_to_catalog(path, cat, search_depth, cache);
    }
    return 0;
 }
 
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+std::size_t add(
+         Catalog& cat,
+         boost::filesystem::path const& path,
+         const bool recurse,
+         const std::size_t search_depth,
+         const unsigned n_threads
+         ) {
+   return add_path(cat, 0, path, recurse, search_depth, n_threads);
+}
+
+/*
+*******************************************************************************/
+std::size_t add(
+         Catalog& cat,
+         Catalog_cache& cache,
+         boost::filesystem::path const& path,
+         const bool recurse,
+         const std::size_t search_depth,
+         const unsigned n_threads
+         ) {
+   return add_path(cat, &cache, path, recurse, search_depth, n_threads);
+}
+
 }//namespace owlcpp
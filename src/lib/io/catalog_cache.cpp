@@ -0,0 +1,176 @@
+/** @file "/owlcpp/lib/io/catalog_cache.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "owlcpp/io/catalog_cache.hpp"
+
+#include <ctime>
+#include <cstring>
+#include <iterator>
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/foreach.hpp"
+
+#include "binary_io.hpp"
+
+namespace owlcpp {
+namespace{
+
+const char magic[] = "owlcpp_catalog";
+const boost::uint32_t format_version = 1;
+
+/** path, modification time, size, search depth, and two IDs */
+const std::size_t min_entry_size =
+         3 * sizeof(boost::uint64_t) + 3 * sizeof(boost::uint32_t);
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+Catalog_cache::Entry Catalog_cache::stamp(
+         std::string const& path,
+         const std::size_t search_depth
+) {
+   Entry e;
+   boost::system::error_code ec;
+   e.mtime = boost::filesystem::last_write_time(path, ec);
+   e.size = boost::filesystem::file_size(path, ec);
+   e.search_depth = search_depth;
+   return e;
+}
+
+/*
+*******************************************************************************/
+Catalog_cache::Catalog_cache(boost::filesystem::path const& file) {
+   if( ! exists(file) ) return;
+   try{
+      load(file);
+   } catch(Err const&) {
+      m_.clear();
+   }
+}
+
+/*
+*******************************************************************************/
+Catalog_cache::Entry const* Catalog_cache::find(
+         std::string const& path,
+         Entry const& stamp
+) const {
+   const map_t::const_iterator i = m_.find(path);
+   if(
+            i == m_.end() ||
+            i->second.mtime != stamp.mtime ||
+            i->second.size != stamp.size ||
+            i->second.search_depth != stamp.search_depth
+   ) return 0;
+   i->second.seen = true;
+   return &i->second;
+}
+
+/*
+*******************************************************************************/
+void Catalog_cache::insert(std::string const& path, Entry const& entry) {
+   if( entry.mtime >= static_cast<boost::int64_t>(std::time(0)) - 1 ) {
+      m_.erase(path);
+      return;
+   }
+   Record& r = m_[path];
+   static_cast<Entry&>(r) = entry;
+   r.seen = true;
+}
+
+/*
+*******************************************************************************/
+std::size_t Catalog_cache::prune() {
+   std::size_t n = 0;
+   for( map_t::iterator i = m_.begin(); i != m_.end(); ) {
+      if( i->second.seen ) {
+         ++i;
+      } else {
+         m_.erase(i++);
+         ++n;
+      }
+   }
+   return n;
+}
+
+/*
+*******************************************************************************/
+void Catalog_cache::load(boost::filesystem::path const& file) {
+   boost::filesystem::ifstream ifs(file, std::ios::binary);
+   if( ! ifs ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("error opening catalog cache")
+            << Err::str1_t(file.string())
+   );
+   const std::string buff(
+            (std::istreambuf_iterator<char>(ifs)),
+            std::istreambuf_iterator<char>()
+   );
+   try{
+      detail::Binary_reader br(buff.data(), buff.data() + buff.size());
+      char const* mg = br.take(sizeof(magic));
+      const boost::uint32_t ver = br.read<boost::uint32_t>();
+      if( std::memcmp(mg, magic, sizeof(magic)) || ver != format_version )
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("unsupported format")
+         );
+      map_t m;
+      for( std::size_t n = br.read_count(min_entry_size); n; --n ) {
+         Record& e = m[br.read_string()];
+         e.mtime = br.read<boost::int64_t>();
+         e.size = br.read<boost::uint64_t>();
+         e.search_depth = br.read<boost::uint64_t>();
+         e.iri = br.read_string();
+         e.version = br.read_string();
+      }
+      m_.swap(m);
+   } catch(Input_err const&) {
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error reading catalog cache")
+               << Err::str1_t(file.string())
+               << Err::nested_t(boost::current_exception())
+      );
+   }
+}
+
+/*
+Write to temporary file first so that readers never see a partial cache
+*******************************************************************************/
+void Catalog_cache::save(boost::filesystem::path const& file) const {
+   const boost::filesystem::path tmp = file.string() + ".tmp";
+   {
+      boost::filesystem::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+      ofs.write(magic, sizeof(magic));
+      detail::write_binary(ofs, format_version);
+      detail::write_binary(ofs, static_cast<boost::uint64_t>(m_.size()));
+      BOOST_FOREACH(map_t::value_type const& p, m_) {
+         detail::write_binary(ofs, p.first);
+         detail::write_binary(ofs, p.second.mtime);
+         detail::write_binary(ofs, p.second.size);
+         detail::write_binary(ofs, p.second.search_depth);
+         detail::write_binary(ofs, p.second.iri);
+         detail::write_binary(ofs, p.second.version);
+      }
+      if( ! ofs ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error writing catalog cache")
+               << Err::str1_t(tmp.string())
+      );
+   }
+   boost::system::error_code ec;
+   rename(tmp, file, ec);
+   if( ec ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("error writing catalog cache")
+            << Err::str1_t(file.string())
+   );
+}
+
+}//namespace owlcpp
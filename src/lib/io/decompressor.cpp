@@ -0,0 +1,181 @@
+/** @file "/owlcpp/lib/io/decompressor.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "decompressor.hpp"
+#include <istream>
+#include "boost/bind.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/iostreams/filtering_stream.hpp"
+#include "boost/iostreams/filter/gzip.hpp"
+#include "boost/version.hpp"
+#if BOOST_VERSION >= 106500
+#include "boost/iostreams/filter/lzma.hpp"
+#define OWLCPP_DECOMPRESS_XZ
+#endif
+#if BOOST_VERSION >= 107000
+#include "boost/iostreams/filter/zstd.hpp"
+#define OWLCPP_DECOMPRESS_ZSTD
+#endif
+
+namespace owlcpp { namespace detail{ namespace{
+
+bool starts_with(char const* buff, char const* magic, const std::size_t n) {
+   return std::equal(magic, magic + n, buff);
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+Decompressor::Format Decompressor::format(std::string const& file) {
+   boost::filesystem::ifstream ifs(file, std::ios::binary);
+   char buff[6] = {0};
+   ifs.read(buff, sizeof(buff));
+   const std::size_t n = static_cast<std::size_t>(ifs.gcount());
+   if( n >= 2 && starts_with(buff, "\x1F\x8B", 2) ) return Gzip;
+   if( n >= 6 && starts_with(buff, "\xFD" "7zXZ\x00", 6) ) return Xz;
+   if( n >= 4 && starts_with(buff, "\x28\xB5\x2F\xFD", 4) ) return Zstd;
+   return None;
+}
+
+/*
+*******************************************************************************/
+bool Decompressor::compressed_extension(std::string const& ext) {
+   return ext == ".gz" || ext == ".xz" || ext == ".zst";
+}
+
+/*
+*******************************************************************************/
+Decompressor::Decompressor(std::string const& file, const std::size_t buffer_size)
+: file_(file),
+  format_(format(file)),
+  curr_(0),
+  held_(false),
+  stop_(false)
+{
+   for( unsigned n = 0; n != 2; ++n ) {
+      buff_[n].resize(buffer_size ? buffer_size : default_buffer_size());
+      size_[n] = 0;
+      full_[n] = false;
+   }
+   thread_ = boost::thread(boost::bind(&Decompressor::run, this));
+}
+
+/*
+*******************************************************************************/
+Decompressor::~Decompressor() {
+   {
+      boost::lock_guard<boost::mutex> lock(mutex_);
+      stop_ = true;
+      cond_.notify_all();
+   }
+   thread_.join();
+}
+
+/*
+*******************************************************************************/
+boost::string_ref Decompressor::next() {
+   boost::unique_lock<boost::mutex> lock(mutex_);
+   if( held_ ) {
+      //end of data
+      if( ! size_[curr_] ) return boost::string_ref();
+      full_[curr_] = false;
+      curr_ ^= 1;
+      held_ = false;
+      cond_.notify_all();
+   }
+   while( ! full_[curr_] && ! err_ ) cond_.wait(lock);
+   if( ! full_[curr_] ) boost::rethrow_exception(err_);
+   held_ = true;
+   if( ! size_[curr_] ) return boost::string_ref();
+   return boost::string_ref(&buff_[curr_][0], size_[curr_]);
+}
+
+/*
+*******************************************************************************/
+void Decompressor::run() {
+   namespace bio = boost::iostreams;
+   try{
+      boost::filesystem::ifstream ifs(file_, std::ios::binary);
+      if( ! ifs ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("read error")
+               << Err::str1_t(file_)
+      );
+
+      bio::filtering_istream is;
+      switch (format_) {
+      case Gzip:
+         is.push(bio::gzip_decompressor());
+         break;
+#ifdef OWLCPP_DECOMPRESS_XZ
+      case Xz:
+         is.push(bio::lzma_decompressor());
+         break;
+#endif
+#ifdef OWLCPP_DECOMPRESS_ZSTD
+      case Zstd:
+         is.push(bio::zstd_decompressor());
+         break;
+#endif
+      case None:
+         break;
+      default:
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("unsupported compression format")
+                  << Err::str1_t(file_)
+         );
+      }
+      is.push(ifs);
+
+      for( unsigned n = 0; ; n ^= 1 ) {
+         {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while( full_[n] && ! stop_ ) cond_.wait(lock);
+            if( stop_ ) return;
+         }
+         const std::size_t k = fill(is, n);
+         {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            size_[n] = k;
+            full_[n] = true;
+            cond_.notify_all();
+         }
+         if( ! k ) return;
+      }
+   } catch(...) {
+      boost::lock_guard<boost::mutex> lock(mutex_);
+      err_ = boost::current_exception();
+      cond_.notify_all();
+   }
+}
+
+/*
+*******************************************************************************/
+std::size_t Decompressor::fill(std::istream& is, const unsigned n) {
+   try{
+      is.read(&buff_[n][0], static_cast<std::streamsize>(buff_[n].size()));
+   } catch(std::exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error decompressing")
+               << Err::str1_t(file_)
+               << Err::nested_t(boost::current_exception())
+      );
+   }
+   if( is.bad() ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("error decompressing")
+            << Err::str1_t(file_)
+   );
+   return static_cast<std::size_t>(is.gcount());
+}
+
+}//namespace detail
+}//namespace owlcpp
@@ -0,0 +1,90 @@
+/** @file "/owlcpp/lib/io/decompressor.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef DECOMPRESSOR_HPP_
+#define DECOMPRESSOR_HPP_
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "boost/exception_ptr.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Decompress file in a separate thread
+@details Compression format is detected from the first bytes of the file.
+The decompressing thread fills one of two buffers while the other one is
+being processed by the caller of next().
+*******************************************************************************/
+class OWLCPP_IO_DECL Decompressor : boost::noncopyable {
+public:
+   typedef Input_err Err;
+
+   enum Format {None, Gzip, Xz, Zstd};
+
+   static std::size_t default_buffer_size() {return 1 << 20;}
+
+   /**@return compression format of @b file; None if file cannot be read
+    or is not compressed
+   */
+   static Format format(std::string const& file);
+
+   /**@return true if @b file is compressed in a supported format */
+   static bool compressed(std::string const& file) {
+      return format(file) != None;
+   }
+
+   /**@return @b ext is an extension of compressed files, e.g., ".gz" */
+   static bool compressed_extension(std::string const& ext);
+
+   /**
+    @param file compressed file
+    @param buffer_size size of each of two buffers
+   */
+   explicit Decompressor(
+            std::string const& file,
+            const std::size_t buffer_size = default_buffer_size()
+   );
+
+   /** Stop decompressing thread */
+   ~Decompressor();
+
+   /**@brief get next block of decompressed data
+    @details The previously returned block is released.
+    @return decompressed data; empty at the end of file
+    @throw Err if reading or decompressing fails
+   */
+   boost::string_ref next();
+
+   std::string const& file() const {return file_;}
+
+private:
+   const std::string file_;
+   const Format format_;
+   std::vector<char> buff_[2];
+   std::size_t size_[2];
+   bool full_[2];
+   unsigned curr_; ///< buffer processed by the caller
+   bool held_; ///< true if caller holds curr_
+   bool stop_;
+   boost::exception_ptr err_;
+   boost::mutex mutex_;
+   boost::condition_variable cond_;
+   boost::thread thread_;
+
+   void run();
+   std::size_t fill(std::istream& is, const unsigned n);
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* DECOMPRESSOR_HPP_ */
@@ -0,0 +1,186 @@
+/** @file "/owlcpp/lib/io/doc_reloader.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "owlcpp/io/doc_reloader.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "boost/foreach.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include "owlcpp/io/catalog.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "load_imports.hpp"
+#include "ntriples_to_store.hpp"
+#include "raptor_to_store.hpp"
+
+namespace owlcpp {
+namespace{
+
+/**@return FNV-1a hash of file contents
+*******************************************************************************/
+boost::uint64_t content_hash(std::string const& path) {
+   namespace bip = boost::interprocess;
+   boost::uint64_t h = 14695981039346656037ULL;
+   boost::system::error_code ec;
+   const boost::uintmax_t size = boost::filesystem::file_size(path, ec);
+   if( ec ) BOOST_THROW_EXCEPTION(
+            Doc_reloader::Err()
+            << Doc_reloader::Err::msg_t("error reading file")
+            << Doc_reloader::Err::str1_t(path)
+   );
+   if( ! size ) return h;
+   try{
+      const bip::file_mapping fm(path.c_str(), bip::read_only);
+      bip::mapped_region mr(fm, bip::read_only);
+      mr.advise(bip::mapped_region::advice_sequential);
+      unsigned char const* p = static_cast<unsigned char const*>(mr.get_address());
+      for( unsigned char const*const end = p + mr.get_size(); p != end; ++p ) {
+         h = (h ^ *p) * 1099511628211ULL;
+      }
+   } catch(bip::interprocess_exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Doc_reloader::Err()
+               << Doc_reloader::Err::msg_t("error mapping file")
+               << Doc_reloader::Err::str1_t(path)
+               << Doc_reloader::Err::nested_t(boost::current_exception())
+      );
+   }
+   return h;
+}
+
+/**@return nodes imported by document @b did
+*******************************************************************************/
+std::set<Node_id> imports(Triple_store const& store, const Doc_id did) {
+   std::set<Node_id> s;
+   BOOST_FOREACH(
+            Triple const& t,
+            store.find_triple(any, terms::owl_imports::id(), any, did)
+   ) {
+      s.insert(t.obj_);
+   }
+   return s;
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+Doc_reloader::Doc_reloader(
+         Triple_store& store,
+         Catalog const& cat,
+         const unsigned n_threads
+)
+: store_(store), cat_(cat), n_threads_(n_threads)
+{
+   BOOST_FOREACH(const Doc_id did, store_.map_doc()) {
+      try{
+         track(did);
+      } catch(Err const&) {
+         //document is reloaded when it becomes readable
+      }
+   }
+}
+
+/*
+*******************************************************************************/
+void Doc_reloader::track(const Doc_id did) {
+   std::string const& path = store_.at(did).path;
+   if( path.empty() ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("document path is unknown")
+            << Err::int1_t(did())
+   );
+   hashes_[path] = content_hash(path);
+}
+
+/*
+*******************************************************************************/
+Doc_reloader::Report Doc_reloader::reload(const Doc_id did) {
+   Report r;
+   r.doc = did;
+   const std::string path = store_.at(did).path;
+   if( path.empty() ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("document path is unknown")
+            << Err::int1_t(did())
+   );
+   const boost::uint64_t h = content_hash(path);
+   const map_t::const_iterator i = hashes_.find(path);
+   if( i != hashes_.end() && i->second == h ) return r;
+
+   const std::set<Node_id> imports0 = imports(store_, did);
+   const std::set<Doc_id> docs0(store_.map_doc().begin(), store_.map_doc().end());
+
+   const Check_id check;
+   std::vector<std::string> iris;
+   if( detail::is_ntriples(path) ) {
+      detail::Ntriples_to_store nts(store_, path, check, n_threads_);
+      nts.replace(did);
+      nts.read_file(path);
+      nts.merge();
+      iris = nts.imports();
+   } else {
+      detail::Raptor_to_store rts(store_, path, check);
+      rts.replace(did);
+      rts.read_file(path);
+      rts.merge();
+      iris = rts.imports();
+   }
+   r.changed = true;
+   hashes_[path] = h;
+
+   try{
+      detail::load_imports(iris, store_, cat_, n_threads_);
+   } catch(Input_err&) {
+      BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("import error")
+                  << Input_err::str1_t(path)
+                  << Input_err::nested_t(boost::current_exception())
+      );
+   }
+
+   BOOST_FOREACH(const Doc_id d, store_.map_doc()) {
+      if( d != r.doc && ! docs0.count(d) ) r.imported.push_back(d);
+   }
+
+   const std::set<Node_id> imports1 = imports(store_, r.doc);
+   std::set<Doc_id> orphaned;
+   BOOST_FOREACH(const Node_id nid, imports0) {
+      if( imports1.count(nid) ) continue;
+      if( store_.find_triple(any, terms::owl_imports::id(), nid, any) ) continue;
+      BOOST_FOREACH(const Doc_id d, store_.map_doc().find_iri(nid)) {
+         orphaned.insert(d);
+      }
+      BOOST_FOREACH(const Doc_id d, store_.map_doc().find_version(nid)) {
+         orphaned.insert(d);
+      }
+   }
+   r.orphaned.assign(orphaned.begin(), orphaned.end());
+   std::sort(r.imported.begin(), r.imported.end());
+   return r;
+}
+
+/*
+*******************************************************************************/
+Doc_reloader::Report Doc_reloader::reload(boost::filesystem::path const& file) {
+   const std::string cp = canonical(file).string();
+   const Triple_store::map_doc_type::path_range r = store_.map_doc().find_path(cp);
+   if( ! r ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("document is not loaded")
+            << Err::str1_t(cp)
+   );
+   return reload(*r.begin());
+}
+
+}//namespace owlcpp
@@ -0,0 +1,160 @@
+/** @file "/owlcpp/lib/io/doc_replacer.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef DOC_REPLACER_HPP_
+#define DOC_REPLACER_HPP_
+#include <set>
+#include <string>
+#include <vector>
+#include "boost/assert.hpp"
+#include "boost/foreach.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/range/begin.hpp"
+#include "boost/range/end.hpp"
+
+#include "owlcpp/rdf/copy_triples.hpp"
+#include "owlcpp/rdf/node_blank.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Replace document in a triple store keeping its ID
+@details The constructor saves document info and triples of the document
+and removes them from the store.
+Info of the new document is added under the same ID by insert_doc().
+Blank nodes of the replaced document are kept until commit(), so that
+the new document reuses them for the blank nodes with same indices.
+Unless commit() is called, rollback() removes the new document, its triples,
+and its blank nodes, and restores the saved document.
+If neither is called, the document is restored on destruction and errors
+are ignored.
+IRI and literal nodes added for the new document are kept.
+The store should not be modified by other means until then.
+*******************************************************************************/
+class Doc_replacer : boost::noncopyable {
+public:
+   Doc_replacer(Triple_store& ts, const Doc_id did)
+   : ts_(ts),
+     did_(did),
+     doc_(ts.at(did)),
+     done_(false)
+   {
+      const Triple_store::map_triple_type::doc_range r =
+               ts_.map_triple().doc_triples(did_);
+      triples_.assign(boost::begin(r), boost::end(r));
+      BOOST_FOREACH(Triple const& t, triples_) {
+         if( is_blank(t.subj_) ) blanks_.insert(t.subj_);
+         if( is_blank(t.obj_) ) blanks_.insert(t.obj_);
+      }
+      ts_.map_triple_.erase_doc(did_);
+      ts_.map_doc_.erase(did_);
+   }
+
+   ~Doc_replacer() {
+      if( done_ ) return;
+      try{
+         restore();
+      } catch(...) {
+         //destructor may be called during stack unwinding
+      }
+   }
+
+   /**@return ID of the replaced document */
+   Doc_id doc_id() const {return did_;}
+
+   /**@brief add info of the new document under the ID of the replaced one
+    @throw Rdf_err if document info cannot be added
+   */
+   void insert_doc(
+            const Node_id iri,
+            std::string const& path,
+            const Node_id version
+   ) {
+      ts_.map_doc_.insert(did_, iri, path, version);
+   }
+
+   /**@brief keep the new document and erase unused blank nodes of the
+    replaced one
+   */
+   void commit() {
+      BOOST_ASSERT( ts_.map_doc_.find(did_) );
+      BOOST_FOREACH(Triple const& t, ts_.map_triple().doc_triples(did_)) {
+         blanks_.erase(t.subj_);
+         blanks_.erase(t.obj_);
+      }
+      BOOST_FOREACH(const Node_id nid, blanks_) ts_.map_node_.erase(nid);
+      done_ = true;
+      std::vector<Triple>().swap(triples_);
+      blanks_.clear();
+   }
+
+   /**@brief remove the new document and restore the replaced one
+    @throw Rdf_err if the replaced document cannot be restored
+   */
+   void rollback() {
+      BOOST_ASSERT( ! done_ );
+      done_ = true;
+      restore();
+   }
+
+private:
+   Triple_store& ts_;
+   const Doc_id did_;
+   const Doc_meta doc_;
+   bool done_; ///< true after commit() or rollback()
+   std::vector<Triple> triples_;
+   std::set<Node_id> blanks_;
+
+   /** @return true if @b nid is a blank node of the document */
+   bool is_blank(const Node_id nid) const {
+      Node const*const node = ts_.map_node_.find(nid);
+      return
+               node &&
+               owlcpp::is_blank(node->ns_id()) &&
+               static_cast<Node_blank const*>(node)->document() == did_;
+   }
+
+   void restore() {
+      ts_.map_triple_.erase_doc(did_);
+      if( ts_.map_doc_.find(did_) ) ts_.map_doc_.erase(did_);
+      std::vector<Node_id> v;
+      BOOST_FOREACH(const Node_id nid, ts_.map_node_) {
+         if( is_blank(nid) && ! blanks_.count(nid) ) v.push_back(nid);
+      }
+      BOOST_FOREACH(const Node_id nid, v) ts_.map_node_.erase(nid);
+      ts_.map_doc_.insert(did_, doc_.ontology_iri, doc_.path, doc_.version_iri);
+      ts_.map_triple_.insert(triples_.begin(), triples_.end());
+   }
+};
+
+/**@brief replace document @b did in @b ts by document @b src_did of @b src
+@details The new document keeps ID @b did.
+All triples of @b src are copied.
+If copying fails, the replaced document is restored.
+*******************************************************************************/
+template<class Src> void replace_doc(
+         Triple_store& ts,
+         const Doc_id did,
+         Src const& src,
+         const Doc_id src_did
+) {
+   Doc_replacer dr(ts, did);
+   try{
+      Node_copier<Src, Triple_store> copier(src, ts);
+      typename Map_traits<Src>::doc_type const& doc = src[src_did];
+      dr.insert_doc(
+               copier.cp(doc.ontology_iri), doc.path, copier.cp(doc.version_iri)
+      );
+      copy_triples(src, ts);
+      dr.commit();
+   } catch(...) {
+      dr.rollback();
+      throw;
+   }
+}
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* DOC_REPLACER_HPP_ */
@@ -9,13 +9,19 @@ part of owlcpp project.
 #include "owlcpp/io/input.hpp"
 
 #include <iostream>
-#include <set>
-#include "boost/filesystem/fstream.hpp"
+#include <map>
+#include <memory>
 #include "boost/filesystem.hpp"
 #include "boost/foreach.hpp"
+#include "boost/ptr_container/ptr_vector.hpp"
 #include "boost/range/algorithm/copy.hpp"
+#include "boost/thread/thread.hpp"
 
+#include "owlcpp/detail/parallel_for.hpp"
 #include "owlcpp/io/catalog.hpp"
+#include "decompressor.hpp"
+#include "load_imports.hpp"
+#include "ntriples_to_store.hpp"
 #include "raptor_to_store.hpp"
 
 namespace owlcpp {
@@ -32,40 +38,169 @@ void load(
    rts.parse(stream);
 }
 
+/*
+*******************************************************************************/
+Doc_id detail::find_import(std::string const& iri, Catalog const& cat) {
+   if( Catalog::doc_version_range r = cat.find_doc_version(iri) ) {
+      return *r.begin();
+   } else if(Catalog::doc_iri_range r = cat.find_doc_iri(iri)) {
+      return *r.begin();
+   }
+   BOOST_THROW_EXCEPTION(
+            Input_err()
+            << Input_err::msg_t("ontology not found")
+            << Input_err::str1_t(iri)
+   );
+}
+
+/*
+*******************************************************************************/
+bool detail::is_ntriples(boost::filesystem::path const& file) {
+   std::string ext = file.extension().string();
+   if( detail::Decompressor::compressed_extension(ext) ) {
+      ext = file.stem().extension().string();
+   }
+   return ext == ".nt" || ext == ".nq";
+}
+
 namespace {
 
+/**@brief Imported ontology document parsed into temporary storage
+@details N-Triples and N-Quads documents are parsed by Ntriples_to_store,
+other documents by Raptor_to_store.
+*******************************************************************************/
+class Import_doc {
+public:
+   Import_doc(
+            Catalog const& cat,
+            const Doc_id did,
+            Triple_store& store,
+            const unsigned n_threads
+   )
+   : path_(boost::filesystem::canonical(cat.path(did)).string()),
+     check_(cat.ontology_iri_str(did), cat.version_iri_str(did)),
+     nts_(
+              detail::is_ntriples(path_) ?
+              new detail::Ntriples_to_store(store, path_, check_, n_threads) : 0
+     ),
+     rts_(nts_.get() ? 0 : new detail::Raptor_to_store(store, path_, check_))
+   {}
+
+   void read() {
+      if( nts_.get() ) nts_->read_file(path_);
+      else rts_->read_file(path_);
+   }
+
+   void merge() {
+      if( nts_.get() ) nts_->merge();
+      else rts_->merge();
+   }
+
+   std::vector<std::string> const& imports() const {
+      return nts_.get() ? nts_->imports() : rts_->imports();
+   }
+
+private:
+   const std::string path_;
+   const Check_both check_;
+   std::auto_ptr<detail::Ntriples_to_store> nts_;
+   std::auto_ptr<detail::Raptor_to_store> rts_;
+};
+
+/**@brief Parse documents of one level of import closure
+*******************************************************************************/
+class Read_imports {
+public:
+   Read_imports(boost::ptr_vector<Import_doc>& docs, const std::size_t first)
+   : docs_(docs), first_(first)
+   {}
+   void operator()(const std::size_t n) {docs_[first_ + n].read();}
+private:
+   boost::ptr_vector<Import_doc>& docs_;
+   const std::size_t first_;
+};
+
+typedef std::map<Doc_id, Import_doc*> import_map_t;
+
 /*
+Merge parsed imports depth-first in the order of import statements, i.e.,
+in the same order as if each imported document and its own imports were
+loaded before the next import.
 *******************************************************************************/
-template<class Iter> void load(
-         std::istream& stream,
+void merge_imports(
+         std::vector<std::string> const& iris,
          Triple_store& store,
-         std::string const& path,
-         Check_id const& check,
-         Iter iter
+         Catalog const& cat,
+         import_map_t& docs
 ) {
-   detail::Raptor_to_store rts(store, path, check);
-   rts.parse(stream);
-   boost::copy(rts.imports(), iter);
+   BOOST_FOREACH(std::string const& iri, iris) {
+      if( store.find_doc_iri(iri) ) continue;
+      const import_map_t::iterator i = docs.find(detail::find_import(iri, cat));
+      if( i == docs.end() || ! i->second ) continue;
+      Import_doc& doc = *i->second;
+      i->second = 0;
+      doc.merge();
+      merge_imports(doc.imports(), store, cat, docs);
+   }
 }
 
 }//namespace anonymous
 
 /*
+Import closure is parsed level by level; documents of each level are
+parsed concurrently into their own temporary stores.
+The documents are then merged into @b store depth-first, so that document
+and node IDs are assigned in the same order as by sequential loading.
 *******************************************************************************/
-void load(
-         std::istream& stream,
+void detail::load_imports(
+         std::vector<std::string> iris,
          Triple_store& store,
          Catalog const& cat,
-         std::string const& path,
-         Check_id const& check
+         const unsigned n_threads
 ) {
-   std::vector<std::string> v;
-   load(stream, store, path, check, back_inserter(v));
-   try{
-      BOOST_FOREACH(std::string const& iri, v) {
+   boost::ptr_vector<Import_doc> docs;
+   import_map_t found;
+   for( std::vector<std::string> level = iris; ! level.empty(); ) {
+      std::vector<Doc_id> dids;
+      BOOST_FOREACH(std::string const& iri, level) {
          if( store.find_doc_iri(iri) ) continue;
-         load_iri(iri, store, cat);
+         const Doc_id did = detail::find_import(iri, cat);
+         if( found.insert(import_map_t::value_type(did, 0)).second ) {
+            dids.push_back(did);
+         }
+      }
+
+      //documents of a level are parsed concurrently, each by a single thread
+      const unsigned doc_threads = dids.size() > 1 ? 1 : n_threads;
+      const std::size_t first = docs.size();
+      BOOST_FOREACH(const Doc_id did, dids) {
+         docs.push_back(new Import_doc(cat, did, store, doc_threads));
+         found[did] = &docs.back();
+      }
+
+      Read_imports ri(docs, first);
+      detail::parallel_for(docs.size() - first, ri, n_threads);
+
+      level.clear();
+      for( std::size_t n = first; n != docs.size(); ++n ) {
+         boost::copy(docs[n].imports(), back_inserter(level));
       }
+   }
+   merge_imports(iris, store, cat, found);
+}
+
+namespace {
+
+/*
+*******************************************************************************/
+void load_imports_of(
+         std::vector<std::string> const& imports,
+         Triple_store& store,
+         Catalog const& cat,
+         const unsigned n_threads
+) {
+   try{
+      detail::load_imports(imports, store, cat, n_threads);
    } catch(Input_err&) {
       BOOST_THROW_EXCEPTION(
                   Input_err()
@@ -75,16 +210,68 @@ void load(
    }
 }
 
+/*
+Overlap parsing with node interning for large files if another hardware
+thread is available.
+*******************************************************************************/
+void parse_file(detail::Raptor_to_store& rts, std::string const& file) {
+   static const boost::uintmax_t pipelined_min_size = 1 << 24;
+   boost::system::error_code ec;
+   if(
+            boost::thread::hardware_concurrency() > 1 &&
+            boost::filesystem::file_size(file, ec) >= pipelined_min_size &&
+            ! ec
+   ) {
+      rts.parse_file_pipelined(file);
+   } else {
+      rts.parse_file(file);
+   }
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+void load(
+         std::istream& stream,
+         Triple_store& store,
+         Catalog const& cat,
+         std::string const& path,
+         Check_id const& check,
+         const unsigned n_threads
+) {
+   detail::Raptor_to_store rts(store, path, check);
+   rts.parse(stream);
+   load_imports_of(rts.imports(), store, cat, n_threads);
+}
+
 /*
 *******************************************************************************/
 void load_file(
          boost::filesystem::path const& file,
          Triple_store& store,
          Check_id const& check
+) {
+   if( detail::is_ntriples(file) ) {
+      load_ntriples(file, store, check);
+      return;
+   }
+   const std::string cp = canonical(file).string();
+   detail::Raptor_to_store rts(store, cp, check);
+   parse_file(rts, cp);
+}
+
+/*
+*******************************************************************************/
+void load_ntriples(
+         boost::filesystem::path const& file,
+         Triple_store& store,
+         Check_id const& check,
+         const unsigned n_threads
 ) {
    const std::string cp = canonical(file).string();
-   boost::filesystem::ifstream ifs(cp);
-   load(ifs, store, cp, check);
+   detail::Ntriples_to_store nts(store, cp, check, n_threads);
+   nts.parse_file(cp);
 }
 
 /*
@@ -93,29 +280,32 @@ void load_file(
          boost::filesystem::path const& file,
          Triple_store& store,
          Catalog const& cat,
-         Check_id const& check
+         Check_id const& check,
+         const unsigned n_threads
 ) {
    const std::string cp = canonical(file).string();
-   boost::filesystem::ifstream ifs(cp);
-   load(ifs, store, cat, cp, check);
+   if( detail::is_ntriples(file) ) {
+      detail::Ntriples_to_store nts(store, cp, check, n_threads);
+      nts.parse_file(cp);
+      load_imports_of(nts.imports(), store, cat, n_threads);
+      return;
+   }
+   detail::Raptor_to_store rts(store, cp, check);
+   parse_file(rts, cp);
+   load_imports_of(rts.imports(), store, cat, n_threads);
 }
 
 /*
 *******************************************************************************/
-void load_iri(std::string const& iri, Triple_store& store, Catalog const& cat) {
-   if( Catalog::doc_version_range r = cat.find_doc_version(iri) ) {
-      const Doc_id did = *r.begin();
-      Check_both check(cat.ontology_iri_str(did), cat.version_iri_str(did));
-      load_file(cat.path(did), store, cat, check);
-   } else if(Catalog::doc_iri_range r = cat.find_doc_iri(iri)) {
-      const Doc_id did = *r.begin();
-      Check_both check(cat.ontology_iri_str(did), cat.version_iri_str(did));
-      load_file(cat.path(did), store, cat, check);
-   } else BOOST_THROW_EXCEPTION(
-            Input_err()
-            << Input_err::msg_t("ontology not found")
-            << Input_err::str1_t(iri)
-   );
+void load_iri(
+         std::string const& iri,
+         Triple_store& store,
+         Catalog const& cat,
+         const unsigned n_threads
+) {
+   const Doc_id did = detail::find_import(iri, cat);
+   Check_both check(cat.ontology_iri_str(did), cat.version_iri_str(did));
+   load_file(cat.path(did), store, cat, check, n_threads);
 }
 
 }//namespace owlcpp
@@ -0,0 +1,47 @@
+/** @file "/owlcpp/lib/io/load_imports.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef LOAD_IMPORTS_HPP_
+#define LOAD_IMPORTS_HPP_
+#include <string>
+#include <vector>
+#include "boost/filesystem/path.hpp"
+#include "owlcpp/doc_id.hpp"
+
+namespace owlcpp{
+class Triple_store;
+class Catalog;
+
+namespace detail{
+
+/**@return catalog document with versionIRI or, if not found, ontologyIRI @b iri
+@throw Input_err if no such document is in the catalog
+*******************************************************************************/
+Doc_id find_import(std::string const& iri, Catalog const& cat);
+
+/**@return true if extension of @b file, ignoring compression extension,
+is that of N-Triples or N-Quads document
+*******************************************************************************/
+bool is_ntriples(boost::filesystem::path const& file);
+
+/**@brief Load import closure of ontology documents
+@details Documents are parsed concurrently but added to @b store depth-first
+in the order of import statements, same as when loading them one by one.
+@param iris ontologyIRIs or versionIRIs of imported ontologies
+@param store triple store; ontologies already present in it are skipped
+@param cat catalog of ontology documents used for locating imports
+@param n_threads maximal number of threads used for parsing imports
+@throw Input_err if an import cannot be found or parsed
+*******************************************************************************/
+void load_imports(
+         std::vector<std::string> iris,
+         Triple_store& store,
+         Catalog const& cat,
+         const unsigned n_threads
+);
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* LOAD_IMPORTS_HPP_ */
@@ -0,0 +1,199 @@
+/** @file "/owlcpp/lib/io/node_renderer.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NODE_RENDERER_HPP_
+#define NODE_RENDERER_HPP_
+#include <string>
+#include <vector>
+#include "boost/foreach.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/rdf/node_blank.hpp"
+#include "owlcpp/rdf/node_iri.hpp"
+#include "owlcpp/rdf/node_literal.hpp"
+#include "owlcpp/rdf/triple.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+#include "owlcpp/rdf/visitor_node.hpp"
+#include "owlcpp/terms/detail/max_standard_id.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Append decimal representation of @b n */
+inline void append_unsigned(std::string& s, unsigned n) {
+   char buff[16];
+   char* p = buff + sizeof(buff);
+   do {
+      *--p = static_cast<char>('0' + n % 10);
+      n /= 10;
+   } while( n );
+   s.append(p, buff + sizeof(buff));
+}
+
+/**@return true if @b s can be used as local part of Turtle prefixed name
+@details Conservative subset of Turtle PN_LOCAL grammar
+*******************************************************************************/
+inline bool is_local_name(boost::string_ref const& s) {
+   if( s.empty() || s[0] == '-' || s[0] == '.' || s[s.size() - 1] == '.' )
+      return false;
+   BOOST_FOREACH(const char c, s) {
+      if(
+               (c < 'a' || c > 'z') &&
+               (c < 'A' || c > 'Z') &&
+               (c < '0' || c > '9') &&
+               c != '_' && c != '-' && c != '.'
+      ) return false;
+   }
+   return true;
+}
+
+/**@brief Namespace IRI strings rendered once for all nodes
+*******************************************************************************/
+class Ns_strings {
+public:
+   explicit Ns_strings(Triple_store const& ts) {
+      for( unsigned n = 0; n != min_ns_id()(); ++n ) {
+         if( Ns_iri const* iri = ts.find(Ns_id(n)) ) add(ts, Ns_id(n), *iri);
+      }
+      BOOST_FOREACH(const Ns_id nsid, ts.map_ns()) add(ts, nsid, ts[nsid]);
+   }
+
+   /**@return "<" followed by namespace IRI */
+   std::string const& open(const Ns_id nsid) const {return open_[nsid()];}
+
+   /**@return "prefix:" or empty string if namespace has no prefix */
+   std::string const& prefix(const Ns_id nsid) const {return pref_[nsid()];}
+
+   /**@brief append Turtle prefix declarations */
+   void prefixes(std::string& s) const {
+      bool any = false;
+      for( std::size_t n = 0; n != pref_.size(); ++n ) {
+         if( pref_[n].empty() ) continue;
+         s += "@prefix ";
+         s += pref_[n];
+         s += ' ';
+         s += open_[n];
+         s += "#> .\n";
+         any = true;
+      }
+      if( any ) s += '\n';
+   }
+
+private:
+   std::vector<std::string> open_;
+   std::vector<std::string> pref_;
+
+   void add(Triple_store const& ts, const Ns_id nsid, Ns_iri const& iri) {
+      if( open_.size() <= nsid() ) {
+         open_.resize(nsid() + 1);
+         pref_.resize(nsid() + 1);
+      }
+      open_[nsid()] = '<' + iri.str();
+      if( ! is_iri(nsid) ) return;
+      const std::string pref = ts.prefix(nsid);
+      if( is_local_name(pref) ) pref_[nsid()] = pref + ':';
+   }
+};
+
+/**@brief Render triples as N-Triples or Turtle statements
+@details Statements are appended to a string without creating temporary
+strings for nodes.
+*******************************************************************************/
+class Node_renderer : public Visitor_node {
+public:
+   Node_renderer(
+            Triple_store const& ts,
+            Ns_strings const& ns,
+            const bool turtle,
+            std::string& out
+   )
+   : ts_(ts), ns_(ns), turtle_(turtle), out_(out)
+   {}
+
+   void triple(Triple const& t) {
+      node(t.subj_);
+      out_ += ' ';
+      node(t.pred_);
+      out_ += ' ';
+      node(t.obj_);
+      out_ += " .\n";
+   }
+
+   void node(const Node_id nid) {ts_[nid].accept(*this);}
+
+private:
+   Triple_store const& ts_;
+   Ns_strings const& ns_;
+   const bool turtle_;
+   std::string& out_;
+
+   void visit_impl(Node_iri const& node) {
+      const boost::string_ref frag = node.fragment();
+      if( turtle_ ) {
+         std::string const& pref = ns_.prefix(node.ns_id());
+         if( ! pref.empty() && is_local_name(frag) ) {
+            out_ += pref;
+            out_.append(frag.data(), frag.size());
+            return;
+         }
+      }
+      out_ += ns_.open(node.ns_id());
+      if( ! frag.empty() ) {
+         out_ += '#';
+         out_.append(frag.data(), frag.size());
+      }
+      out_ += '>';
+   }
+
+   void visit_impl(Node_blank const& node) {
+      out_ += "_:Doc";
+      append_unsigned(out_, node.document()());
+      out_ += '-';
+      append_unsigned(out_, node.index());
+   }
+
+   void visit_impl(Node_bool const& node) {literal(node);}
+   void visit_impl(Node_int const& node) {literal(node);}
+   void visit_impl(Node_unsigned const& node) {literal(node);}
+   void visit_impl(Node_double const& node) {literal(node);}
+
+   void visit_impl(Node_string const& node) {
+      quoted(node.value());
+      if( node.language().empty() ) {
+         datatype(node.datatype());
+      } else {
+         out_ += '@';
+         out_.append(node.language().data(), node.language().size());
+      }
+   }
+
+   void literal(Node_literal const& node) {
+      quoted(node.value_str());
+      datatype(node.datatype());
+   }
+
+   void datatype(const Node_id dt) {
+      if( is_empty(dt) ) return;
+      out_ += "^^";
+      node(dt);
+   }
+
+   void quoted(boost::string_ref const& s) {
+      out_ += '"';
+      BOOST_FOREACH(const char c, s) {
+         switch (c) {
+         case '"': out_ += "\\\""; break;
+         case '\\': out_ += "\\\\"; break;
+         case '\n': out_ += "\\n"; break;
+         case '\r': out_ += "\\r"; break;
+         default: out_ += c; break;
+         }
+      }
+      out_ += '"';
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NODE_RENDERER_HPP_ */
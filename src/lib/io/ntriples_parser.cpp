@@ -0,0 +1,271 @@
+/** @file "/owlcpp/lib/io/ntriples_parser.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "ntriples_parser.hpp"
+#include <algorithm>
+
+namespace owlcpp { namespace detail{ namespace{
+
+bool is_ws(const char c) {return c == ' ' || c == '\t' || c == '\r';}
+
+char const* skip_ws(char const* p, char const* const end) {
+   while( p != end && is_ws(*p) ) ++p;
+   return p;
+}
+
+bool is_lang_char(const char c) {
+   return
+            (c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9') ||
+            c == '-';
+}
+
+int hex_digit(const char c) {
+   if( c >= '0' && c <= '9' ) return c - '0';
+   if( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+   if( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+   return -1;
+}
+
+/** append UTF-8 encoding of code point @b cp */
+void append_utf8(std::string& s, const unsigned long cp) {
+   if( cp < 0x80 ) {
+      s += static_cast<char>(cp);
+   } else if( cp < 0x800 ) {
+      s += static_cast<char>(0xC0 | (cp >> 6));
+      s += static_cast<char>(0x80 | (cp & 0x3F));
+   } else if( cp < 0x10000 ) {
+      s += static_cast<char>(0xE0 | (cp >> 12));
+      s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      s += static_cast<char>(0x80 | (cp & 0x3F));
+   } else {
+      s += static_cast<char>(0xF0 | (cp >> 18));
+      s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      s += static_cast<char>(0x80 | (cp & 0x3F));
+   }
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+void Nt_parser::parse(
+         char const* first,
+         char const* last,
+         std::vector<Nt_statement>& v
+) {
+   for( char const* p = first; p != last; ) {
+      char const* const eol = std::find(p, last, '\n');
+      Nt_statement s;
+      if( line(p, eol, s) ) v.push_back(s);
+      p = eol == last ? last : eol + 1;
+   }
+}
+
+/*
+*******************************************************************************/
+bool Nt_parser::line(char const* p, char const* const end, Nt_statement& s) {
+   p = skip_ws(p, end);
+   if( p == end || *p == '#' ) return false;
+
+   char const* p0 = p;
+   p = skip_ws(term(p, end, s.subj_), end);
+   if( s.subj_.kind_ == Nt_term::Literal ) BOOST_THROW_EXCEPTION(
+            error(p0, "literal subject")
+   );
+
+   p0 = p;
+   p = skip_ws(term(p, end, s.pred_), end);
+   if( s.pred_.kind_ != Nt_term::Iri ) BOOST_THROW_EXCEPTION(
+            error(p0, "predicate is not IRI")
+   );
+
+   p = skip_ws(term(p, end, s.obj_), end);
+
+   if( p != end && *p != '.' ) {
+      p0 = p;
+      p = skip_ws(term(p, end, s.graph_), end);
+      if( s.graph_.kind_ == Nt_term::Literal ) BOOST_THROW_EXCEPTION(
+               error(p0, "literal graph label")
+      );
+   }
+
+   if( p == end || *p != '.' ) BOOST_THROW_EXCEPTION(
+            error(p, "expected '.'")
+   );
+   p = skip_ws(p + 1, end);
+   if( p != end && *p != '#' ) BOOST_THROW_EXCEPTION(
+            error(p, "unexpected characters after statement")
+   );
+   return true;
+}
+
+/*
+*******************************************************************************/
+char const* Nt_parser::term(char const* p, char const* const end, Nt_term& t) {
+   if( p == end ) BOOST_THROW_EXCEPTION(
+            error(p, "unexpected end of line")
+   );
+   switch (*p) {
+   case '<':
+      t.kind_ = Nt_term::Iri;
+      return iri(p, end, t.val_);
+   case '"':
+      t.kind_ = Nt_term::Literal;
+      return literal(p, end, t);
+   case '_': {
+      if( end - p < 3 || p[1] != ':' ) BOOST_THROW_EXCEPTION(
+               error(p, "invalid blank node label")
+      );
+      char const* const b = p + 2;
+      char const* e = b;
+      while( e != end && ! is_ws(*e) && *e != '<' && *e != '"' ) ++e;
+      //label cannot end with '.'
+      while( e != b && e[-1] == '.' ) --e;
+      if( e == b ) BOOST_THROW_EXCEPTION(
+               error(p, "invalid blank node label")
+      );
+      t.kind_ = Nt_term::Blank;
+      t.val_ = boost::string_ref(b, e - b);
+      return e;
+   }
+   default:
+      BOOST_THROW_EXCEPTION(error(p, "invalid term"));
+   }
+}
+
+/*
+*******************************************************************************/
+char const* Nt_parser::iri(
+         char const* p,
+         char const* const end,
+         boost::string_ref& s
+) {
+   char const* const b = p + 1;
+   for( char const* i = b; i != end; ++i ) {
+      switch (*i) {
+      case '>':
+         s = boost::string_ref(b, i - b);
+         return i + 1;
+      case '\\':
+         return unescape(b, end, '>', s);
+      case ' ':
+      case '<':
+      case '"':
+         BOOST_THROW_EXCEPTION(error(i, "invalid character in IRI"));
+      default:
+         break;
+      }
+   }
+   BOOST_THROW_EXCEPTION(error(p, "unterminated IRI"));
+}
+
+/*
+*******************************************************************************/
+char const* Nt_parser::literal(char const* p, char const* const end, Nt_term& t) {
+   char const* const b = p + 1;
+   char const* i = b;
+   while( i != end && *i != '"' && *i != '\\' ) ++i;
+   if( i == end ) BOOST_THROW_EXCEPTION(error(p, "unterminated literal"));
+   if( *i == '"' ) {
+      t.val_ = boost::string_ref(b, i - b);
+      p = i + 1;
+   } else {
+      p = unescape(b, end, '"', t.val_);
+   }
+
+   if( p != end && *p == '^' ) {
+      if( end - p < 3 || p[1] != '^' || p[2] != '<' ) BOOST_THROW_EXCEPTION(
+               error(p, "invalid datatype")
+      );
+      return iri(p + 2, end, t.dt_);
+   }
+
+   if( p != end && *p == '@' ) {
+      char const* const l = ++p;
+      while( p != end && is_lang_char(*p) ) ++p;
+      if( p == l ) BOOST_THROW_EXCEPTION(error(l, "empty language tag"));
+      t.lang_ = boost::string_ref(l, p - l);
+   }
+   return p;
+}
+
+/*
+*******************************************************************************/
+char const* Nt_parser::unescape(
+         char const* p,
+         char const* const end,
+         const char delim,
+         boost::string_ref& s
+) {
+   std::string u;
+   for( char const* i = p; i != end; ++i ) {
+      if( *i == delim ) {
+         str_.push_back(std::string());
+         str_.back().swap(u);
+         s = str_.back();
+         return i + 1;
+      }
+      if( *i != '\\' ) {
+         u += *i;
+         continue;
+      }
+      if( ++i == end ) break;
+      switch (*i) {
+      case 't': u += '\t'; break;
+      case 'b': u += '\b'; break;
+      case 'n': u += '\n'; break;
+      case 'r': u += '\r'; break;
+      case 'f': u += '\f'; break;
+      case '"': u += '"'; break;
+      case '\'': u += '\''; break;
+      case '\\': u += '\\'; break;
+      case 'u':
+      case 'U': {
+         const int n = *i == 'u' ? 4 : 8;
+         if( end - i <= n ) BOOST_THROW_EXCEPTION(
+                  error(i, "invalid escape sequence")
+         );
+         unsigned long cp = 0;
+         for( int k = 1; k <= n; ++k ) {
+            const int h = hex_digit(i[k]);
+            if( h < 0 ) BOOST_THROW_EXCEPTION(
+                     error(i, "invalid escape sequence")
+            );
+            cp = cp * 16 + h;
+         }
+         if( cp > 0x10FFFF ) BOOST_THROW_EXCEPTION(
+                  error(i, "invalid code point")
+         );
+         append_utf8(u, cp);
+         i += n;
+         break;
+      }
+      default:
+         BOOST_THROW_EXCEPTION(error(i, "invalid escape sequence"));
+      }
+   }
+   BOOST_THROW_EXCEPTION(error(
+            p - 1,
+            delim == '"' ? "unterminated literal" : "unterminated IRI"
+   ));
+}
+
+/*
+*******************************************************************************/
+Nt_parser::Err Nt_parser::error(char const* p, char const* msg) {
+   err_pos_ = p;
+   Err e;
+   e << Err::msg_t(msg);
+   return e;
+}
+
+}//namespace detail
+}//namespace owlcpp
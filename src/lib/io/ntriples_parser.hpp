@@ -0,0 +1,90 @@
+/** @file "/owlcpp/lib/io/ntriples_parser.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NTRIPLES_PARSER_HPP_
+#define NTRIPLES_PARSER_HPP_
+#include <deque>
+#include <string>
+#include <vector>
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/config.hpp"
+#include "owlcpp/io/exception.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief RDF term parsed from N-Triples or N-Quads line
+@details Strings refer either to the parsed text or, if they contained
+escape sequences, to unescaped copies kept by the parser.
+*******************************************************************************/
+struct Nt_term {
+   enum Kind {None, Iri, Blank, Literal};
+
+   Nt_term() : kind_(None) {}
+
+   Kind kind_;
+   boost::string_ref val_; ///< IRI, blank node label, or literal value
+   boost::string_ref dt_; ///< literal datatype IRI
+   boost::string_ref lang_; ///< literal language tag
+};
+
+/**@brief Statement parsed from N-Triples or N-Quads line
+@details Graph term kind is Nt_term::None for statements in default graph.
+*******************************************************************************/
+struct Nt_statement {
+   Nt_term subj_;
+   Nt_term pred_;
+   Nt_term obj_;
+   Nt_term graph_;
+};
+
+/**@brief Parse lines of N-Triples or N-Quads document
+@details Parsed statements refer to the input text and to the strings
+stored in the parser; they remain valid until the input is released or
+clear() is called.
+Each instance should be used by one thread at a time.
+*******************************************************************************/
+class OWLCPP_IO_DECL Nt_parser {
+public:
+   struct Err : public Input_err {};
+
+   Nt_parser() : err_pos_(0) {}
+
+   /**@brief parse complete lines in [@b first, @b last)
+    @param v parsed statements are appended here
+    @throw Err on syntax error; error_position() then points to the
+    offending character
+   */
+   void parse(char const* first, char const* last, std::vector<Nt_statement>& v);
+
+   /**@return position of the last syntax error or NULL */
+   char const* error_position() const {return err_pos_;}
+
+   /**@brief release unescaped strings and reset error position */
+   void clear() {
+      str_.clear();
+      err_pos_ = 0;
+   }
+
+private:
+   std::deque<std::string> str_;
+   char const* err_pos_;
+
+   bool line(char const* p, char const* const end, Nt_statement& s);
+   char const* term(char const* p, char const* const end, Nt_term& t);
+   char const* iri(char const* p, char const* const end, boost::string_ref& s);
+   char const* literal(char const* p, char const* const end, Nt_term& t);
+   char const* unescape(
+            char const* p,
+            char const* const end,
+            const char delim,
+            boost::string_ref& s
+   );
+   Err error(char const* p, char const* msg);
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NTRIPLES_PARSER_HPP_ */
@@ -0,0 +1,113 @@
+/** @file "/owlcpp/lib/io/ntriples_to_iri.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NTRIPLES_TO_IRI_HPP_
+#define NTRIPLES_TO_IRI_HPP_
+#include <limits>
+#include <string>
+#include <vector>
+#include "boost/foreach.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "owlcpp/terms/term_methods.hpp"
+#include "owlcpp/io/exception.hpp"
+#include "ntriples_parser.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Find ontologyIRI and versionIRI from N-Triples or N-Quads statements
+@details Same as Raptor_to_iri; only statements of the default graph are
+considered.
+*******************************************************************************/
+class Ntriples_to_iri {
+public:
+   typedef Input_err Err;
+
+   explicit Ntriples_to_iri(
+            const std::size_t search_depth = std::numeric_limits<std::size_t>::max()
+   )
+   : iri_(),
+     version_(),
+     max_depth_(search_depth),
+     n_(0),
+     done_(false)
+   {}
+
+   /**@brief parse complete lines in [@b first, @b last)
+    @return false if the search is finished
+   */
+   bool parse(char const* first, char const* last) {
+      v_.clear();
+      parser_.clear();
+      parser_.parse(first, last, v_);
+      BOOST_FOREACH(Nt_statement const& s, v_) {
+         if( s.graph_.kind_ == Nt_term::None ) insert(s);
+         if( done_ ) break;
+      }
+      return ! done_;
+   }
+
+   const std::string& iri() const {return iri_;}
+   const std::string& version() const {return version_;}
+
+private:
+   std::string iri_;
+   std::string version_;
+   const std::size_t max_depth_;
+   std::size_t n_;
+   bool done_;
+   Nt_parser parser_;
+   std::vector<Nt_statement> v_;
+
+   void insert(Nt_statement const& s) {
+      if( iri_.empty() && is_ontologyIRI(s) ) {
+         iri_ = s.subj_.val_.to_string();
+
+      } else if( is_versionIRI(s, iri_) ) {
+         version_ = s.obj_.val_.to_string();
+         done_ = true;
+
+      } else if( max_depth_ == n_++ ) {
+      //Early termination of the search for versionIRI triple
+      // to avoid reading large ontologies.
+         done_ = true;
+      }
+   }
+
+   template<class T> static bool is_term(Nt_term const& t, T const& tag) {
+      return
+               t.kind_ == Nt_term::Iri &&
+               comparison(t.val_.data(), t.val_.size(), tag);
+   }
+
+   static bool is_ontologyIRI(Nt_statement const& s) {
+      return
+               s.subj_.kind_ == Nt_term::Iri &&
+               is_term(s.obj_, terms::owl_Ontology()) &&
+               is_term(s.pred_, terms::rdf_type());
+   }
+
+   static bool is_versionIRI(Nt_statement const& s, std::string const& iri) {
+      if( iri.empty() ) return false;
+      if(
+               s.subj_.kind_ != Nt_term::Iri ||
+               s.obj_.kind_ != Nt_term::Iri ||
+               ! is_term(s.pred_, terms::owl_versionIRI())
+      ) return false;
+
+      if( s.subj_.val_ != boost::string_ref(iri) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid versionIRI statement")
+               << Err::str1_t(s.subj_.val_.to_string())
+               << Err::str2_t(iri)
+      );
+      return true;
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NTRIPLES_TO_IRI_HPP_ */
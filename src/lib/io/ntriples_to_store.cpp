@@ -0,0 +1,438 @@
+/** @file "/owlcpp/lib/io/ntriples_to_store.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "ntriples_to_store.hpp"
+#include <algorithm>
+#include "boost/assert.hpp"
+#include "boost/utility/string_ref.hpp"
+#include "boost/filesystem.hpp"
+#include "boost/foreach.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include "owlcpp/detail/parallel_for.hpp"
+#include "owlcpp/rdf/copy_triples.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "owlcpp/terms/term_methods.hpp"
+#include "decompressor.hpp"
+#include "doc_replacer.hpp"
+
+namespace owlcpp { namespace detail{ namespace{
+
+template<class T> bool is_term(Nt_term const& t, T const& tag) {
+   return
+            t.kind_ == Nt_term::Iri &&
+            comparison(t.val_.data(), t.val_.size(), tag);
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+Ntriples_to_store::Ntriples_to_store(
+         Triple_store& ts,
+         std::string const& path,
+         Check_id const& checker,
+         const unsigned n_threads,
+         const std::size_t chunk_size
+)
+: ts_(ts),
+  dest_(&ts),
+  temp_(),
+  replace_(false),
+  replaced_(),
+  path_(path),
+  checker_(checker),
+  n_threads_(n_threads_default(n_threads)),
+  chunk_size_(chunk_size ? chunk_size : 1),
+  direct_(),
+  docs_(),
+  graphs_(),
+  chunks_(),
+  imports_(),
+  ids_(),
+  begin_(0),
+  line_(0)
+{}
+
+/*
+*******************************************************************************/
+Ntriples_to_store::~Ntriples_to_store() {}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::start() {
+   direct_.reset(new Triple_store_direct(*dest_, path_));
+   docs_.assign(1, Doc(direct_->doc_id(), ""));
+   graphs_.clear();
+   imports_.clear();
+   ids_.clear();
+   line_ = 0;
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::end() {
+   docs_.clear();
+   graphs_.clear();
+   chunks_.clear();
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::parse(char const* first, char const* const last) {
+   start();
+   begin_ = first;
+   try{
+      while( first != last ) first = parse_batch(first, last);
+      finish();
+      direct_->commit();
+   } catch(...) {
+      direct_.reset();
+      end();
+      throw;
+   }
+   end();
+}
+
+/*
+Decompressed text is accumulated until it is large enough for a batch of
+chunks; incomplete last line is carried over to the next batch.
+*******************************************************************************/
+void Ntriples_to_store::parse_compressed(std::string const& file) {
+   Decompressor d(file);
+   start();
+   try{
+      std::vector<char> text;
+      const std::size_t batch_size = n_threads_ * chunk_size_;
+      for( bool more = true; more; ) {
+         const boost::string_ref s = d.next();
+         more = ! s.empty();
+         text.insert(text.end(), s.begin(), s.end());
+         if( text.empty() || (more && text.size() < batch_size) ) continue;
+
+         char const* first = &text[0];
+         char const* last = first + text.size();
+         if( more ) {
+            while( last != first && last[-1] != '\n' ) --last;
+            if( last == first ) continue;
+         }
+         begin_ = first;
+         for( char const* p = first; p != last; ) p = parse_batch(p, last);
+         line_ += std::count(first, last, '\n');
+         text.erase(text.begin(), text.begin() + (last - first));
+      }
+      finish();
+      direct_->commit();
+   } catch(...) {
+      direct_.reset();
+      end();
+      throw;
+   }
+   end();
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::parse_file(std::string const& file) {
+   namespace bip = boost::interprocess;
+   boost::system::error_code ec;
+   const boost::uintmax_t size = boost::filesystem::file_size(file, ec);
+   if( ec ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("read error")
+            << Err::str1_t(file)
+   );
+   if( ! size ) {
+      parse(0, 0);
+      return;
+   }
+   if( Decompressor::compressed(file) ) {
+      parse_compressed(file);
+      return;
+   }
+
+   bip::file_mapping fm;
+   bip::mapped_region mr;
+   try{
+      bip::file_mapping(file.c_str(), bip::read_only).swap(fm);
+      bip::mapped_region(fm, bip::read_only).swap(mr);
+   } catch(bip::interprocess_exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error mapping file")
+               << Err::str1_t(file)
+               << Err::nested_t(boost::current_exception())
+      );
+   }
+   mr.advise(bip::mapped_region::advice_sequential);
+   char const* const p = static_cast<char const*>(mr.get_address());
+   parse(p, p + mr.get_size());
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::read_file(std::string const& file) {
+   temp_.reset(new Triple_store(ts_.map_std()));
+   dest_ = temp_.get();
+   try{
+      parse_file(file);
+   } catch(...) {
+      dest_ = &ts_;
+      temp_.reset();
+      throw;
+   }
+   dest_ = &ts_;
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::merge() {
+   BOOST_ASSERT( temp_.get() );
+   BOOST_FOREACH(ids_t::value_type const& p, ids_) {
+      check_loaded(p.first, p.second);
+   }
+   if( ! replace_ ) {
+      copy_triples(*temp_, ts_);
+   } else if( temp_->map_doc().size() == 1 ) {
+      replace_doc(ts_, replaced_, *temp_, *temp_->map_doc().begin());
+   } else {
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("document with named graphs cannot replace another one")
+               << Err::str1_t(path_)
+      );
+   }
+   temp_.reset();
+}
+
+/*
+Split text into up to n_threads_ chunks ending at line boundaries,
+parse them concurrently, and insert the statements in document order.
+*******************************************************************************/
+char const* Ntriples_to_store::parse_batch(
+         char const* first,
+         char const* const last
+) {
+   chunks_.resize(n_threads_);
+   std::size_t n = 0;
+   for( ; n != n_threads_ && first != last; ++n ) {
+      Chunk& c = chunks_[n];
+      char const* e = static_cast<std::size_t>(last - first) > chunk_size_ ?
+               first + chunk_size_ : last;
+      e = std::find(e, last, '\n');
+      if( e != last ) ++e;
+      c.first_ = first;
+      c.last_ = e;
+      c.parser_.clear();
+      c.v_.clear();
+      first = e;
+   }
+
+   Parse_chunks pc(chunks_);
+   try{
+      parallel_for(n, pc, n_threads_);
+   } catch(Nt_parser::Err const&) {
+      syntax_error(n);
+   }
+
+   for( std::size_t i = 0; i != n; ++i ) {
+      BOOST_FOREACH(Nt_statement const& s, chunks_[i].v_) insert(s);
+   }
+   return first;
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::syntax_error(const std::size_t n) {
+   for( std::size_t i = 0; i != n; ++i ) {
+      char const* const p = chunks_[i].parser_.error_position();
+      if( ! p ) continue;
+      const int line = static_cast<int>(line_ + std::count(begin_, p, '\n')) + 1;
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error parsing")
+               << Err::str1_t(path_)
+               << Err::int1_t(line)
+               << Err::nested_t(boost::current_exception())
+      );
+   }
+   throw;
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::insert(Nt_statement const& s) {
+   Doc& d = doc(s.graph_);
+   const Node_id subj = node(s.subj_, d);
+   const Node_id pred = node(s.pred_, d);
+   const Node_id obj = node(s.obj_, d);
+   direct_->insert_triple(subj, pred, obj, d.did_);
+   ++d.n_;
+
+   //only the default graph document is identified by its statements
+   if( &d != &docs_.front() ) return;
+   if(
+            s.subj_.kind_ != Nt_term::Iri ||
+            s.obj_.kind_ != Nt_term::Iri
+   ) return;
+   if(
+            d.iri_.empty() &&
+            is_term(s.obj_, terms::owl_Ontology()) &&
+            is_term(s.pred_, terms::rdf_type())
+   ) {
+      d.iri_ = s.subj_.val_.to_string();
+      d.iri_id_ = subj;
+   } else if( is_term(s.pred_, terms::owl_versionIRI()) ) {
+      d.versions_.push_back(std::make_pair(subj, s.obj_.val_.to_string()));
+   } else if( is_term(s.pred_, terms::owl_imports()) ) {
+      d.imports_.push_back(std::make_pair(subj, s.obj_.val_.to_string()));
+   }
+}
+
+/*
+*******************************************************************************/
+Ntriples_to_store::Doc& Ntriples_to_store::doc(Nt_term const& graph) {
+   switch (graph.kind_) {
+   case Nt_term::None:
+      return docs_.front();
+   case Nt_term::Iri: {
+      const graph_map_t::const_iterator i = graphs_.find(graph.val_);
+      if( i != graphs_.end() ) return *i->second;
+      const std::string iri = graph.val_.to_string();
+      docs_.push_back(Doc(direct_->add_doc(path_ + '#' + iri), iri));
+      Doc& d = docs_.back();
+      d.iri_id_ = direct_->insert_node_iri(d.iri_);
+      graphs_.emplace(boost::string_ref(d.iri_), &d);
+      return d;
+   }
+   default:
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("unsupported graph label")
+               << Err::str1_t(path_)
+               << Err::str2_t(graph.val_.to_string())
+      );
+   }
+}
+
+/*
+*******************************************************************************/
+Node_id Ntriples_to_store::node(Nt_term const& t, Doc& d) {
+   switch (t.kind_) {
+   case Nt_term::Iri:
+      return direct_->insert_node_iri(t.val_);
+   case Nt_term::Blank: {
+      blank_map_t::const_iterator i =
+               d.blanks_.find(t.val_, String_ref_hash(), String_ref_equal());
+      if( i == d.blanks_.end() ) {
+         i = d.blanks_.emplace(t.val_.to_string(), d.blanks_.size()).first;
+      }
+      return direct_->insert_blank(i->second, d.did_);
+   }
+   case Nt_term::Literal: {
+      const Node_id dt = t.dt_.empty() ?
+               terms::empty_::id() : direct_->insert_node_iri(t.dt_);
+      return direct_->insert_literal(t.val_, dt, t.lang_);
+   }
+   default:
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("unknown node type")
+      );
+   }
+}
+
+/*
+Validate and set document IDs.
+*******************************************************************************/
+void Ntriples_to_store::finish() {
+   Doc& d = docs_.front();
+   if( ! d.n_ && docs_.size() > 1 ) {
+      direct_->drop_doc(d.did_);
+   } else {
+      std::string version;
+      BOOST_FOREACH(iri_stmt_t::value_type const& p, d.versions_) {
+         if( d.iri_.empty() ) break;
+         if( p.first != d.iri_id_ ) BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("invalid versionIRI statement")
+                  << Err::str1_t(path_)
+                  << Err::str2_t(d.iri_)
+         );
+         if( version.empty() ) version = p.second;
+      }
+
+      BOOST_FOREACH(iri_stmt_t::value_type const& p, d.imports_) {
+         if( p.first != d.iri_id_ ) BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("invalid subject in imports triple")
+                  << Err::str1_t(path_)
+                  << Err::str2_t(d.iri_)
+         );
+         imports_.push_back(p.second);
+      }
+
+      try{
+         checker_(d.iri_, version);
+      } catch(Check_id::Err const&) {
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("error parsing")
+                  << Err::str1_t(path_)
+                  << Err::nested_t(boost::current_exception())
+         );
+      }
+      check_loaded(d.iri_, version);
+      direct_->set_ids(d.iri_, version);
+      ids_.push_back(std::make_pair(d.iri_, version));
+   }
+
+   for( std::size_t i = 1; i != docs_.size(); ++i ) {
+      Doc const& g = docs_[i];
+      if( g.iri_ == d.iri_ ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("graph IRI is same as ontologyIRI")
+               << Err::str1_t(path_)
+               << Err::str2_t(g.iri_)
+      );
+      check_loaded(g.iri_, "");
+      direct_->set_ids(g.iri_id_, terms::empty_::id(), g.did_);
+      ids_.push_back(std::make_pair(g.iri_, std::string()));
+   }
+}
+
+/*
+*******************************************************************************/
+void Ntriples_to_store::check_loaded(
+         std::string const& iri,
+         std::string const& version
+) const {
+   if( ! version.empty() && loaded(version) ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("versionIRI already loaded")
+            << Err::str1_t(version)
+   );
+   if( loaded(iri) ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("ontologyIRI already loaded")
+            << Err::str1_t(iri)
+   );
+}
+
+/*
+*******************************************************************************/
+bool Ntriples_to_store::loaded(std::string const& iri) const {
+   BOOST_FOREACH(const Doc_id did, ts_.find_doc_iri(iri)) {
+      if( ! replace_ || did != replaced_ ) return true;
+   }
+   return false;
+}
+
+}//namespace detail
+}//namespace owlcpp
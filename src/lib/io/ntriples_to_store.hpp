@@ -0,0 +1,195 @@
+/** @file "/owlcpp/lib/io/ntriples_to_store.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef NTRIPLES_TO_STORE_HPP_
+#define NTRIPLES_TO_STORE_HPP_
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "boost/functional/hash.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/unordered_map.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/check_ontology_id.hpp"
+#include "owlcpp/io/exception.hpp"
+#include "ntriples_parser.hpp"
+#include "triple_store_direct.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Hash strings referred to by boost::string_ref
+*******************************************************************************/
+struct String_ref_hash {
+   std::size_t operator()(boost::string_ref const& s) const {
+      return boost::hash_range(s.begin(), s.end());
+   }
+};
+
+/**@brief Compare strings referred to by boost::string_ref
+*******************************************************************************/
+struct String_ref_equal {
+   bool operator()(boost::string_ref const& s1, boost::string_ref const& s2) const {
+      return s1 == s2;
+   }
+};
+
+/**@brief Parse N-Triples or N-Quads document into triple store
+@details The text is split at line boundaries into chunks that are parsed
+concurrently.
+Parsed statements of each batch of chunks are then inserted, in document
+order, directly into the destination store.
+@n Statements of the default graph belong to a document whose ontologyIRI and
+versionIRI are found from its @c owl:Ontology and @c owl:versionIRI
+statements, as for other formats.
+Each named graph of N-Quads document becomes a separate document;
+its ontologyIRI is the graph IRI and its path is the document path followed
+by @c '#' and the graph IRI.
+Blank node labels are scoped to the documents.
+@n Compressed files are decompressed in a separate thread and parsed in
+batches of complete lines.
+@n If parsing fails, the destination store remains unchanged.
+@n read_file() parses into temporary storage, which is copied into the
+destination store by merge().
+*******************************************************************************/
+class OWLCPP_IO_DECL Ntriples_to_store : boost::noncopyable {
+   struct Chunk {
+      Chunk() : first_(0), last_(0) {}
+      char const* first_;
+      char const* last_;
+      Nt_parser parser_;
+      std::vector<Nt_statement> v_;
+   };
+
+   class Parse_chunks {
+   public:
+      explicit Parse_chunks(std::vector<Chunk>& c) : c_(c) {}
+      void operator()(const std::size_t i) {
+         c_[i].parser_.parse(c_[i].first_, c_[i].last_, c_[i].v_);
+      }
+   private:
+      std::vector<Chunk>& c_;
+   };
+
+   /* labels are copied since parsed text may be discarded before the end
+   of document */
+   typedef boost::unordered_map<
+            std::string, unsigned, String_ref_hash, String_ref_equal
+   > blank_map_t;
+
+   typedef std::vector<std::pair<Node_id, std::string> > iri_stmt_t;
+
+   struct Doc {
+      Doc(const Doc_id did, std::string const& iri)
+      : did_(did), n_(0), iri_(iri), iri_id_(terms::empty_::id())
+      {}
+      Doc_id did_;
+      std::size_t n_; ///< number of triples
+      std::string iri_;
+      Node_id iri_id_;
+      blank_map_t blanks_;
+      iri_stmt_t versions_; ///< subjects and objects of owl:versionIRI
+      iri_stmt_t imports_; ///< subjects and objects of owl:imports
+   };
+
+   typedef boost::unordered_map<boost::string_ref, Doc*, String_ref_hash> graph_map_t;
+
+   typedef std::vector<std::pair<std::string, std::string> > ids_t;
+
+public:
+   typedef Input_err Err;
+
+   static std::size_t default_chunk_size() {return 1 << 22;}
+
+   /**
+    @param ts destination triple store
+    @param path document location
+    @param checker checks ontologyIRI and versionIRI of the default graph
+    @param n_threads maximal number of parsing threads; 0 selects the number
+    of hardware threads
+    @param chunk_size approximate number of bytes parsed by one thread at a time
+   */
+   Ntriples_to_store(
+            Triple_store& ts,
+            std::string const& path,
+            Check_id const& checker,
+            const unsigned n_threads = 0,
+            const std::size_t chunk_size = default_chunk_size()
+   );
+
+   ~Ntriples_to_store();
+
+   /**@brief parse text in [@b first, @b last)
+    @throw Err if parsing fails; the destination store then remains unchanged
+   */
+   void parse(char const* first, char const* last);
+
+   /**@brief parse memory-mapped or compressed @b file, same as parse() */
+   void parse_file(std::string const& file);
+
+   /**@brief parse memory-mapped or compressed @b file into temporary storage
+    without modifying the destination store
+    @details Several instances may read concurrently as long as the
+    destination store is not being modified.
+   */
+   void read_file(std::string const& file);
+
+   /**@brief copy documents obtained by read_file() into the destination store
+    @throw Err if ontology with same ID has been loaded after read_file()
+    @details If copying fails, the replaced document is restored.
+   */
+   void merge();
+
+   /**@brief replace document @b did by the parsed one when calling merge()
+    @details The parsed document may have same ontologyIRI and versionIRI
+    as @b did; it is added under ID @b did.
+    Documents with N-Quads named graphs cannot replace another document.
+    Must be called before read_file().
+   */
+   void replace(const Doc_id did) {
+      replace_ = true;
+      replaced_ = did;
+   }
+
+   /**@return IRIs imported by the default graph document */
+   std::vector<std::string> const& imports() const {return imports_;}
+
+private:
+   Triple_store& ts_;
+   Triple_store* dest_; ///< store being parsed into
+   std::auto_ptr<Triple_store> temp_;
+   bool replace_;
+   Doc_id replaced_;
+   const std::string path_;
+   Check_id const& checker_;
+   const unsigned n_threads_;
+   const std::size_t chunk_size_;
+   std::auto_ptr<Triple_store_direct> direct_;
+   std::deque<Doc> docs_;
+   graph_map_t graphs_;
+   std::vector<Chunk> chunks_;
+   std::vector<std::string> imports_;
+   ids_t ids_; ///< ontologyIRIs and versionIRIs of parsed documents
+   char const* begin_; ///< start of text for counting lines
+   std::size_t line_; ///< number of lines before begin_
+
+   void start();
+   void end();
+   void parse_compressed(std::string const& file);
+   char const* parse_batch(char const* first, char const* const last);
+   void syntax_error(const std::size_t n);
+   void insert(Nt_statement const& s);
+   Doc& doc(Nt_term const& graph);
+   Node_id node(Nt_term const& t, Doc& d);
+   void finish();
+   void check_loaded(std::string const& iri, std::string const& version) const;
+   bool loaded(std::string const& iri) const;
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* NTRIPLES_TO_STORE_HPP_ */
@@ -5,15 +5,22 @@ part of owlcpp project.
 *******************************************************************************/
 #ifndef RAPTOR_TO_STORE_HPP_
 #define RAPTOR_TO_STORE_HPP_
+#include <memory>
 #include <string>
 #include <vector>
 #include <iosfwd>
 #include "boost/bind.hpp"
+#include "boost/foreach.hpp"
 #include "boost/function.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/utility/string_ref.hpp"
 
 #include "owlcpp/io/exception.hpp"
+#include "doc_replacer.hpp"
 #include "raptor_to_iri.hpp"
+#include "raptor_uri_cache.hpp"
+#include "statement_pipeline.hpp"
+#include "triple_store_direct.hpp"
 #include "triple_store_temp.hpp"
 #include "owlcpp/io/raptor_wrapper.hpp"
 #include "owlcpp/io/check_ontology_id.hpp"
@@ -22,15 +29,28 @@ part of owlcpp project.
 
 namespace owlcpp{ namespace detail{
 
-/**@brief
+/**@brief Parse RDF document into triple store
+@details parse() and parse_file() insert nodes directly into the destination
+store and remove them if parsing fails.
+read() and read_file() parse into temporary storage, which is copied into
+the destination store by merge().
+parse_file_pipelined() overlaps parsing with node interning.
 *******************************************************************************/
 class Raptor_to_store {
 public:
    typedef Input_err Err;
+   /**
+    @param ts destination triple store
+    @param path document location
+    @param checker checks ontologyIRI and versionIRI
+    @param uri_cache_size maximal number of URI terms for which node IDs are
+    remembered during parsing; 0 disables caching
+   */
    Raptor_to_store(
             Triple_store& ts,
             std::string const& path,
-            Check_id const& checker
+            Check_id const& checker,
+            const std::size_t uri_cache_size = Raptor_uri_cache::default_size()
    )
    : ts_(ts),
      parser_(),
@@ -38,27 +58,131 @@ public:
      checker_(checker),
      rti_(boost::bind(&Raptor_to_store::id_found, this)),
      id_found_(false),
-     tst_(ts_.map_std(), path)
+     replace_(false),
+     replaced_(),
+     tst_(ts_.map_std(), path),
+     direct_(),
+     pipeline_(),
+     imports_(),
+     uri_cache_(uri_cache_size)
    {}
 
    void insert(void const* statement) {
       if( ! id_found_ ) rti_.insert(statement);
       raptor_statement const& rs = *static_cast<raptor_statement const*>(statement);
       check_import(rs);
-      const Node_id subj = insert_node(*rs.subject);
-      const Node_id pred = insert_node(*rs.predicate);
-      const Node_id obj = insert_node(*rs.object);
-      tst_.insert_triple(subj, pred, obj);
+      if( pipeline_ ) {
+         Statement_block& b = pipeline_->block();
+         record(*rs.subject, b);
+         record(*rs.predicate, b);
+         record(*rs.object, b);
+         if( b.full() && ! pipeline_->push() ) abort_call_();
+      }
+      else if( direct_.get() ) insert(rs, *direct_);
+      else insert(rs, tst_);
    }
 
    const std::string& iri() const {return rti_.iri();}
    const std::string& version() const {return rti_.version();}
    std::vector<std::string> const& imports() const {return imports_;}
 
+   /** Parse @b stream directly into the destination triple store
+    @throw Err if parsing fails; the destination store then remains unchanged
+   */
    void parse(std::istream& stream) {
+      direct_.reset(new Triple_store_direct(ts_, tst_.path()));
+      try{
+         parser_(stream, *this);
+         if( ! id_found_ ) id_found();
+         direct_->commit();
+      } catch(...) {
+         direct_.reset();
+         throw;
+      }
+   }
+
+   /** Parse @b stream into temporary storage without modifying the
+    destination triple store.
+    Several instances may read concurrently as long as the destination store
+    is not being modified.
+   */
+   void read(std::istream& stream) {
       parser_(stream, *this);
       if( ! id_found_ ) id_found();
-      copy_triples(tst_, ts_);
+   }
+
+   /** Parse memory-mapped @b file into temporary storage, same as read() */
+   void read_file(std::string const& file) {
+      parser_.parse_mapped(file, *this);
+      if( ! id_found_ ) id_found();
+   }
+
+   /** Parse memory-mapped @b file directly into the destination triple store,
+    same as parse()
+   */
+   void parse_file(std::string const& file) {
+      direct_.reset(new Triple_store_direct(ts_, tst_.path()));
+      try{
+         parser_.parse_mapped(file, *this);
+         if( ! id_found_ ) id_found();
+         direct_->commit();
+      } catch(...) {
+         direct_.reset();
+         throw;
+      }
+   }
+
+   /** Parse memory-mapped @b file directly into the destination triple store,
+    same as parse_file().
+    Parser thread only copies statements into blocks of compact records,
+    which are passed to another thread that inserts their nodes and triples.
+    The triples are indexed when the document is committed.
+    Since the destination store is modified by the consumer thread during
+    parsing, whether an ontology with same ID is already loaded is checked
+    after the consumer has finished.
+   */
+   void parse_file_pipelined(std::string const& file) {
+      direct_.reset(new Triple_store_direct(ts_, tst_.path()));
+      try{
+         {
+            Statement_pipeline sp(boost::bind(&Raptor_to_store::consume, this, _1));
+            pipeline_ = &sp;
+            parser_.parse_mapped(file, *this);
+            if( ! id_found_ ) id_found();
+            sp.finish();
+            pipeline_ = 0;
+         }
+         check_loaded( rti_.iri(), rti_.version() );
+         direct_->set_ids(rti_.iri(), rti_.version());
+         direct_->commit();
+      } catch(...) {
+         pipeline_ = 0;
+         direct_.reset();
+         throw;
+      }
+   }
+
+   /** Copy triples obtained by read() into the destination triple store
+    @throw Err if ontology with same ID has been loaded after read()
+    @details If copying fails, the replaced document is restored.
+   */
+   void merge() {
+      check_loaded( rti_.iri(), rti_.version() );
+      if( ! replace_ ) {
+         copy_triples(tst_, ts_);
+         return;
+      }
+      replace_doc(ts_, replaced_, tst_, Doc_id(0));
+   }
+
+   /** Replace document @b did by the parsed one when calling merge().
+    The parsed document may have same ontologyIRI and versionIRI as @b did;
+    it is added under ID @b did.
+    Must be called before read().
+   */
+   void replace(const Doc_id did) {
+      replace_ = true;
+      replaced_ = did;
    }
 
 private:
@@ -68,20 +192,28 @@ private:
    Check_id const& checker_;
    Raptor_to_iri rti_;
    bool id_found_;
+   bool replace_;
+   Doc_id replaced_;
    Triple_store_temp tst_;
+   std::auto_ptr<Triple_store_direct> direct_;
+   Statement_pipeline* pipeline_;
    std::vector<std::string> imports_;
+   Raptor_uri_cache uri_cache_; /**< destroyed before parser_ */
 
    /** This method is called when ontologyIRI and (possibly) versionIRI statements
     are encountered during parsing.
     Check ontologyIRI and versionIRI with instance of Check_id.
     Check if ontology with same ID has already been loaded.
     Set ontologyIRI and versionIRI to temporary triple store.
+    In pipelined mode, loaded ontologies are checked and IDs are set after
+    the consumer thread has finished.
    */
    void id_found() {
       try{
          checker_(rti_.iri(), rti_.version());
-         check_loaded( rti_.iri(), rti_.version() );
-         tst_.set_ids(rti_.iri(), rti_.version());
+         if( ! pipeline_ ) check_loaded( rti_.iri(), rti_.version() );
+         if( ! direct_.get() ) tst_.set_ids(rti_.iri(), rti_.version());
+         else if( ! pipeline_ ) direct_->set_ids(rti_.iri(), rti_.version());
       } catch(Check_id::Err e) {
          abort_call_();
          BOOST_THROW_EXCEPTION(
@@ -131,26 +263,123 @@ private:
     has already been loaded
    */
    void check_loaded(std::string const& iri, std::string const& version) const {
-      if( ! version.empty() && ts_.find_doc_iri(version) ) BOOST_THROW_EXCEPTION(
+      if( ! version.empty() && loaded(version) ) BOOST_THROW_EXCEPTION(
                Err()
                << Err::msg_t("versionIRI already loaded")
                << Err::str1_t(version)
       );
-      if( ts_.find_doc_iri(iri) ) BOOST_THROW_EXCEPTION(
+      if( loaded(iri) ) BOOST_THROW_EXCEPTION(
                Err()
                << Err::msg_t("ontologyIRI already loaded")
                << Err::str1_t(iri)
       );
    }
 
-   Node_id insert_node(raptor_term const& node) {
+   /** @return true if a document other than the replaced one has @b iri */
+   bool loaded(std::string const& iri) const {
+      BOOST_FOREACH(const Doc_id did, ts_.find_doc_iri(iri)) {
+         if( ! replace_ || did != replaced_ ) return true;
+      }
+      return false;
+   }
+
+   /** Copy term into block of statement records; called in parser thread */
+   static void record(raptor_term const& node, Statement_block& b) {
+      switch (node.type) {
+      case RAPTOR_TERM_TYPE_URI: {
+         std::size_t len;
+         char const* str = reinterpret_cast<char const*>(
+                  raptor_uri_as_counted_string(node.value.uri, &len)
+         );
+         b.add_iri(str, len);
+         return;
+      }
+      case RAPTOR_TERM_TYPE_LITERAL: {
+         raptor_term_literal_value const& val = node.value.literal;
+         boost::string_ref dt, lang;
+         if( val.datatype ) {
+            std::size_t len;
+            char const* str = reinterpret_cast<char const*>(
+                     raptor_uri_as_counted_string(val.datatype, &len)
+            );
+            dt = boost::string_ref(str, len);
+         }
+         if( val.language ) lang = boost::string_ref(
+                  reinterpret_cast<char const*>(val.language), val.language_len
+         );
+         b.add_literal(
+                  boost::string_ref(
+                           reinterpret_cast<char const*>(val.string),
+                           val.string_len
+                  ),
+                  dt,
+                  lang
+         );
+         return;
+      }
+      case RAPTOR_TERM_TYPE_BLANK: {
+         char const* val_str =
+                  reinterpret_cast<char const*>(node.value.blank.string);
+         b.add_blank(boost::lexical_cast<unsigned>(
+                  val_str + Raptor_wrapper::blank_prefix().size()
+         ));
+         return;
+      }
+      default:
+         BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("unknown node type")
+            );
+      }
+   }
+
+   /** Insert recorded statements; called in consumer thread */
+   void consume(Statement_block const& b) {
+      for( std::size_t n = 0; n != b.size(); ++n ) {
+         const Node_id subj = insert_node(b, b.term(n, 0));
+         const Node_id pred = insert_node(b, b.term(n, 1));
+         const Node_id obj = insert_node(b, b.term(n, 2));
+         direct_->insert_triple(subj, pred, obj);
+      }
+   }
+
+   Node_id insert_node(Statement_block const& b, Term_rec const& t) {
+      switch (t.kind_) {
+      case Term_rec::Iri:
+         return direct_->insert_node_iri(b.str(t.val_, t.val_len_));
+      case Term_rec::Blank:
+         return direct_->insert_blank(t.blank_);
+      case Term_rec::Literal: {
+         const Node_id dt = t.dt_len_ ?
+                  direct_->insert_node_iri(b.str(t.dt_, t.dt_len_)) :
+                  terms::empty_::id();
+         return direct_->insert_literal(
+                  b.str(t.val_, t.val_len_), dt, b.str(t.lang_, t.lang_len_)
+         );
+      }
+      default:
+         BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("unknown node type")
+            );
+      }
+   }
+
+   template<class Dest> void insert(raptor_statement const& rs, Dest& dest) {
+      const Node_id subj = insert_node(*rs.subject, dest);
+      const Node_id pred = insert_node(*rs.predicate, dest);
+      const Node_id obj = insert_node(*rs.object, dest);
+      dest.insert_triple(subj, pred, obj);
+   }
+
+   template<class Dest> Node_id insert_node(raptor_term const& node, Dest& dest) {
       switch (node.type) {
       case RAPTOR_TERM_TYPE_URI:
-         return insert_node(node.value.uri);
+         return insert_node(node.value.uri, dest);
       case RAPTOR_TERM_TYPE_LITERAL:
-         return insert_node(node.value.literal);
+         return insert_node(node.value.literal, dest);
       case RAPTOR_TERM_TYPE_BLANK:
-         return insert_node(node.value.blank);
+         return insert_node(node.value.blank, dest);
       default:
          BOOST_THROW_EXCEPTION(
                   Input_err()
@@ -159,38 +388,39 @@ private:
       }
    }
 
-   Node_id insert_node(raptor_term_blank_value const& val) {
+   template<class Dest>
+   Node_id insert_node(raptor_term_blank_value const& val, Dest& dest) {
       char const* val_str = reinterpret_cast<char const*>(val.string);
       const unsigned n = boost::lexical_cast<unsigned>(
                val_str + Raptor_wrapper::blank_prefix().size()
       );
-      return tst_.insert_blank(n);
+      return dest.insert_blank(n);
    }
 
-   Node_id insert_node(raptor_term_literal_value const& val) {
-      std::string type;
-      if( val.datatype ) {
-         std::size_t len;
-         char const* str = reinterpret_cast<char const*>(
-                  raptor_uri_as_counted_string(val.datatype, &len)
-         );
-         type.assign(str, len);
-      }
-
-      char const* lang_str = reinterpret_cast<char const*>(val.language);
-      const std::string lang =
-               val.language ? std::string(lang_str, val.language_len) : "";
+   template<class Dest>
+   Node_id insert_node(raptor_term_literal_value const& val, Dest& dest) {
+      boost::string_ref lang;
+      if( val.language ) lang = boost::string_ref(
+               reinterpret_cast<char const*>(val.language), val.language_len
+      );
 
+      const Node_id dt = val.datatype ?
+               insert_node(val.datatype, dest) : terms::empty_::id();
       char const* val_str = reinterpret_cast<char const*>(val.string);
-      return tst_.insert_literal( std::string(val_str, val.string_len), type, lang );
+      return dest.insert_literal(
+               boost::string_ref(val_str, val.string_len), dt, lang
+      );
    }
 
-   Node_id insert_node(raptor_uri* val) {
+   template<class Dest> Node_id insert_node(raptor_uri* val, Dest& dest) {
+      if( Node_id const* id = uri_cache_.find(val) ) return *id;
       std::size_t len;
       char const* str = reinterpret_cast<char const*>(
                raptor_uri_as_counted_string(val, &len)
       );
-      return tst_.insert_node_iri(std::string(str, len));
+      const Node_id id = dest.insert_node_iri(boost::string_ref(str, len));
+      uri_cache_.insert(val, id);
+      return id;
    }
 
 };
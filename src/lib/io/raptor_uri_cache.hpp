@@ -0,0 +1,65 @@
+/** @file "/owlcpp/lib/io/raptor_uri_cache.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef RAPTOR_URI_CACHE_HPP_
+#define RAPTOR_URI_CACHE_HPP_
+#include "boost/foreach.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "raptor2.h"
+
+#include "owlcpp/node_id.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Map raptor URI pointers to node IDs
+@details Raptor interns URIs within one world, so repeated terms of a document
+are represented by same raptor_uri pointers.
+A reference is held to every cached URI, so that its address cannot be
+reused by raptor for a different URI.
+The cache is emptied when it reaches maximal size.
+Cached URIs are released on destruction; the cache should be destroyed
+before the raptor world.
+*******************************************************************************/
+class Raptor_uri_cache : boost::noncopyable {
+   typedef boost::unordered_map<raptor_uri*, Node_id> map_t;
+
+public:
+   static std::size_t default_size() {return 4096;}
+
+   /**@param max_size maximal number of cached URIs; 0 disables caching */
+   explicit Raptor_uri_cache(const std::size_t max_size = default_size())
+   : map_(), max_size_(max_size)
+   {}
+
+   ~Raptor_uri_cache() {clear();}
+
+   std::size_t size() const {return map_.size();}
+
+   Node_id const* find(raptor_uri* uri) const {
+      const map_t::const_iterator i = map_.find(uri);
+      return i == map_.end() ? 0 : &i->second;
+   }
+
+   void insert(raptor_uri* uri, const Node_id id) {
+      if( ! max_size_ ) return;
+      if( map_.size() >= max_size_ ) clear();
+      if( map_.emplace(uri, id).second ) raptor_uri_copy(uri);
+   }
+
+   void clear() {
+      BOOST_FOREACH(map_t::value_type const& p, map_) raptor_free_uri(p.first);
+      map_.clear();
+   }
+
+private:
+   map_t map_;
+   std::size_t max_size_;
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* RAPTOR_URI_CACHE_HPP_ */
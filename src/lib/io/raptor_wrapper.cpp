@@ -7,9 +7,15 @@ part of owlcpp project.
 #define OWLCPP_IO_SOURCE
 #endif
 #include "owlcpp/io/raptor_wrapper.hpp"
+#include <algorithm>
 #include <istream>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
 #include "boost/lexical_cast.hpp"
 #include "raptor2.h"
+#include "decompressor.hpp"
 
 namespace owlcpp { namespace{
 
@@ -35,9 +41,10 @@ void handle_error(void*, raptor_log_message* msg) {
 
 /*
 *******************************************************************************/
-Raptor_wrapper::Raptor_wrapper()
+Raptor_wrapper::Raptor_wrapper(const std::size_t chunk_size)
 : world_(raptor_new_world(), &raptor_free_world),
   parser_(raptor_new_parser(world_.get(), "rdfxml"), &raptor_free_parser),
+  chunk_size_(chunk_size ? chunk_size : default_chunk_size()),
   abort_requested_(false)
 {
    if( ! world_ ) BOOST_THROW_EXCEPTION(
@@ -66,6 +73,7 @@ void Raptor_wrapper::abort_parse() {
 /*
 *******************************************************************************/
 void Raptor_wrapper::setup(void* sink, handle_statement_fun_t hs_fun) {
+   abort_requested_ = false;
    raptor_parser_set_statement_handler(
          parser_.get(),
          sink,
@@ -114,10 +122,7 @@ void Raptor_wrapper::parse(std::string const& fn) {
 
 /*
 *******************************************************************************/
-void Raptor_wrapper::parse(std::istream& stream) {
-   if( ! stream.good() )
-      BOOST_THROW_EXCEPTION( Err() << Err::msg_t("read error") );
-
+boost::shared_ptr<raptor_uri> Raptor_wrapper::parse_start() {
    char const* uri_str = "from_stream";
    boost::shared_ptr<raptor_uri> uri(
             raptor_new_uri(
@@ -126,35 +131,126 @@ void Raptor_wrapper::parse(std::istream& stream) {
             ),
             &raptor_free_uri
    );
-
    raptor_parser_parse_start( parser_.get(), uri.get() );
+   return uri;
+}
 
-   std::string str;
-   for(unsigned ln = 1; stream.good() && ! abort_requested_; ++ln) {
-      std::getline(stream, str);
-      //raptor does not like empty chunks(lines) in the middle of document
-      str += '\n';
-      try{
-         const int i = raptor_parser_parse_chunk(
-               parser_.get(),
-               reinterpret_cast<const unsigned char*>(str.data()),
-               stream ? str.size() : 0,
-                     stream ? 0 : 1
-         );
-         //exceptions should originate from Raptor log handler
-         if( i != 0 && ! abort_requested_ ) BOOST_THROW_EXCEPTION(
-                  Err()
-                  << Err::msg_t("unknown parsing error")
-                  << Err::int1_t(ln)
-         );
-      } catch(std::exception const&) {
-         BOOST_THROW_EXCEPTION(
+/*
+Error location is obtained from raptor locator
+*******************************************************************************/
+void Raptor_wrapper::parse_chunk(
+         char const* data,
+         const std::size_t n,
+         const bool end
+) {
+   try{
+      const int i = raptor_parser_parse_chunk(
+            parser_.get(),
+            reinterpret_cast<const unsigned char*>(data),
+            n,
+            end ? 1 : 0
+      );
+      //exceptions should originate from Raptor log handler
+      if( i != 0 && ! abort_requested_ ) BOOST_THROW_EXCEPTION(
                Err()
-               << Err::msg_t("RDF parsing error")
-               << Err::int1_t(ln)
+               << Err::msg_t("unknown parsing error")
+      );
+   } catch(std::exception const&) {
+      Err e = make_exception(
+               "RDF parsing error",
+               raptor_parser_get_locator(parser_.get())
+      );
+      e << Err::nested_t(boost::current_exception());
+      BOOST_THROW_EXCEPTION(e);
+   }
+}
+
+/*
+*******************************************************************************/
+void Raptor_wrapper::parse(std::istream& stream) {
+   if( ! stream.good() )
+      BOOST_THROW_EXCEPTION( Err() << Err::msg_t("read error") );
+
+   const boost::shared_ptr<raptor_uri> uri = parse_start();
+   std::vector<char> buff(chunk_size_);
+   while( stream && ! abort_requested_ ) {
+      stream.read(&buff[0], buff.size());
+      const std::size_t n = static_cast<std::size_t>(stream.gcount());
+      //raptor does not like empty chunks in the middle of document
+      if( n ) parse_chunk(&buff[0], n, false);
+   }
+   if( stream.bad() )
+      BOOST_THROW_EXCEPTION( Err() << Err::msg_t("read error") );
+   if( ! abort_requested_ ) parse_chunk(0, 0, true);
+}
+
+/*
+*******************************************************************************/
+void Raptor_wrapper::parse_mapped(std::string const& file) {
+   namespace bip = boost::interprocess;
+   boost::system::error_code ec;
+   const boost::uintmax_t size = boost::filesystem::file_size(file, ec);
+   if( ec ) BOOST_THROW_EXCEPTION(
+            Err()
+            << Err::msg_t("read error")
+            << Err::str1_t(file)
+   );
+
+   if( size && detail::Decompressor::compressed(file) ) {
+      parse_compressed(file);
+      return;
+   }
+
+   const boost::shared_ptr<raptor_uri> uri = parse_start();
+   if( ! size ) {
+      parse_chunk(0, 0, true);
+      return;
+   }
+
+   bip::file_mapping fm;
+   bip::mapped_region mr;
+   try{
+      bip::file_mapping(file.c_str(), bip::read_only).swap(fm);
+      bip::mapped_region(fm, bip::read_only).swap(mr);
+   } catch(bip::interprocess_exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("error mapping file")
+               << Err::str1_t(file)
                << Err::nested_t(boost::current_exception())
-         );
+      );
+   }
+   mr.advise(bip::mapped_region::advice_sequential);
+
+   char const* p = static_cast<char const*>(mr.get_address());
+   for(
+            std::size_t n = mr.get_size();
+            n && ! abort_requested_;
+   ) {
+      const std::size_t k = std::min(n, chunk_size_);
+      parse_chunk(p, k, false);
+      p += k;
+      n -= k;
+   }
+   if( ! abort_requested_ ) parse_chunk(0, 0, true);
+}
+
+/*
+Decompressed blocks are passed to the parser while the next block is being
+decompressed in another thread.
+*******************************************************************************/
+void Raptor_wrapper::parse_compressed(std::string const& file) {
+   detail::Decompressor d(file);
+   const boost::shared_ptr<raptor_uri> uri = parse_start();
+   while( ! abort_requested_ ) {
+      boost::string_ref s = d.next();
+      if( s.empty() ) break;
+      while( ! s.empty() && ! abort_requested_ ) {
+         const std::size_t k = std::min(s.size(), chunk_size_);
+         parse_chunk(s.data(), k, false);
+         s.remove_prefix(k);
       }
    }
+   if( ! abort_requested_ ) parse_chunk(0, 0, true);
 }
 }//namespace owlcpp
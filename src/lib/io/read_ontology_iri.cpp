@@ -6,12 +6,83 @@ part of owlcpp project.
 #ifndef OWLCPP_IO_SOURCE
 #define OWLCPP_IO_SOURCE
 #endif
-#include "boost/filesystem/fstream.hpp"
 #include "owlcpp/io/read_ontology_iri.hpp"
+#include <vector>
+#include "boost/filesystem/fstream.hpp"
+#include "boost/utility/string_ref.hpp"
+
 #include "owlcpp/io/raptor_wrapper.hpp"
+#include "decompressor.hpp"
+#include "load_imports.hpp"
+#include "ntriples_to_iri.hpp"
 #include "raptor_to_iri.hpp"
 
 namespace owlcpp {
+namespace{
+
+/**@brief Read plain file in blocks, same interface as Decompressor
+*******************************************************************************/
+class File_blocks {
+public:
+   explicit File_blocks(std::string const& file)
+   : ifs_(file, std::ios::binary), buff_(detail::Decompressor::default_buffer_size())
+   {
+      if( ! ifs_ ) BOOST_THROW_EXCEPTION(
+               Input_err()
+               << Input_err::msg_t("read error")
+               << Input_err::str1_t(file)
+      );
+   }
+
+   boost::string_ref next() {
+      ifs_.read(&buff_[0], buff_.size());
+      return boost::string_ref(&buff_[0], ifs_.gcount());
+   }
+
+private:
+   boost::filesystem::ifstream ifs_;
+   std::vector<char> buff_;
+};
+
+/*
+Pass complete lines to the statement reader until the search is finished.
+*******************************************************************************/
+template<class Blocks> void read_lines(Blocks& b, detail::Ntriples_to_iri& nti) {
+   std::vector<char> text;
+   for( bool more = true; more; ) {
+      const boost::string_ref s = b.next();
+      more = ! s.empty();
+      text.insert(text.end(), s.begin(), s.end());
+      if( text.empty() ) continue;
+      char const* const first = &text[0];
+      char const* last = first + text.size();
+      if( more ) {
+         while( last != first && last[-1] != '\n' ) --last;
+         if( last == first ) continue;
+      }
+      if( ! nti.parse(first, last) ) return;
+      text.erase(text.begin(), text.begin() + (last - first));
+   }
+}
+
+/*
+*******************************************************************************/
+std::pair<std::string,std::string> read_ntriples_iri(
+         std::string const& file,
+         const std::size_t search_depth
+) {
+   detail::Ntriples_to_iri nti(search_depth);
+   if( detail::Decompressor::compressed(file) ) {
+      detail::Decompressor d(file);
+      read_lines(d, nti);
+   } else {
+      File_blocks fb(file);
+      read_lines(fb, nti);
+   }
+   return make_pair(nti.iri(), nti.version());
+}
+
+}//namespace anonymous
 
 /*
 *******************************************************************************/
@@ -20,6 +91,16 @@ std::pair<std::string,std::string> read_ontology_iri(
          const std::size_t search_depth
 ) {
    Raptor_wrapper parser;
+   return read_ontology_iri(is, parser, search_depth);
+}
+
+/*
+*******************************************************************************/
+std::pair<std::string,std::string> read_ontology_iri(
+         std::istream& is,
+         Raptor_wrapper& parser,
+         const std::size_t search_depth
+) {
    detail::Raptor_to_iri rti(parser.abort_call(), search_depth);
    parser(is, rti);
    return make_pair(rti.iri(), rti.version());
@@ -31,8 +112,26 @@ std::pair<std::string,std::string> read_ontology_iri(
          boost::filesystem::path const& file,
          const std::size_t search_depth
 ) {
-   boost::filesystem::ifstream ifs(file);
-   return read_ontology_iri(ifs, search_depth);
+   if( detail::is_ntriples(file) ) {
+      return read_ntriples_iri(file.string(), search_depth);
+   }
+   Raptor_wrapper parser;
+   return read_ontology_iri(file, parser, search_depth);
+}
+
+/*
+*******************************************************************************/
+std::pair<std::string,std::string> read_ontology_iri(
+         boost::filesystem::path const& file,
+         Raptor_wrapper& parser,
+         const std::size_t search_depth
+) {
+   if( detail::is_ntriples(file) ) {
+      return read_ntriples_iri(file.string(), search_depth);
+   }
+   detail::Raptor_to_iri rti(parser.abort_call(), search_depth);
+   parser.parse_mapped(file.string(), rti);
+   return make_pair(rti.iri(), rti.version());
 }
 
 }//namespace owlcpp
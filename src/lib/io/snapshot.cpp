@@ -0,0 +1,479 @@
+/** @file "/owlcpp/lib/io/snapshot.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "owlcpp/io/snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/foreach.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/static_assert.hpp"
+
+#include "owlcpp/rdf/triple_store.hpp"
+#include "owlcpp/rdf/visitor_node.hpp"
+#include "binary_io.hpp"
+
+namespace owlcpp {
+namespace{
+
+const char magic[] = "owlcpp_snapshot";
+const boost::uint32_t format_version = 1;
+const boost::uint32_t byte_order = 0x01020304;
+
+/** triples are stored as plain arrays of IDs and mapped directly */
+BOOST_STATIC_ASSERT(sizeof(Triple) == 4 * sizeof(boost::uint32_t));
+const std::size_t triple_alignment = 8;
+
+/** smallest sizes of saved elements, used to validate element counts:
+namespace: ID and two empty strings;
+node: ID, kind, datatype, and boolean value;
+document: three IDs and empty path */
+const std::size_t min_ns_size = 3 * sizeof(boost::uint32_t);
+const std::size_t min_node_size = 3 * sizeof(boost::uint32_t) - 2;
+const std::size_t min_doc_size = 4 * sizeof(boost::uint32_t);
+
+enum Node_kind {
+   Iri_k, Blank_k, Bool_k, Int_k, Unsigned_k, Double_k, String_k
+};
+
+/**@brief Write node content
+*******************************************************************************/
+class Node_writer : public Visitor_node {
+public:
+   explicit Node_writer(std::ostream& os) : os_(os) {}
+
+private:
+   std::ostream& os_;
+
+   void kind(const Node_kind k) {
+      detail::write_binary(os_, static_cast<boost::uint8_t>(k));
+   }
+
+   template<class T> void literal(const Node_kind k, T const& node) {
+      kind(k);
+      detail::write_binary(os_, static_cast<boost::uint32_t>(node.datatype()()));
+   }
+
+   void visit_impl(Node_iri const& node) {
+      kind(Iri_k);
+      detail::write_binary(os_, static_cast<boost::uint32_t>(node.ns_id()()));
+      detail::write_binary(os_, node.fragment());
+   }
+
+   void visit_impl(Node_blank const& node) {
+      kind(Blank_k);
+      detail::write_binary(os_, static_cast<boost::uint32_t>(node.index()));
+      detail::write_binary(os_, static_cast<boost::uint32_t>(node.document()()));
+   }
+
+   void visit_impl(Node_bool const& node) {
+      literal(Bool_k, node);
+      detail::write_binary(os_, static_cast<boost::uint8_t>(node.value()));
+   }
+
+   void visit_impl(Node_int const& node) {
+      literal(Int_k, node);
+      detail::write_binary(os_, static_cast<boost::int64_t>(node.value()));
+   }
+
+   void visit_impl(Node_unsigned const& node) {
+      literal(Unsigned_k, node);
+      detail::write_binary(os_, static_cast<boost::uint64_t>(node.value()));
+   }
+
+   void visit_impl(Node_double const& node) {
+      literal(Double_k, node);
+      detail::write_binary(os_, node.value());
+   }
+
+   void visit_impl(Node_string const& node) {
+      literal(String_k, node);
+      detail::write_binary(os_, node.value());
+      detail::write_binary(os_, node.language());
+   }
+};
+
+/*
+*******************************************************************************/
+template<class Range> inline
+std::vector<typename boost::range_value<Range>::type> sorted_ids(Range const& r) {
+   std::vector<typename boost::range_value<Range>::type> v(
+            boost::begin(r), boost::end(r)
+   );
+   std::sort(v.begin(), v.end());
+   return v;
+}
+
+/**@return true if triples are in SPOD order, as they are saved
+*******************************************************************************/
+template<class Range> inline bool spod_sorted(Range const& r) {
+   typedef typename boost::range_iterator<Range const>::type iter_t;
+   iter_t i = boost::begin(r);
+   const iter_t end = boost::end(r);
+   if( i == end ) return true;
+   for( Triple prev = *i++; i != end; ++i ) {
+      if( ! (prev < *i) ) return false;
+      prev = *i;
+   }
+   return true;
+}
+
+/*
+*******************************************************************************/
+inline void write(std::ostream& os, Triple const& t) {
+   os.write(reinterpret_cast<char const*>(&t), sizeof(Triple));
+}
+
+/*
+*******************************************************************************/
+inline void pad(std::ostream& os, const std::size_t alignment) {
+   for( ; os.tellp() % alignment; os.put(0) );
+}
+
+}//namespace anonymous
+
+namespace detail{
+
+/**@brief Restore triple store from memory-mapped snapshot
+@details Nodes are saved in the order of their IDs and triples in SPOD order,
+so that node and triple indices are built directly from the saved arrays
+without looking up each node or triple.
+References between nodes, documents, and triples are checked after the
+referenced table is loaded.
+*******************************************************************************/
+class Snapshot_loader {
+public:
+   typedef Input_err Err;
+
+   Snapshot_loader(Triple_store& ts, char const* begin, char const* end)
+   : ts_(ts), begin_(begin), br_(begin, end)
+   {}
+
+   void operator()() {
+      header();
+      namespaces();
+      nodes();
+      docs();
+      triples();
+      if( ! br_.empty() ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("unexpected data at end of snapshot")
+      );
+   }
+
+   void clear() {
+      ts_.map_triple_.clear();
+      ts_.map_doc_.clear();
+      ts_.map_node_.clear();
+      ts_.map_ns_.clear();
+   }
+
+private:
+   Triple_store& ts_;
+   char const* const begin_;
+   Binary_reader br_;
+   std::vector<bool> docs_;
+   std::vector<Node_id> datatypes_;
+   std::vector<Doc_id> blank_docs_;
+
+   template<class Id> Id read_id() {return Id(br_.read<boost::uint32_t>());}
+
+   void header() {
+      char const* m = br_.take(sizeof(magic));
+      if( std::memcmp(m, magic, sizeof(magic)) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("not a triple store snapshot")
+      );
+      if(
+               br_.read<boost::uint32_t>() != format_version ||
+               br_.read<boost::uint32_t>() != byte_order ||
+               br_.read<boost::uint32_t>() != detail::min_ns_id()() ||
+               br_.read<boost::uint32_t>() != detail::min_node_id()()
+      ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("incompatible snapshot format")
+      );
+   }
+
+   void namespaces() {
+      for( std::size_t n = br_.read_count(min_ns_size); n; --n ) {
+         const Ns_id nsid = read_id<Ns_id>();
+         ts_.map_ns_.insert(nsid, Ns_iri(br_.read_string()));
+         const std::string pref = br_.read_string();
+         if( ! pref.empty() ) ts_.map_ns_.set_prefix(nsid, pref);
+      }
+   }
+
+   void nodes() {
+      const Node_id max_id = read_id<Node_id>();
+      const std::size_t n_nodes = br_.read_count(min_node_size);
+      //do not trust saved max ID beyond the number of saved nodes
+      ts_.map_node_.reserve(Node_id(static_cast<unsigned>(
+               std::min<std::size_t>(max_id(), detail::min_node_id()() + n_nodes)
+      )));
+      for( std::size_t n = n_nodes; n; --n ) {
+         const Node_id nid = read_id<Node_id>();
+         node(nid);
+      }
+      std::sort(datatypes_.begin(), datatypes_.end());
+      datatypes_.erase(
+               std::unique(datatypes_.begin(), datatypes_.end()),
+               datatypes_.end()
+      );
+      BOOST_FOREACH(const Node_id dt, datatypes_) {
+         Node const* const node = ts_.find(dt);
+         if( ! node || ! ( is_iri(node->ns_id()) || is_empty(dt) ) )
+            BOOST_THROW_EXCEPTION(
+                     Err()
+                     << Err::msg_t("invalid datatype ID")
+                     << Err::int1_t(dt())
+            );
+      }
+      std::vector<Node_id>().swap(datatypes_);
+   }
+
+   void append(const Node_id nid, Node const& node) {
+      ts_.map_node_.append(nid, node);
+   }
+
+   Node_id datatype() {
+      const Node_id dt = read_id<Node_id>();
+      datatypes_.push_back(dt);
+      return dt;
+   }
+
+   void node(const Node_id nid) {
+      const boost::uint8_t k = br_.read<boost::uint8_t>();
+      switch(k) {
+      case Iri_k: {
+         const Ns_id nsid = read_id<Ns_id>();
+         if( ! ts_.find(nsid) ) BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("invalid namespace ID")
+                  << Err::int1_t(nsid())
+         );
+         append(nid, Node_iri(nsid, br_.read_string()));
+         return;
+      }
+      case Blank_k: {
+         const unsigned i = br_.read<boost::uint32_t>();
+         const Doc_id did = read_id<Doc_id>();
+         blank_docs_.push_back(did);
+         append(nid, Node_blank(i, did));
+         return;
+      }
+      case Bool_k: {
+         const Node_id dt = datatype();
+         append(nid, Node_bool(br_.read<boost::uint8_t>() != 0, dt));
+         return;
+      }
+      case Int_k: {
+         const Node_id dt = datatype();
+         append(nid, Node_int(br_.read<boost::int64_t>(), dt));
+         return;
+      }
+      case Unsigned_k: {
+         const Node_id dt = datatype();
+         append(nid, Node_unsigned(br_.read<boost::uint64_t>(), dt));
+         return;
+      }
+      case Double_k: {
+         const Node_id dt = datatype();
+         append(nid, Node_double(br_.read<double>(), dt));
+         return;
+      }
+      case String_k: {
+         const Node_id dt = datatype();
+         const std::string val = br_.read_string();
+         append(nid, Node_string(val, dt, br_.read_string()));
+         return;
+      }
+      default:
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("invalid node type")
+                  << Err::int1_t(k)
+         );
+      }
+   }
+
+   void check_doc(const Doc_id did) const {
+      if( did() >= docs_.size() || ! docs_[did()] ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid document ID")
+               << Err::int1_t(did())
+      );
+   }
+
+   void check_node(const Node_id nid) const {
+      if( ! ts_.find(nid) ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("invalid node ID")
+               << Err::int1_t(nid())
+      );
+   }
+
+   void docs() {
+      for( std::size_t n = br_.read_count(min_doc_size); n; --n ) {
+         const Doc_id did = read_id<Doc_id>();
+         const Node_id iri = read_id<Node_id>();
+         const Node_id vers = read_id<Node_id>();
+         check_node(iri);
+         check_node(vers);
+         ts_.map_doc_.insert(did, iri, br_.read_string(), vers);
+         if( docs_.size() <= did() ) docs_.resize(did() + 1, false);
+         docs_[did()] = true;
+      }
+      BOOST_FOREACH(const Doc_id did, blank_docs_) check_doc(did);
+      std::vector<Doc_id>().swap(blank_docs_);
+   }
+
+   void triples() {
+      const std::size_t n = br_.read_count(sizeof(Triple));
+      const std::size_t offset = br_.take(0) - begin_;
+      if( offset % triple_alignment )
+         br_.take(triple_alignment - offset % triple_alignment);
+      Triple const* first =
+               reinterpret_cast<Triple const*>(br_.take(n * sizeof(Triple)));
+      Triple const* last = first + n;
+      for(Triple const* t = first; t != last; ++t) {
+         check_node(t->subj_);
+         check_node(t->pred_);
+         check_node(t->obj_);
+         check_doc(t->doc_);
+      }
+      ts_.map_triple_.insert_sorted(std::vector<Triple>(first, last));
+   }
+};
+
+}//namespace detail
+
+/*
+*******************************************************************************/
+void save_snapshot(
+         Triple_store const& store,
+         boost::filesystem::path const& file
+) {
+   const boost::filesystem::path tmp = file.string() + ".tmp";
+   {
+      boost::filesystem::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+      ofs.write(magic, sizeof(magic));
+      detail::write_binary(ofs, format_version);
+      detail::write_binary(ofs, byte_order);
+      detail::write_binary(ofs, detail::min_ns_id()());
+      detail::write_binary(ofs, detail::min_node_id()());
+
+      const std::vector<Ns_id> nsids = sorted_ids(store.map_ns());
+      detail::write_binary(ofs, static_cast<boost::uint64_t>(nsids.size()));
+      BOOST_FOREACH(const Ns_id nsid, nsids) {
+         detail::write_binary(ofs, nsid());
+         detail::write_binary(ofs, store[nsid].str());
+         detail::write_binary(ofs, store.map_ns().prefix(nsid));
+      }
+
+      const std::vector<Node_id> nids = sorted_ids(store.map_node());
+      const Node_id nid_end =
+               nids.empty() ? detail::min_node_id() : Node_id(nids.back()() + 1);
+      detail::write_binary(ofs, nid_end());
+      detail::write_binary(ofs, static_cast<boost::uint64_t>(nids.size()));
+      Node_writer nw(ofs);
+      BOOST_FOREACH(const Node_id nid, nids) {
+         detail::write_binary(ofs, nid());
+         store[nid].accept(nw);
+      }
+
+      const std::vector<Doc_id> dids = sorted_ids(store.map_doc());
+      detail::write_binary(ofs, static_cast<boost::uint64_t>(dids.size()));
+      BOOST_FOREACH(const Doc_id did, dids) {
+         Doc_meta const& dm = store[did];
+         detail::write_binary(ofs, did());
+         detail::write_binary(ofs, dm.ontology_iri());
+         detail::write_binary(ofs, dm.version_iri());
+         detail::write_binary(ofs, dm.path);
+      }
+
+      detail::write_binary(
+               ofs,
+               static_cast<boost::uint64_t>(store.map_triple().size())
+      );
+      pad(ofs, triple_alignment);
+      if( spod_sorted(store.map_triple()) ) {
+         BOOST_FOREACH(Triple const& t, store.map_triple()) write(ofs, t);
+      } else {
+         std::vector<Triple> v(store.map_triple().begin(), store.map_triple().end());
+         std::sort(v.begin(), v.end());
+         BOOST_FOREACH(Triple const& t, v) write(ofs, t);
+      }
+
+      if( ! ofs ) BOOST_THROW_EXCEPTION(
+               Input_err()
+               << Input_err::msg_t("error writing snapshot")
+               << Input_err::str1_t(tmp.string())
+      );
+   }
+   boost::system::error_code ec;
+   rename(tmp, file, ec);
+   if( ec ) BOOST_THROW_EXCEPTION(
+            Input_err()
+            << Input_err::msg_t("error writing snapshot")
+            << Input_err::str1_t(file.string())
+   );
+}
+
+/*
+*******************************************************************************/
+void load_snapshot(
+         boost::filesystem::path const& file,
+         Triple_store& store
+) {
+   if(
+            store.map_ns().size() ||
+            store.map_node().size() ||
+            store.map_doc().size() ||
+            store.map_triple().size()
+   ) BOOST_THROW_EXCEPTION(
+            Input_err()
+            << Input_err::msg_t("snapshot can only be loaded into empty store")
+            << Input_err::str1_t(file.string())
+   );
+
+   namespace bip = boost::interprocess;
+   try{
+      const bip::file_mapping fm(file.string().c_str(), bip::read_only);
+      const bip::mapped_region mr(fm, bip::read_only);
+      char const* begin = static_cast<char const*>(mr.get_address());
+      detail::Snapshot_loader sl(store, begin, begin + mr.get_size());
+      try{
+         sl();
+      } catch(...) {
+         sl.clear();
+         throw;
+      }
+   } catch(Input_err const&) {
+      throw;
+   } catch(bip::interprocess_exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Input_err()
+               << Input_err::msg_t("error reading snapshot")
+               << Input_err::str1_t(file.string())
+      );
+   } catch(std::exception const&) {
+      BOOST_THROW_EXCEPTION(
+               Input_err()
+               << Input_err::msg_t("error loading snapshot")
+               << Input_err::str1_t(file.string())
+               << Input_err::nested_t(boost::current_exception())
+      );
+   }
+}
+
+}//namespace owlcpp
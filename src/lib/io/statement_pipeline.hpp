@@ -0,0 +1,246 @@
+/** @file "/owlcpp/lib/io/statement_pipeline.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef STATEMENT_PIPELINE_HPP_
+#define STATEMENT_PIPELINE_HPP_
+#include <deque>
+#include <vector>
+#include "boost/bind.hpp"
+#include "boost/exception_ptr.hpp"
+#include "boost/function.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/ptr_container/ptr_vector.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/thread/locks.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+#include "boost/utility/string_ref.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Compact record of RDF term copied from the parser
+@details Strings are stored as offsets into the strings of Statement_block.
+*******************************************************************************/
+struct Term_rec {
+   enum Kind {Iri, Blank, Literal};
+   Kind kind_;
+   unsigned blank_; ///< blank node index
+   std::size_t val_, val_len_;
+   std::size_t dt_, dt_len_;
+   std::size_t lang_, lang_len_;
+};
+
+/**@brief Fixed capacity block of parsed statements
+@details Each statement is recorded as three consecutive terms;
+term strings are copied into a single buffer.
+*******************************************************************************/
+class Statement_block : boost::noncopyable {
+public:
+   static std::size_t default_capacity() {return 4096;}
+
+   explicit Statement_block(const std::size_t capacity = default_capacity())
+   : capacity_(capacity)
+   {
+      terms_.reserve(3 * capacity);
+      str_.reserve(64 * capacity);
+   }
+
+   /**@return number of complete statements */
+   std::size_t size() const {return terms_.size() / 3;}
+   bool empty() const {return terms_.empty();}
+   bool full() const {return size() >= capacity_;}
+
+   void clear() {
+      terms_.clear();
+      str_.clear();
+   }
+
+   void add_iri(char const* val, const std::size_t len) {
+      Term_rec t = Term_rec();
+      t.kind_ = Term_rec::Iri;
+      t.val_ = append(val, len);
+      t.val_len_ = len;
+      terms_.push_back(t);
+   }
+
+   void add_blank(const unsigned n) {
+      Term_rec t = Term_rec();
+      t.kind_ = Term_rec::Blank;
+      t.blank_ = n;
+      terms_.push_back(t);
+   }
+
+   void add_literal(
+            boost::string_ref const& val,
+            boost::string_ref const& dt,
+            boost::string_ref const& lang
+   ) {
+      Term_rec t = Term_rec();
+      t.kind_ = Term_rec::Literal;
+      t.val_ = append(val.data(), val.size());
+      t.val_len_ = val.size();
+      t.dt_ = append(dt.data(), dt.size());
+      t.dt_len_ = dt.size();
+      t.lang_ = append(lang.data(), lang.size());
+      t.lang_len_ = lang.size();
+      terms_.push_back(t);
+   }
+
+   /**@return term @b i of statement @b n */
+   Term_rec const& term(const std::size_t n, const std::size_t i) const {
+      return terms_[3 * n + i];
+   }
+
+   boost::string_ref str(const std::size_t off, const std::size_t len) const {
+      if( ! len ) return boost::string_ref();
+      return boost::string_ref(&str_[off], len);
+   }
+
+private:
+   std::size_t capacity_;
+   std::vector<Term_rec> terms_;
+   std::vector<char> str_;
+
+   std::size_t append(char const* s, const std::size_t len) {
+      const std::size_t off = str_.size();
+      str_.insert(str_.end(), s, s + len);
+      return off;
+   }
+};
+
+/**@brief Pass blocks of statements from parsing thread to a consumer thread
+@details The producer fills block() and calls push() when it is full.
+Full blocks are queued for the consumer; consumed blocks are returned to
+the producer, so that no memory is allocated once the blocks have grown
+to their working size.
+The producer waits when all blocks are full and the consumer waits when
+none are; both block on a condition variable.
+The queues are guarded by a mutex rather than being lock-free: blocks
+change hands once per thousands of statements, so the lock is rarely
+contended, while a thread that outpaces the other sleeps instead of
+spinning and taking processor time from it.
+stop() wakes a waiting consumer, which returns after draining the full
+blocks; a failed consumer wakes a waiting producer.
+*******************************************************************************/
+class Statement_pipeline : boost::noncopyable {
+   typedef boost::unique_lock<boost::mutex> lock_t;
+
+public:
+   typedef boost::function<void(Statement_block const&)> consumer_t;
+
+   static std::size_t default_blocks() {return 8;}
+
+   /**
+    @param consumer function called in consumer thread for every block
+    @param n_blocks number of blocks; at most n_blocks - 1 full blocks are
+    waiting for the consumer
+    @param block_capacity number of statements in one block
+   */
+   explicit Statement_pipeline(
+            consumer_t const& consumer,
+            const std::size_t n_blocks = default_blocks(),
+            const std::size_t block_capacity = Statement_block::default_capacity()
+   )
+   : consumer_(consumer),
+     cur_(0),
+     done_(false),
+     failed_(false)
+   {
+      for( std::size_t n = 0; n != n_blocks; ++n ) {
+         blocks_.push_back(new Statement_block(block_capacity));
+         free_.push_back(&blocks_.back());
+      }
+      cur_ = free_.back();
+      free_.pop_back();
+      thread_ = boost::thread(boost::bind(&Statement_pipeline::run, this));
+   }
+
+   ~Statement_pipeline() {stop();}
+
+   /**@return block being filled by the producer */
+   Statement_block& block() {return *cur_;}
+
+   /**@brief pass current block to the consumer and get next empty block
+    @return false if the consumer has failed
+   */
+   bool push() {
+      lock_t lock(mutex_);
+      //if the consumer has failed, it no longer uses the blocks
+      if( failed_ ) return false;
+      full_.push_back(cur_);
+      cond_.notify_all();
+      while( free_.empty() && ! failed_ ) cond_.wait(lock);
+      if( failed_ ) return false;
+      cur_ = free_.back();
+      free_.pop_back();
+      lock.unlock();
+      cur_->clear();
+      return true;
+   }
+
+   /**@brief pass remaining statements to the consumer and wait for it to finish
+    @throw exception thrown by the consumer
+   */
+   void finish() {
+      if( ! cur_->empty() ) push();
+      stop();
+      if( err_ ) boost::rethrow_exception(err_);
+   }
+
+   bool failed() const {
+      lock_t lock(mutex_);
+      return failed_;
+   }
+
+private:
+   consumer_t consumer_;
+   boost::ptr_vector<Statement_block> blocks_;
+   std::deque<Statement_block*> full_;
+   std::vector<Statement_block*> free_;
+   Statement_block* cur_;
+   bool done_;
+   bool failed_;
+   mutable boost::mutex mutex_;
+   boost::condition_variable cond_;
+   boost::exception_ptr err_;
+   boost::thread thread_;
+
+   void stop() {
+      {
+         lock_t lock(mutex_);
+         done_ = true;
+         cond_.notify_all();
+      }
+      if( thread_.joinable() ) thread_.join();
+   }
+
+   void run() {
+      try{
+         for( ; ; ) {
+            Statement_block* b = 0;
+            {
+               lock_t lock(mutex_);
+               while( full_.empty() && ! done_ ) cond_.wait(lock);
+               if( full_.empty() ) return;
+               b = full_.front();
+               full_.pop_front();
+            }
+            consumer_(*b);
+            lock_t lock(mutex_);
+            free_.push_back(b);
+            cond_.notify_all();
+         }
+      } catch(...) {
+         lock_t lock(mutex_);
+         err_ = boost::current_exception();
+         failed_ = true;
+         cond_.notify_all();
+      }
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* STATEMENT_PIPELINE_HPP_ */
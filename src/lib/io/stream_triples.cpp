@@ -0,0 +1,346 @@
+/** @file "/owlcpp/lib/io/stream_triples.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "owlcpp/io/stream_triples.hpp"
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "boost/foreach.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include "raptor2.h"
+
+#include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/raptor_wrapper.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "owlcpp/terms/term_methods.hpp"
+#include "decompressor.hpp"
+#include "load_imports.hpp"
+#include "ntriples_parser.hpp"
+
+namespace owlcpp {
+namespace {
+
+/**@brief Pass statements of Raptor parser to visitor
+*******************************************************************************/
+class Raptor_to_visitor {
+public:
+   explicit Raptor_to_visitor(Statement_visitor& visitor) : visitor_(visitor) {}
+
+   void insert(void const* statement) {
+      raptor_statement const* rs = static_cast<raptor_statement const*>(statement);
+      term(*rs->subject, subj_);
+      term(*rs->predicate, pred_);
+      term(*rs->object, obj_);
+      visitor_.visit(subj_, pred_, obj_);
+   }
+
+private:
+   Statement_visitor& visitor_;
+   Stream_term subj_, pred_, obj_;
+
+   static boost::string_ref uri_str(raptor_uri* uri) {
+      std::size_t len;
+      char const* str = reinterpret_cast<char const*>(
+               raptor_uri_as_counted_string(uri, &len)
+      );
+      return boost::string_ref(str, len);
+   }
+
+   static void term(raptor_term const& node, Stream_term& t) {
+      t.datatype.clear();
+      t.language.clear();
+      switch (node.type) {
+      case RAPTOR_TERM_TYPE_URI:
+         t.kind = Stream_term::Iri;
+         t.value = uri_str(node.value.uri);
+         return;
+      case RAPTOR_TERM_TYPE_BLANK:
+         t.kind = Stream_term::Blank;
+         t.value = boost::string_ref(
+                  reinterpret_cast<char const*>(node.value.blank.string),
+                  node.value.blank.string_len
+         );
+         return;
+      case RAPTOR_TERM_TYPE_LITERAL: {
+         raptor_term_literal_value const& val = node.value.literal;
+         t.kind = Stream_term::Literal;
+         t.value = boost::string_ref(
+                  reinterpret_cast<char const*>(val.string), val.string_len
+         );
+         if( val.datatype ) t.datatype = uri_str(val.datatype);
+         if( val.language ) t.language = boost::string_ref(
+                  reinterpret_cast<char const*>(val.language), val.language_len
+         );
+         return;
+      }
+      default:
+         BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("unknown node type")
+         );
+      }
+   }
+};
+
+/**@brief Pass statements of N-Triples or N-Quads text to visitor
+@details Text is parsed in blocks of complete lines; parsed statements of
+each block are released before the next block is parsed.
+*******************************************************************************/
+class Ntriples_to_visitor {
+public:
+   typedef Input_err Err;
+
+   static std::size_t block_size() {return 1 << 22;}
+
+   Ntriples_to_visitor(std::string const& path, Statement_visitor& visitor)
+   : path_(path), visitor_(visitor), line_(0)
+   {}
+
+   void parse_file() {
+      namespace bip = boost::interprocess;
+      boost::system::error_code ec;
+      const boost::uintmax_t size = boost::filesystem::file_size(path_, ec);
+      if( ec ) BOOST_THROW_EXCEPTION(
+               Err()
+               << Err::msg_t("read error")
+               << Err::str1_t(path_)
+      );
+      if( ! size ) return;
+      if( detail::Decompressor::compressed(path_) ) {
+         parse_compressed();
+         return;
+      }
+
+      bip::file_mapping fm;
+      bip::mapped_region mr;
+      try{
+         bip::file_mapping(path_.c_str(), bip::read_only).swap(fm);
+         bip::mapped_region(fm, bip::read_only).swap(mr);
+      } catch(bip::interprocess_exception const&) {
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("error mapping file")
+                  << Err::str1_t(path_)
+                  << Err::nested_t(boost::current_exception())
+         );
+      }
+      mr.advise(bip::mapped_region::advice_sequential);
+      char const* first = static_cast<char const*>(mr.get_address());
+      char const* const last = first + mr.get_size();
+      while( first != last ) {
+         char const* e = static_cast<std::size_t>(last - first) > block_size() ?
+                  first + block_size() : last;
+         e = std::find(e, last, '\n');
+         if( e != last ) ++e;
+         parse(first, e);
+         first = e;
+      }
+   }
+
+private:
+   const std::string path_;
+   Statement_visitor& visitor_;
+   detail::Nt_parser parser_;
+   std::vector<detail::Nt_statement> v_;
+   Stream_term subj_, pred_, obj_;
+   std::size_t line_; ///< number of lines before current block
+
+   /* incomplete last line of decompressed text is carried over to the next
+   block */
+   void parse_compressed() {
+      detail::Decompressor d(path_);
+      std::vector<char> text;
+      for( bool more = true; more; ) {
+         const boost::string_ref s = d.next();
+         more = ! s.empty();
+         text.insert(text.end(), s.begin(), s.end());
+         if( text.empty() ) continue;
+         char const* first = &text[0];
+         char const* last = first + text.size();
+         if( more ) {
+            while( last != first && last[-1] != '\n' ) --last;
+            if( last == first ) continue;
+         }
+         parse(first, last);
+         text.erase(text.begin(), text.begin() + (last - first));
+      }
+   }
+
+   void parse(char const* first, char const* last) {
+      parser_.clear();
+      v_.clear();
+      try{
+         parser_.parse(first, last, v_);
+      } catch(detail::Nt_parser::Err const&) {
+         const int line = static_cast<int>(
+                  line_ + std::count(first, parser_.error_position(), '\n')
+         ) + 1;
+         BOOST_THROW_EXCEPTION(
+                  Err()
+                  << Err::msg_t("error parsing")
+                  << Err::str1_t(path_)
+                  << Err::int1_t(line)
+                  << Err::nested_t(boost::current_exception())
+         );
+      }
+      BOOST_FOREACH(detail::Nt_statement const& s, v_) {
+         term(s.subj_, subj_);
+         term(s.pred_, pred_);
+         term(s.obj_, obj_);
+         visitor_.visit(subj_, pred_, obj_);
+      }
+      line_ += std::count(first, last, '\n');
+   }
+
+   static void term(detail::Nt_term const& nt, Stream_term& t) {
+      switch (nt.kind_) {
+      case detail::Nt_term::Iri: t.kind = Stream_term::Iri; break;
+      case detail::Nt_term::Blank: t.kind = Stream_term::Blank; break;
+      default: t.kind = Stream_term::Literal; break;
+      }
+      t.value = nt.val_;
+      t.datatype = nt.dt_;
+      t.language = nt.lang_;
+   }
+};
+
+/**@brief Forward statements to visitor and collect ontologyIRI, versionIRI,
+and imports of the document
+*******************************************************************************/
+class Find_imports : public Statement_visitor {
+public:
+   explicit Find_imports(Statement_visitor& visitor) : visitor_(visitor) {}
+
+   std::string const& iri() const {return iri_;}
+   std::string const& version() const {return version_;}
+   std::vector<std::string> const& imports() const {return imports_;}
+
+private:
+   Statement_visitor& visitor_;
+   std::string iri_;
+   std::string version_;
+   std::vector<std::string> imports_;
+
+   template<class T> static bool is_term(Stream_term const& t, T const& tag) {
+      return
+               t.kind == Stream_term::Iri &&
+               terms::comparison(t.value.data(), t.value.size(), tag);
+   }
+
+   void document_impl(std::string const& path) {
+      iri_.clear();
+      version_.clear();
+      imports_.clear();
+      visitor_.document(path);
+   }
+
+   void visit_impl(
+            Stream_term const& subj,
+            Stream_term const& pred,
+            Stream_term const& obj
+   ) {
+      visitor_.visit(subj, pred, obj);
+      if( subj.kind != Stream_term::Iri || obj.kind != Stream_term::Iri ) return;
+      if(
+               iri_.empty() &&
+               is_term(obj, terms::owl_Ontology()) &&
+               is_term(pred, terms::rdf_type())
+      ) {
+         iri_ = subj.value.to_string();
+      } else if( is_term(pred, terms::owl_versionIRI()) ) {
+         if( version_.empty() ) version_ = obj.value.to_string();
+      } else if( is_term(pred, terms::owl_imports()) ) {
+         imports_.push_back(obj.value.to_string());
+      }
+   }
+};
+
+/*
+*******************************************************************************/
+void stream_doc(std::string const& path, Statement_visitor& visitor) {
+   visitor.document(path);
+   if( detail::is_ntriples(path) ) {
+      Ntriples_to_visitor ntv(path, visitor);
+      ntv.parse_file();
+      return;
+   }
+   Raptor_wrapper parser;
+   Raptor_to_visitor rtv(visitor);
+   try{
+      parser.parse_mapped(path, rtv);
+   } catch(Input_err const&) {
+      BOOST_THROW_EXCEPTION(
+               Input_err()
+               << Input_err::msg_t("error parsing")
+               << Input_err::str1_t(path)
+               << Input_err::nested_t(boost::current_exception())
+      );
+   }
+}
+
+/*
+*******************************************************************************/
+void exclude_doc(
+         std::string const& iri,
+         Catalog const& cat,
+         std::set<Doc_id>& dids
+) {
+   if( iri.empty() ) return;
+   BOOST_FOREACH(const Doc_id did, cat.find_doc_iri(iri)) dids.insert(did);
+   BOOST_FOREACH(const Doc_id did, cat.find_doc_version(iri)) dids.insert(did);
+}
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+void stream_file(
+         boost::filesystem::path const& file,
+         Statement_visitor& visitor
+) {
+   stream_doc(canonical(file).string(), visitor);
+}
+
+/*
+*******************************************************************************/
+void stream_file(
+         boost::filesystem::path const& file,
+         Statement_visitor& visitor,
+         Catalog const& cat
+) {
+   Find_imports fi(visitor);
+   stream_doc(canonical(file).string(), fi);
+
+   //the root document is not streamed again if it is imported
+   std::set<Doc_id> done;
+   exclude_doc(fi.iri(), cat, done);
+   exclude_doc(fi.version(), cat, done);
+
+   std::deque<std::string> queue(fi.imports().begin(), fi.imports().end());
+   for( ; ! queue.empty(); queue.pop_front() ) {
+      Doc_id did;
+      try{
+         did = detail::find_import(queue.front(), cat);
+      } catch(Input_err const&) {
+         BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("import error")
+                  << Input_err::nested_t(boost::current_exception())
+         );
+      }
+      if( ! done.insert(did).second ) continue;
+      stream_doc(cat.path(did), fi);
+      queue.insert(queue.end(), fi.imports().begin(), fi.imports().end());
+   }
+}
+
+}//namespace owlcpp
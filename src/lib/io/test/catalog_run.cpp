@@ -5,10 +5,14 @@ part of owlcpp project.
 *******************************************************************************/
 #define BOOST_TEST_MODULE catalog_run
 #include "boost/test/unit_test.hpp"
+#include <ctime>
+#include <limits>
 #include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
 #include "test/exception_fixture.hpp"
 #include "test/sample_data.hpp"
 #include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/catalog_cache.hpp"
 #include "owlcpp/rdf/print_node.hpp"
 
 namespace owlcpp{ namespace test{
@@ -90,5 +94,131 @@ BOOST_AUTO_TEST_CASE( test_catalog_sample_data ) {
    }
 }
 
+/**@test Documents read concurrently are cataloged in the same order
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_catalog_threads ) {
+   Catalog cat1;
+   const std::size_t n1 = add(cat1, dir1, false, 10, 1);
+   Catalog cat4;
+   const std::size_t n4 = add(cat4, dir1, false, 10, 4);
+   BOOST_CHECK_EQUAL(n1, n4);
+   BOOST_REQUIRE_EQUAL(cat1.size(), cat4.size());
+
+   Catalog::const_iterator i1 = cat1.begin(), i4 = cat4.begin();
+   for( ; i1 != cat1.end(); ++i1, ++i4 ) {
+      BOOST_CHECK_EQUAL(*i1, *i4);
+      BOOST_CHECK_EQUAL(cat1.path(*i1), cat4.path(*i4));
+      BOOST_CHECK_EQUAL(cat1.ontology_iri_str(*i1), cat4.ontology_iri_str(*i4));
+   }
+}
+
+/**@test Catalog built with cache is same as without it
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_catalog_cache ) {
+   const std::string cache_path = temp_file_path() + "/catalog_cache.bin";
+   Catalog cat0;
+   add(cat0, dir1, false, 10);
+
+   Catalog_cache cache1;
+   Catalog cat1;
+   add(cat1, cache1, dir1, false, 10);
+   BOOST_CHECK_GE(cache1.size(), cat1.size());
+   cache1.save(cache_path);
+
+   Catalog_cache cache2(cache_path);
+   BOOST_CHECK_EQUAL(cache1.size(), cache2.size());
+   const Catalog_cache::Entry stamp =
+            Catalog_cache::stamp(sample_files()[0].path, 10);
+   Catalog_cache::Entry const* e = cache2.find(sample_files()[0].path, stamp);
+   BOOST_REQUIRE(e);
+   BOOST_CHECK_EQUAL(e->iri, sample_files()[0].iri);
+   BOOST_CHECK( ! cache2.find(
+            sample_files()[0].path,
+            Catalog_cache::stamp(sample_files()[0].path, 11)
+   ));
+
+   Catalog cat2;
+   add(cat2, cache2, dir1, false, 10);
+   BOOST_REQUIRE_EQUAL(cat0.size(), cat2.size());
+   BOOST_FOREACH(const Doc_id did, cat0) {
+      BOOST_CHECK_EQUAL(cat0.path(did), cat2.path(did));
+      BOOST_CHECK_EQUAL(cat0.ontology_iri_str(did), cat2.ontology_iri_str(did));
+      BOOST_CHECK_EQUAL(cat0.version_iri_str(did), cat2.version_iri_str(did));
+   }
+}
+
+/**@brief write N-Triples ontology document with given IDs and modification time
+*******************************************************************************/
+void write_ontology(
+         boost::filesystem::path const& path,
+         std::string const& iri,
+         std::string const& version,
+         const std::time_t mtime
+) {
+   {
+      boost::filesystem::ofstream ofs(path);
+      ofs
+      << '<' << iri << "> <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+      << "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+      << '<' << iri << "> <http://www.w3.org/2002/07/owl#versionIRI> "
+      << '<' << version << "> .\n"
+      ;
+   }
+   boost::filesystem::last_write_time(path, mtime);
+}
+
+/**@test Modified documents are read again and entries of documents that
+are no longer scanned are pruned
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_catalog_cache_update ) {
+   const std::string cache_path = temp_file_path() + "/catalog_cache_2.bin";
+   const boost::filesystem::path dir = temp_file_path() + "/catalog_run_cache";
+   boost::filesystem::remove_all(dir);
+   boost::filesystem::create_directories(dir);
+   const std::time_t t = std::time(0) - 100;
+   const std::string ex = "http://example.xyz/";
+   write_ontology(dir / "a.nt", ex + "a", ex + "a1", t);
+   write_ontology(dir / "b.nt", ex + "b", ex + "b1", t);
+
+   Catalog_cache cache1;
+   Catalog cat1;
+   BOOST_CHECK_EQUAL(add(cat1, cache1, dir), 2U);
+   BOOST_CHECK_EQUAL(cache1.size(), 2U);
+   cache1.save(cache_path);
+
+   //same size, different IDs and modification time
+   write_ontology(dir / "a.nt", ex + "c", ex + "c2", t + 10);
+   boost::filesystem::remove(dir / "b.nt");
+
+   Catalog_cache cache2(cache_path);
+   Catalog cat2;
+   BOOST_CHECK_EQUAL(add(cat2, cache2, dir), 1U);
+   BOOST_REQUIRE_EQUAL(cat2.size(), 1U);
+   const Doc_id did = *cat2.begin();
+   BOOST_CHECK_EQUAL(cat2.ontology_iri_str(did), ex + "c");
+   BOOST_CHECK_EQUAL(cat2.version_iri_str(did), ex + "c2");
+
+   BOOST_CHECK_EQUAL(cache2.size(), 2U);
+   BOOST_CHECK_EQUAL(cache2.prune(), 1U);
+   cache2.save(cache_path);
+   const Catalog_cache cache3(cache_path);
+   BOOST_CHECK_EQUAL(cache3.size(), 1U);
+   const std::string pa = canonical(dir / "a.nt").string();
+   Catalog_cache::Entry const* e = cache3.find(
+            pa,
+            Catalog_cache::stamp(pa, std::numeric_limits<std::size_t>::max())
+   );
+   BOOST_REQUIRE(e);
+   BOOST_CHECK_EQUAL(e->iri, ex + "c");
+   BOOST_CHECK_EQUAL(e->version, ex + "c2");
+
+   //recently modified documents are not cached
+   write_ontology(dir / "a.nt", ex + "a", ex + "a1", std::time(0));
+   Catalog cat4;
+   add(cat4, cache2, dir);
+   BOOST_CHECK_EQUAL(cat4.ontology_iri_str(*cat4.begin()), ex + "a");
+   BOOST_CHECK_EQUAL(cache2.size(), 0U);
+}
+
 }//namespace test
 }//namespace owlcpp
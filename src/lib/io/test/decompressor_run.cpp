@@ -0,0 +1,108 @@
+/** @file "/owlcpp/lib/io/test/decompressor_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE decompressor_run
+#include "boost/test/unit_test.hpp"
+#include <string>
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/iostreams/filtering_stream.hpp"
+#include "boost/iostreams/filter/gzip.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/version.hpp"
+#if BOOST_VERSION >= 107000
+#include "boost/iostreams/filter/zstd.hpp"
+#endif
+#include "test/exception_fixture.hpp"
+#include "test/sample_data.hpp"
+#include "decompressor.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace bio = boost::iostreams;
+using owlcpp::detail::Decompressor;
+
+std::string text() {
+   std::string s;
+   for( unsigned i = 0; i != 10000; ++i ) {
+      s += "line " + boost::lexical_cast<std::string>(i) + '\n';
+   }
+   return s;
+}
+
+template<class Filter> std::string write(
+         std::string const& name,
+         std::string const& s,
+         Filter const& f
+) {
+   const std::string file = temp_file_path() + "/" + name;
+   boost::filesystem::ofstream ofs(file, std::ios::binary);
+   bio::filtering_ostream os;
+   os.push(f);
+   os.push(ofs);
+   os << s;
+   return file;
+}
+
+std::string read_all(Decompressor& d) {
+   std::string s;
+   for( boost::string_ref r = d.next(); ! r.empty(); r = d.next() ) {
+      s.append(r.begin(), r.end());
+   }
+   return s;
+}
+
+/**@test Decompress gzip file in small blocks
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_gzip ) {
+   const std::string s = text();
+   const std::string file = write("decompressor_run.gz", s, bio::gzip_compressor());
+   BOOST_CHECK_EQUAL(Decompressor::format(file), Decompressor::Gzip);
+   Decompressor d(file, 1000);
+   BOOST_CHECK(read_all(d) == s);
+   BOOST_CHECK(d.next().empty());
+}
+
+#if BOOST_VERSION >= 107000
+/**@test
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_zstd ) {
+   const std::string s = text();
+   const std::string file = write("decompressor_run.zst", s, bio::zstd_compressor());
+   BOOST_CHECK_EQUAL(Decompressor::format(file), Decompressor::Zstd);
+   Decompressor d(file, 777);
+   BOOST_CHECK(read_all(d) == s);
+}
+#endif
+
+/**@test Uncompressed file is passed through
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_plain ) {
+   const std::string s = text();
+   const std::string file = temp_file_path() + "/decompressor_run.txt";
+   boost::filesystem::ofstream(file, std::ios::binary) << s;
+   BOOST_CHECK_EQUAL(Decompressor::format(file), Decompressor::None);
+   Decompressor d(file, 4096);
+   BOOST_CHECK(read_all(d) == s);
+}
+
+/**@test Stop reading before the end; corrupt input
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_errors ) {
+   const std::string s = text();
+   const std::string file = write("decompressor_run_2.gz", s, bio::gzip_compressor());
+   {
+      Decompressor d(file, 100);
+      BOOST_CHECK_EQUAL(d.next().size(), 100U);
+   }
+
+   const std::size_t size = boost::filesystem::file_size(file);
+   boost::filesystem::resize_file(file, size / 2);
+   Decompressor d(file, 100);
+   BOOST_CHECK_THROW(read_all(d), Input_err);
+}
+
+}//namespace test
+}//namespace owlcpp
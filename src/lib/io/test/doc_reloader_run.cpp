@@ -0,0 +1,125 @@
+/** @file "/owlcpp/lib/io/test/doc_reloader_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE doc_reloader_run
+#include "boost/test/unit_test.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_data.hpp"
+#include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/doc_reloader.hpp"
+#include "owlcpp/io/input.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace t = owlcpp::terms;
+
+const std::string path1 = temp_file_path() + "/doc_reloader_run_01.owl";
+const std::string iri1 = "http://owl-cpp.sf.net/test/owl/doc_reloader_run_01.owl";
+const std::string iri2 = "http://owl-cpp.sf.net/test/owl/union_01.owl";
+const std::string iri3 = "http://owl-cpp.sf.net/test/owl/og_02.owl";
+
+void write_doc(std::string const& imports, std::string const& classes) {
+   boost::filesystem::ofstream ofs(path1);
+   ofs
+   << "<?xml version=\"1.0\"?>\n"
+   << "<rdf:RDF xml:base=\"" << iri1 << "\"\n"
+   << " xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"\n"
+   << " xmlns:owl=\"http://www.w3.org/2002/07/owl#\">\n"
+   << "<owl:Ontology rdf:about=\"\">\n"
+   << " <owl:imports rdf:resource=\"" << imports << "\"/>\n"
+   << "</owl:Ontology>\n"
+   << classes
+   << "</rdf:RDF>\n"
+   ;
+}
+
+/**@test Reload changed document and its imports
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_reload_01 ) {
+   write_doc(iri2, "<owl:Class rdf:about=\"#A\"/>\n");
+   Catalog cat;
+   add(cat, sample_file_path());
+   Triple_store ts;
+   load_file(path1, ts, cat);
+   const Doc_id did1 = *ts.find_doc_iri(iri1).begin();
+   const Doc_id did2 = *ts.find_doc_iri(iri2).begin();
+   BOOST_CHECK( ! ts.find_doc_iri(iri3) );
+   const std::size_t n_triples = ts.map_triple().size();
+   const Node_id nid_a = *ts.find_node_iri(iri1 + "#A");
+
+   Doc_reloader dr(ts, cat, 1);
+   Doc_reloader::Report r = dr.reload(did1);
+   BOOST_CHECK( ! r.changed );
+   BOOST_CHECK_EQUAL(r.doc, did1);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triples);
+
+   write_doc(
+            iri3,
+            "<owl:Class rdf:about=\"#A\"/>\n<owl:Class rdf:about=\"#B\"/>\n"
+   );
+   r = dr.reload(path1);
+   BOOST_CHECK(r.changed);
+   BOOST_CHECK_EQUAL(r.doc, did1);
+   BOOST_REQUIRE_EQUAL(r.imported.size(), 1U);
+   BOOST_CHECK_EQUAL(r.imported[0], *ts.find_doc_iri(iri3).begin());
+   BOOST_REQUIRE_EQUAL(r.orphaned.size(), 1U);
+   BOOST_CHECK_EQUAL(r.orphaned[0], did2);
+
+   //unchanged node IDs
+   BOOST_CHECK_EQUAL(*ts.find_node_iri(iri1 + "#A"), nid_a);
+   BOOST_CHECK_EQUAL(*ts.find_doc_iri(iri2).begin(), did2);
+   BOOST_CHECK_EQUAL(
+            distance(ts.find_triple(any, t::rdf_type::id(), t::owl_Class::id(), did1)),
+            2
+   );
+   BOOST_CHECK_EQUAL(
+            distance(ts.find_triple(any, t::owl_imports::id(), any, did1)),
+            1
+   );
+
+   r = dr.reload(did1);
+   BOOST_CHECK( ! r.changed );
+}
+
+/**@test Reload N-Triples document
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_reload_ntriples ) {
+   const std::string path = temp_file_path() + "/doc_reloader_run_02.nt";
+   const std::string iri = "http://owl-cpp.sf.net/test/owl/doc_reloader_run_02";
+   const std::string decl =
+            "<" + iri + "> <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+            "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+   ;
+   const std::string class_a =
+            "<" + iri + "#A> <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+            "<http://www.w3.org/2002/07/owl#Class> .\n"
+   ;
+   {
+      boost::filesystem::ofstream ofs(path);
+      ofs << decl << class_a;
+   }
+   Catalog cat;
+   Triple_store ts;
+   load_file(path, ts, cat);
+   const Doc_id did = *ts.find_doc_iri(iri).begin();
+   Doc_reloader dr(ts, cat, 1);
+   {
+      boost::filesystem::ofstream ofs(path);
+      ofs << decl << class_a << "_:b <" << iri << "#p> \"x\" .\n";
+   }
+   const Doc_reloader::Report r = dr.reload(did);
+   BOOST_CHECK(r.changed);
+   BOOST_CHECK_EQUAL(r.doc, did);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+   BOOST_CHECK_EQUAL(*ts.find_doc_iri(iri).begin(), did);
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did)), 3);
+   BOOST_CHECK(ts.find_literal("x", "", ""));
+}
+
+}//namespace test
+}//namespace owlcpp
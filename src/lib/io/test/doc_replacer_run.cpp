@@ -0,0 +1,100 @@
+/** @file "/owlcpp/lib/io/test/doc_replacer_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE doc_replacer_run
+#include "boost/test/unit_test.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_triples.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "doc_replacer.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace t = owlcpp::terms;
+
+const std::string doc4 = "http://doc4";
+
+/**@test Replaced document is restored unless replacement is committed
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_restore ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   sample_triples_02(ts);
+   const Doc_id did1 = *ts.find_doc_iri(doc1).begin();
+   const Node_id nid1 = *ts.find_blank(1, did1);
+   const Node_id nid5 = *ts.find_blank(5, did1);
+   const std::size_t n_node = ts.map_node().size();
+   const std::size_t n_triple = ts.map_triple().size();
+   {
+      owlcpp::detail::Doc_replacer dr(ts, did1);
+      BOOST_CHECK( ! ts.find(did1) );
+      BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple - 7);
+      dr.insert_doc(ts.insert_node_iri(doc4), path1, t::empty_::id());
+      const Node_id nid = ts.insert_blank(7, did1);
+      ts.insert_blank(8, did1);
+      ts.insert(Triple::make(nid, t::rdf_type::id(), t::owl_Class::id(), did1));
+   }
+   BOOST_CHECK_EQUAL(ts.map_node().size(), n_node + 1);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   BOOST_CHECK_EQUAL(ts[did1].path, path1);
+   BOOST_CHECK_EQUAL(*ts.find_doc_iri(doc1).begin(), did1);
+   BOOST_CHECK_EQUAL(*ts.find_blank(1, did1), nid1);
+   BOOST_CHECK_EQUAL(*ts.find_blank(5, did1), nid5);
+   BOOST_CHECK( ! ts.find_blank(7, did1) );
+   BOOST_CHECK( ! ts.find_blank(8, did1) );
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did1)), 7);
+}
+
+/**@test Replacement document gets ID of the replaced one
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_commit ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   sample_triples_02(ts);
+   const Doc_id did1 = *ts.find_doc_iri(doc1).begin();
+   const std::size_t n_triple = ts.map_triple().size();
+   {
+      owlcpp::detail::Doc_replacer dr(ts, did1);
+      dr.insert_doc(ts.insert_node_iri(doc4), path1, t::empty_::id());
+      const Node_id nid = ts.insert_blank(7, did1);
+      ts.insert(Triple::make(nid, t::rdf_type::id(), t::owl_Class::id(), did1));
+      dr.commit();
+   }
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple - 6);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   BOOST_CHECK( ! ts.find_doc_iri(doc1) );
+   BOOST_CHECK_EQUAL(*ts.find_doc_iri(doc4).begin(), did1);
+   BOOST_CHECK_EQUAL(ts[did1].path, path1);
+   BOOST_CHECK( ts.find_blank(7, did1) );
+   BOOST_CHECK( ! ts.find_blank(1, did1) );
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did1)), 1);
+}
+
+/**@test Explicit rollback restores replaced document
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_rollback ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   sample_triples_02(ts);
+   const Doc_id did1 = *ts.find_doc_iri(doc1).begin();
+   const std::size_t n_triple = ts.map_triple().size();
+   {
+      owlcpp::detail::Doc_replacer dr(ts, did1);
+      dr.insert_doc(ts.insert_node_iri(doc4), path1, t::empty_::id());
+      const Node_id nid = ts.insert_blank(7, did1);
+      ts.insert(Triple::make(nid, t::rdf_type::id(), t::owl_Class::id(), did1));
+      dr.rollback();
+      BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+      BOOST_CHECK( ! ts.find_doc_iri(doc4) );
+      BOOST_CHECK( ! ts.find_blank(7, did1) );
+   }
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+   BOOST_CHECK_EQUAL(*ts.find_doc_iri(doc1).begin(), did1);
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did1)), 7);
+}
+
+}//namespace test
+}//namespace owlcpp
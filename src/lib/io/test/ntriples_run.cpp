@@ -0,0 +1,359 @@
+/** @file "/owlcpp/lib/io/test/ntriples_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE ntriples_run
+#include "boost/test/unit_test.hpp"
+#include <string>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/iostreams/filtering_stream.hpp"
+#include "boost/iostreams/filter/gzip.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/range/distance.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_data.hpp"
+#include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/input.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "ntriples_parser.hpp"
+#include "ntriples_to_store.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace t = owlcpp::terms;
+using owlcpp::detail::Nt_parser;
+using owlcpp::detail::Nt_statement;
+using owlcpp::detail::Nt_term;
+using owlcpp::detail::Ntriples_to_store;
+
+const std::string ont1 =
+         "<http://example.xyz/ont1> "
+         "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+         "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+         "<http://example.xyz/ont1> "
+         "<http://www.w3.org/2002/07/owl#versionIRI> "
+         "<http://example.xyz/ont1/v1> .\n"
+         "<http://example.xyz/ont1> "
+         "<http://www.w3.org/2002/07/owl#imports> "
+         "<http://example.xyz/ont2> .\n"
+;
+
+std::vector<Nt_statement> parse(Nt_parser& p, std::string const& s) {
+   std::vector<Nt_statement> v;
+   p.parse(s.data(), s.data() + s.size(), v);
+   return v;
+}
+
+/**@test Parse terms
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_nt_parser ) {
+   Nt_parser p;
+   const std::string s =
+            "# comment\n"
+            "\n"
+            "<http://a/s> <http://a/p> <http://a/o> .\n"
+            "_:b1 <http://a/p> \"x\\ty\\u00E9\\\"\"@en-US .  # comment\r\n"
+            "<http://a/s><http://a/p>\"1\"^^<http://www.w3.org/2001/XMLSchema#int>.\n"
+            "_:b2.x <http://a/p> _:b3. \n"
+            "<http://a/s> <http://a/p> <http://a/o> <http://a/g> .\n"
+            "<http://a/\\u0073> <http://a/p> \"\" _:g ."
+   ;
+   const std::vector<Nt_statement> v = parse(p, s);
+   BOOST_REQUIRE_EQUAL(v.size(), 6U);
+
+   BOOST_CHECK_EQUAL(v[0].subj_.kind_, Nt_term::Iri);
+   BOOST_CHECK_EQUAL(v[0].subj_.val_, "http://a/s");
+   BOOST_CHECK_EQUAL(v[0].obj_.val_, "http://a/o");
+   BOOST_CHECK_EQUAL(v[0].graph_.kind_, Nt_term::None);
+
+   BOOST_CHECK_EQUAL(v[1].subj_.kind_, Nt_term::Blank);
+   BOOST_CHECK_EQUAL(v[1].subj_.val_, "b1");
+   BOOST_CHECK_EQUAL(v[1].obj_.kind_, Nt_term::Literal);
+   BOOST_CHECK_EQUAL(v[1].obj_.val_, "x\ty\xC3\xA9\"");
+   BOOST_CHECK_EQUAL(v[1].obj_.lang_, "en-US");
+   BOOST_CHECK(v[1].obj_.dt_.empty());
+
+   BOOST_CHECK_EQUAL(v[2].obj_.val_, "1");
+   BOOST_CHECK_EQUAL(v[2].obj_.dt_, "http://www.w3.org/2001/XMLSchema#int");
+
+   BOOST_CHECK_EQUAL(v[3].subj_.val_, "b2.x");
+   BOOST_CHECK_EQUAL(v[3].obj_.kind_, Nt_term::Blank);
+   BOOST_CHECK_EQUAL(v[3].obj_.val_, "b3");
+
+   BOOST_CHECK_EQUAL(v[4].graph_.kind_, Nt_term::Iri);
+   BOOST_CHECK_EQUAL(v[4].graph_.val_, "http://a/g");
+
+   BOOST_CHECK_EQUAL(v[5].subj_.val_, "http://a/s");
+   BOOST_CHECK_EQUAL(v[5].obj_.val_, "");
+   BOOST_CHECK_EQUAL(v[5].graph_.kind_, Nt_term::Blank);
+}
+
+/**@test Syntax errors
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_nt_parser_errors ) {
+   char const* const bad[] = {
+            "<http://a/s> <http://a/p> <http://a/o>\n",
+            "<http://a/s> <http://a/p> <http://a/o> . x\n",
+            "\"s\" <http://a/p> <http://a/o> .\n",
+            "<http://a/s> _:p <http://a/o> .\n",
+            "<http://a/s> <http://a/p> \"o .\n",
+            "<http://a/s> <http://a/p> \"\\q\" .\n",
+            "<http://a/s> <http://a/p> <http://a/o .\n",
+            "<http://a/s> <http://a/p> \"o\"@ .\n"
+   };
+   for(std::size_t i = 0; i != sizeof(bad) / sizeof(bad[0]); ++i) {
+      Nt_parser p;
+      BOOST_CHECK_THROW(parse(p, bad[i]), Nt_parser::Err);
+      BOOST_CHECK(p.error_position());
+   }
+}
+
+/**@test Load N-Triples document in several chunks
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_ntriples_to_store ) {
+   std::string s = ont1;
+   for(unsigned i = 0; i != 1000; ++i) {
+      const std::string n = boost::lexical_cast<std::string>(i % 100);
+      s += "<http://example.xyz/ont1#c" + n + "> "
+               "<http://www.w3.org/2000/01/rdf-schema#label> \"c" + n + "\" .\n";
+      s += "_:x" + n + " <http://example.xyz/ont1#p> "
+               "<http://example.xyz/ont1#c" + n + "> .\n";
+   }
+
+   const Check_id check;
+   Triple_store ts1;
+   Ntriples_to_store nts1(ts1, "path1", check, 1);
+   nts1.parse(s.data(), s.data() + s.size());
+
+   Triple_store ts2;
+   Ntriples_to_store nts2(ts2, "path1", check, 3, 64);
+   nts2.parse(s.data(), s.data() + s.size());
+
+   BOOST_CHECK_EQUAL(ts1.map_triple().size(), 203U);
+   BOOST_CHECK_EQUAL(ts2.map_triple().size(), ts1.map_triple().size());
+   BOOST_CHECK_EQUAL(ts2.map_node().size(), ts1.map_node().size());
+   BOOST_REQUIRE_EQUAL(ts2.map_doc().size(), 1U);
+   BOOST_REQUIRE(ts2.find_doc_iri("http://example.xyz/ont1"));
+   const Doc_id did = ts2.find_doc_iri("http://example.xyz/ont1").front();
+   BOOST_CHECK_EQUAL(ts2[ts2[did].version_iri], ts2[*ts2.find_node_iri("http://example.xyz/ont1/v1")]);
+   BOOST_REQUIRE_EQUAL(nts2.imports().size(), 1U);
+   BOOST_CHECK_EQUAL(nts2.imports()[0], "http://example.xyz/ont2");
+   BOOST_CHECK(ts2.find_literal("c42", "", ""));
+}
+
+/**@test Load gzip-compressed N-Triples document
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_ntriples_compressed ) {
+   std::string s = ont1;
+   for(unsigned i = 0; i != 1000; ++i) {
+      const std::string n = boost::lexical_cast<std::string>(i);
+      s += "_:x" + n + " <http://example.xyz/ont1#p> \"c" + n + "\" .\n";
+   }
+   const std::string file = temp_file_path() + "/ntriples_run.nt.gz";
+   {
+      boost::filesystem::ofstream ofs(file, std::ios::binary);
+      boost::iostreams::filtering_ostream os;
+      os.push(boost::iostreams::gzip_compressor());
+      os.push(ofs);
+      os << s;
+   }
+
+   Triple_store ts1;
+   Ntriples_to_store(ts1, "path1", Check_id()).parse(s.data(), s.data() + s.size());
+   const Check_id check;
+   Triple_store ts2;
+   Ntriples_to_store nts2(ts2, "path1", check, 2, 256);
+   nts2.parse_file(file);
+   BOOST_CHECK_EQUAL(ts2.map_triple().size(), 1003U);
+   BOOST_CHECK_EQUAL(ts2.map_node().size(), ts1.map_node().size());
+   BOOST_CHECK(ts2.find_doc_iri("http://example.xyz/ont1"));
+   BOOST_CHECK_EQUAL(nts2.imports().size(), 1U);
+
+   //syntax error line is counted across batches
+   s += "<http://a/s> <http://a/p> .\n";
+   {
+      boost::filesystem::ofstream ofs(file, std::ios::binary);
+      boost::iostreams::filtering_ostream os;
+      os.push(boost::iostreams::gzip_compressor());
+      os.push(ofs);
+      os << s;
+   }
+   Triple_store ts3;
+   try{
+      Ntriples_to_store(ts3, "path1", Check_id(), 2, 256).parse_file(file);
+      BOOST_ERROR("exception expected");
+   } catch(Input_err const& e) {
+      int const* line = boost::get_error_info<Input_err::int1_t>(e);
+      BOOST_REQUIRE(line);
+      BOOST_CHECK_EQUAL(*line, 1004);
+   }
+   BOOST_CHECK_EQUAL(ts3.map_triple().size(), 0U);
+}
+
+/**@test Failed parsing leaves the store unchanged
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_ntriples_error ) {
+   Triple_store ts;
+   const std::string s1 = ont1;
+   Ntriples_to_store(ts, "path1", Check_id()).parse(s1.data(), s1.data() + s1.size());
+   const std::size_t n_node = ts.map_node().size();
+   const std::size_t n_triple = ts.map_triple().size();
+
+   const std::string s2 =
+            "<http://example.xyz/ont3> "
+            "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+            "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+            "<http://example.xyz/ont3#a> <http://example.xyz/ont3#b> _:c .\n"
+            "<http://example.xyz/ont3#a> <http://example.xyz/ont3#b> .\n"
+   ;
+   try{
+      Ntriples_to_store(ts, "path3", Check_id(), 2, 16).parse(s2.data(), s2.data() + s2.size());
+      BOOST_ERROR("exception expected");
+   } catch(Input_err const& e) {
+      int const* line = boost::get_error_info<Input_err::int1_t>(e);
+      BOOST_REQUIRE(line);
+      BOOST_CHECK_EQUAL(*line, 3);
+   }
+   BOOST_CHECK_EQUAL(ts.map_node().size(), n_node);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+
+   //same ontology again
+   BOOST_CHECK_THROW(
+            Ntriples_to_store(ts, "path2", Check_id()).parse(s1.data(), s1.data() + s1.size()),
+            Input_err
+   );
+   BOOST_CHECK_EQUAL(ts.map_node().size(), n_node);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+}
+
+/**@test Named graphs of N-Quads document become separate documents
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_nquads ) {
+   const std::string s =
+            "<http://a/s> <http://a/p> _:b <http://a/g1> .\n"
+            "_:b <http://a/p> \"x\" <http://a/g2> .\n"
+            "<http://a/s> <http://a/p> _:b <http://a/g2> .\n"
+            "<http://a/s> <http://a/p> <http://a/o> <http://a/g1> .\n"
+   ;
+   Triple_store ts;
+   Ntriples_to_store(ts, "path1", Check_id(), 2, 8).parse(s.data(), s.data() + s.size());
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 4U);
+   BOOST_REQUIRE(ts.find_doc_iri("http://a/g1"));
+   BOOST_REQUIRE(ts.find_doc_iri("http://a/g2"));
+   const Doc_id did1 = ts.find_doc_iri("http://a/g1").front();
+   const Doc_id did2 = ts.find_doc_iri("http://a/g2").front();
+   BOOST_CHECK_NE(did1, did2);
+   BOOST_CHECK_EQUAL(ts[did1].path, "path1#http://a/g1");
+   BOOST_CHECK_EQUAL(boost::distance(ts.map_triple().doc_triples(did1)), 2);
+   BOOST_CHECK_EQUAL(boost::distance(ts.map_triple().doc_triples(did2)), 2);
+
+   //graphs conflicting with loaded documents
+   Triple_store ts2;
+   ts2.insert_doc("http://a/g2", "path0");
+   const std::size_t n_node = ts2.map_node().size();
+   BOOST_CHECK_THROW(
+            Ntriples_to_store(ts2, "path1", Check_id()).parse(s.data(), s.data() + s.size()),
+            Input_err
+   );
+   BOOST_CHECK_EQUAL(ts2.map_node().size(), n_node);
+   BOOST_CHECK_EQUAL(ts2.map_doc().size(), 1U);
+   BOOST_CHECK_EQUAL(ts2.map_triple().size(), 0U);
+}
+
+/**@brief write N-Triples ontology document importing ontologies @b imports
+*******************************************************************************/
+void write_ontology(
+         boost::filesystem::path const& dir,
+         std::string const& name,
+         std::vector<std::string> const& imports = std::vector<std::string>()
+) {
+   boost::filesystem::ofstream ofs(dir / (name + ".nt"));
+   const std::string iri = "<http://example.xyz/" + name + ">";
+   ofs
+   << iri << " <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+   << "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+   ;
+   for(std::size_t i = 0; i != imports.size(); ++i) ofs
+   << iri << " <http://www.w3.org/2002/07/owl#imports> "
+   << "<http://example.xyz/" << imports[i] << "> .\n"
+   ;
+}
+
+/**@test Import N-Triples documents found in catalog
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_ntriples_imports ) {
+   const boost::filesystem::path dir = temp_file_path() + "/ntriples_run_imports";
+   boost::filesystem::remove_all(dir);
+   boost::filesystem::create_directories(dir);
+   {
+      boost::filesystem::ofstream ofs(dir / "ont1.nt");
+      ofs << ont1;
+   }
+   {
+      boost::filesystem::ofstream ofs(dir / "ont2.nt.gz", std::ios::binary);
+      boost::iostreams::filtering_ostream os;
+      os.push(boost::iostreams::gzip_compressor());
+      os.push(ofs);
+      os
+      << "<http://example.xyz/ont2#a> <http://example.xyz/ont2#p> \"x\" .\n"
+      << "<http://example.xyz/ont2> "
+      << "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+      << "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+      ;
+   }
+
+   Catalog cat;
+   BOOST_CHECK_EQUAL(add(cat, dir), 2U);
+   BOOST_REQUIRE(cat.find_doc_iri("http://example.xyz/ont1"));
+   const Doc_id cdid1 = cat.find_doc_iri("http://example.xyz/ont1").front();
+   BOOST_CHECK_EQUAL(cat.version_iri_str(cdid1), "http://example.xyz/ont1/v1");
+   BOOST_CHECK(cat.find_doc_iri("http://example.xyz/ont2"));
+
+   Triple_store ts;
+   load_iri("http://example.xyz/ont1", ts, cat);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 5U);
+   BOOST_REQUIRE(ts.find_doc_iri("http://example.xyz/ont2"));
+   const Doc_id did2 = ts.find_doc_iri("http://example.xyz/ont2").front();
+   BOOST_CHECK_EQUAL(boost::distance(ts.map_triple().doc_triples(did2)), 2);
+   BOOST_CHECK(ts.find_literal("x", "", ""));
+}
+
+/**@test Imports are added depth-first in the order of import statements
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_imports_order ) {
+   const boost::filesystem::path dir = temp_file_path() + "/ntriples_run_order";
+   boost::filesystem::remove_all(dir);
+   boost::filesystem::create_directories(dir);
+   std::vector<std::string> v;
+   v.push_back("a");
+   v.push_back("b");
+   write_ontology(dir, "r", v);
+   v.assign(1, "c");
+   write_ontology(dir, "a", v);
+   v.assign(1, "a");
+   write_ontology(dir, "b", v);
+   write_ontology(dir, "c");
+
+   Catalog cat;
+   BOOST_CHECK_EQUAL(add(cat, dir), 4U);
+   Triple_store ts;
+   load_file(dir / "r.nt", ts, cat, Check_id(), 2);
+   BOOST_REQUIRE_EQUAL(ts.map_doc().size(), 4U);
+   const Doc_id did_r = ts.find_doc_iri("http://example.xyz/r").front();
+   const Doc_id did_a = ts.find_doc_iri("http://example.xyz/a").front();
+   const Doc_id did_b = ts.find_doc_iri("http://example.xyz/b").front();
+   const Doc_id did_c = ts.find_doc_iri("http://example.xyz/c").front();
+   BOOST_CHECK_LT(did_r, did_a);
+   BOOST_CHECK_LT(did_a, did_c);
+   BOOST_CHECK_LT(did_c, did_b);
+}
+
+}//namespace test
+}//namespace owlcpp
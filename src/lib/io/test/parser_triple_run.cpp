@@ -28,5 +28,36 @@ BOOST_AUTO_TEST_CASE( test_parser ) {
    //BOOST_ERROR("");
 }
 
+/** count parsed statements */
+struct Triple_counter {
+   Triple_counter() : n_(0) {}
+   void insert(void const*) {++n_;}
+   std::size_t n_;
+};
+
+/**@test same triples are parsed from streams, in small or large chunks,
+and from memory-mapped files
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_parser_chunks ) {
+   BOOST_FOREACH(Sample_info const& si, sample_files()) {
+      Raptor_wrapper parser1(7);
+      BOOST_CHECK_EQUAL(parser1.chunk_size(), 7U);
+      Triple_counter tc1;
+      boost::filesystem::ifstream ifs1(si.path);
+      parser1(ifs1, tc1);
+
+      Raptor_wrapper parser2;
+      BOOST_CHECK_EQUAL(parser2.chunk_size(), Raptor_wrapper::default_chunk_size());
+      Triple_counter tc2;
+      boost::filesystem::ifstream ifs2(si.path);
+      parser2(ifs2, tc2);
+      BOOST_CHECK_EQUAL(tc1.n_, tc2.n_);
+
+      Triple_counter tc3;
+      parser2.parse_mapped(si.path, tc3);
+      BOOST_CHECK_EQUAL(tc1.n_, tc3.n_);
+   }
+}
+
 }//namespace test
 }//namespace owlcpp
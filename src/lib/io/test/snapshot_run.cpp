@@ -0,0 +1,186 @@
+/** @file "/owlcpp/lib/io/test/snapshot_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE snapshot_run
+#include "boost/test/unit_test.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include "boost/cstdint.hpp"
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/fstream.hpp"
+#include "boost/foreach.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_data.hpp"
+#include "test/sample_triples.hpp"
+#include "owlcpp/io/exception.hpp"
+#include "owlcpp/io/snapshot.hpp"
+#include "owlcpp/rdf/print_node.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace t = owlcpp::terms;
+
+const std::string snap1 = temp_file_path() + "/snapshot_run_01.bin";
+
+/**@test Save and restore triple store
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_snapshot_01 ) {
+   Triple_store ts1;
+   sample_triples_01(ts1);
+   sample_triples_02(ts1);
+   const Ns_id nsid = ts1.insert(ns1);
+   ts1.insert_prefix(nsid, ns1p);
+   const Doc_id did = *ts1.map_doc().begin();
+   const Node_id nl1 = ts1.insert_literal("42", t::xsd_int::id());
+   const Node_id nl2 = ts1.insert_literal("true", t::xsd_boolean::id());
+   const Node_id nl3 = ts1.insert_literal("3.5", t::xsd_double::id());
+   const Node_id nl4 = ts1.insert_literal("7", t::xsd_unsignedInt::id());
+   const Node_id nl5 = ts1.insert_literal("blah", t::xsd_string::id(), "en");
+   ts1.insert(Triple::make(nl1, t::rdfs_label::id(), nl5, did));
+   ts1.insert(Triple::make(nl2, t::rdfs_label::id(), nl3, did));
+   ts1.insert(Triple::make(nl4, t::rdfs_label::id(), nl1, did));
+
+   save_snapshot(ts1, snap1);
+   Triple_store ts2;
+   load_snapshot(snap1, ts2);
+
+   BOOST_CHECK_EQUAL(ts1.map_ns().size(), ts2.map_ns().size());
+   BOOST_CHECK_EQUAL(ts2.prefix(nsid), ns1p);
+   BOOST_REQUIRE_EQUAL(ts1.map_node().size(), ts2.map_node().size());
+   BOOST_FOREACH(const Node_id nid, ts1.map_node()) {
+      BOOST_REQUIRE(ts2.find(nid));
+      BOOST_CHECK(ts1[nid] == ts2[nid]);
+      BOOST_CHECK_EQUAL(to_string(nid, ts1), to_string(nid, ts2));
+   }
+   BOOST_REQUIRE_EQUAL(ts1.map_doc().size(), ts2.map_doc().size());
+   BOOST_FOREACH(const Doc_id d, ts1.map_doc()) {
+      BOOST_REQUIRE(ts2.find(d));
+      BOOST_CHECK_EQUAL(ts1[d].path, ts2[d].path);
+      BOOST_CHECK_EQUAL(ts1[d].ontology_iri, ts2[d].ontology_iri);
+      BOOST_CHECK_EQUAL(ts1[d].version_iri, ts2[d].version_iri);
+   }
+   BOOST_REQUIRE_EQUAL(ts1.map_triple().size(), ts2.map_triple().size());
+   BOOST_CHECK(
+            std::equal(
+                     ts1.map_triple().begin(),
+                     ts1.map_triple().end(),
+                     ts2.map_triple().begin()
+            )
+   );
+   BOOST_CHECK_EQUAL(
+            distance(ts2.find_triple(any, t::rdfs_label::id(), any, any)),
+            3
+   );
+
+   //restored store remains usable
+   BOOST_CHECK_EQUAL(ts2.insert_node_iri(iri11), *ts1.find_node_iri(iri11));
+   ts2.insert_node_iri(iri24);
+   BOOST_CHECK_EQUAL(ts2.map_node().size(), ts1.map_node().size() + 1);
+}
+
+/**@test Invalid snapshots
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_snapshot_02 ) {
+   Triple_store ts1;
+   sample_triples_01(ts1);
+   save_snapshot(ts1, snap1);
+
+   //store should be empty
+   BOOST_CHECK_THROW(load_snapshot(snap1, ts1), Input_err);
+
+   //truncated snapshot
+   const std::string snap2 = temp_file_path() + "/snapshot_run_02.bin";
+   boost::filesystem::copy_file(
+            snap1, snap2,
+            boost::filesystem::copy_option::overwrite_if_exists
+   );
+   boost::filesystem::resize_file(snap2, boost::filesystem::file_size(snap2) - 3);
+   Triple_store ts2;
+   BOOST_CHECK_THROW(load_snapshot(snap2, ts2), Input_err);
+   BOOST_CHECK(ts2.map_node().empty());
+   BOOST_CHECK(ts2.map_triple().empty());
+
+   //not a snapshot
+   BOOST_CHECK_THROW(
+            load_snapshot(sample_file_path("version_test_b.owl"), ts2),
+            Input_err
+   );
+}
+
+/**@brief copy of snapshot with 64-bit number at @b pos replaced by @b n */
+std::string patch_count(
+         std::string const& snap,
+         const std::size_t pos,
+         const boost::uint64_t n
+) {
+   const std::string path = temp_file_path() + "/snapshot_run_03.bin";
+   boost::filesystem::copy_file(
+            snap, path,
+            boost::filesystem::copy_option::overwrite_if_exists
+   );
+   boost::filesystem::fstream fs(
+            path, std::ios_base::in | std::ios_base::out | std::ios_base::binary
+   );
+   fs.seekp(pos);
+   fs.write(reinterpret_cast<char const*>(&n), sizeof(n));
+   return path;
+}
+
+/**@test Reject element counts that exceed the size of snapshot
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_snapshot_03 ) {
+   Triple_store ts1;
+   sample_triples_01(ts1);
+   save_snapshot(ts1, snap1);
+   const boost::uint64_t n_triples = ts1.map_triple().size();
+
+   std::string buff;
+   {
+      boost::filesystem::ifstream ifs(snap1, std::ios_base::binary);
+      buff.assign(
+               std::istreambuf_iterator<char>(ifs),
+               std::istreambuf_iterator<char>()
+      );
+   }
+   //triple array is aligned and preceded by triple count and padding
+   const std::size_t triples_pos = buff.size() - n_triples * 16;
+   std::size_t count_pos = 0;
+   for( std::size_t pad = 0; pad != 8; ++pad ) {
+      boost::uint64_t n;
+      std::memcpy(&n, buff.data() + triples_pos - pad - sizeof(n), sizeof(n));
+      if( n == n_triples ) {
+         count_pos = triples_pos - pad - sizeof(n);
+         break;
+      }
+   }
+   BOOST_REQUIRE(count_pos);
+
+   //n * sizeof(Triple) wraps around to a small number
+   const boost::uint64_t counts[] = {
+            n_triples + 1,
+            (boost::uint64_t(1) << 60) + 1,
+            ~boost::uint64_t(0)
+   };
+   BOOST_FOREACH(const boost::uint64_t n, counts) {
+      Triple_store ts2;
+      BOOST_CHECK_THROW(load_snapshot(patch_count(snap1, count_pos, n), ts2), Input_err);
+      BOOST_CHECK(ts2.map_node().empty());
+      BOOST_CHECK(ts2.map_triple().empty());
+   }
+
+   //namespace count follows magic string and four 32-bit header fields
+   const std::size_t ns_pos = sizeof("owlcpp_snapshot") + 16;
+   Triple_store ts3;
+   BOOST_CHECK_THROW(
+            load_snapshot(patch_count(snap1, ns_pos, ~boost::uint64_t(0)), ts3),
+            Input_err
+   );
+   BOOST_CHECK(ts3.map_ns().empty());
+}
+
+}//namespace test
+}//namespace owlcpp
@@ -0,0 +1,87 @@
+/** @file "/owlcpp/lib/io/test/statement_pipeline_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE statement_pipeline_run
+#include "boost/test/unit_test.hpp"
+#include <string>
+#include <vector>
+#include "boost/lexical_cast.hpp"
+#include "boost/ref.hpp"
+#include "test/exception_fixture.hpp"
+#include "owlcpp/io/exception.hpp"
+#include "statement_pipeline.hpp"
+
+namespace owlcpp{ namespace test{
+
+using owlcpp::detail::Statement_block;
+using owlcpp::detail::Statement_pipeline;
+using owlcpp::detail::Term_rec;
+
+/**@brief Collect statements passed through pipeline
+*******************************************************************************/
+struct Collector {
+   explicit Collector(const std::size_t fail_at = -1)
+   : fail_at_(fail_at) {}
+
+   void operator()(Statement_block const& b) {
+      for( std::size_t n = 0; n != b.size(); ++n ) {
+         if( v_.size() == fail_at_ ) BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("test error")
+         );
+         Term_rec const& s = b.term(n, 0);
+         Term_rec const& o = b.term(n, 2);
+         v_.push_back(
+                  b.str(s.val_, s.val_len_).to_string() + ' ' +
+                  boost::lexical_cast<std::string>(b.term(n, 1).blank_) + ' ' +
+                  b.str(o.val_, o.val_len_).to_string() + '@' +
+                  b.str(o.lang_, o.lang_len_).to_string()
+         );
+      }
+   }
+
+   std::size_t fail_at_;
+   std::vector<std::string> v_;
+};
+
+void add(Statement_block& b, const unsigned i) {
+   const std::string s = "s" + boost::lexical_cast<std::string>(i);
+   b.add_iri(s.data(), s.size());
+   b.add_blank(i);
+   b.add_literal("o", "", i % 2 ? "en" : "");
+}
+
+/**@test Statements are consumed in order
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_pipeline_order ) {
+   Collector c;
+   Statement_pipeline sp(boost::ref(c), 3, 7);
+   for( unsigned i = 0; i != 1000; ++i ) {
+      add(sp.block(), i);
+      if( sp.block().full() ) BOOST_REQUIRE(sp.push());
+   }
+   sp.finish();
+   BOOST_REQUIRE_EQUAL(c.v_.size(), 1000U);
+   BOOST_CHECK_EQUAL(c.v_[0], "s0 0 o@");
+   BOOST_CHECK_EQUAL(c.v_[999], "s999 999 o@en");
+}
+
+/**@test Consumer exception is rethrown by finish()
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_pipeline_error ) {
+   Collector c(100);
+   Statement_pipeline sp(boost::ref(c), 2, 10);
+   unsigned i = 0;
+   for( ; i != 10000; ++i ) {
+      add(sp.block(), i);
+      if( sp.block().full() && ! sp.push() ) break;
+   }
+   BOOST_CHECK_THROW(sp.finish(), Input_err);
+   BOOST_CHECK_EQUAL(c.v_.size(), 100U);
+   BOOST_CHECK(sp.failed());
+}
+
+}//namespace test
+}//namespace owlcpp
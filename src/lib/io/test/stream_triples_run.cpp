@@ -0,0 +1,117 @@
+/** @file "/owlcpp/lib/io/test/stream_triples_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE stream_triples_run
+#include "boost/test/unit_test.hpp"
+#include <string>
+#include <vector>
+#include "boost/filesystem/fstream.hpp"
+#include "boost/lexical_cast.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_data.hpp"
+#include "owlcpp/io/catalog.hpp"
+#include "owlcpp/io/input.hpp"
+#include "owlcpp/io/stream_triples.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+
+namespace owlcpp{ namespace test{
+
+/**@brief Count streamed statements and copy some of their terms
+*******************************************************************************/
+class Count_statements : public Statement_visitor {
+public:
+   Count_statements() : n_(0), n_blank_(0), n_literal_(0) {}
+
+   std::size_t n_, n_blank_, n_literal_;
+   std::vector<std::string> docs_;
+   std::vector<std::string> literals_;
+
+private:
+   void document_impl(std::string const& path) {docs_.push_back(path);}
+
+   void visit_impl(
+            Stream_term const& subj,
+            Stream_term const& pred,
+            Stream_term const& obj
+   ) {
+      ++n_;
+      if( subj.kind == Stream_term::Blank ) ++n_blank_;
+      if( obj.kind == Stream_term::Literal ) {
+         ++n_literal_;
+         literals_.push_back(
+                  obj.value.to_string() + '|' +
+                  obj.datatype.to_string() + '|' +
+                  obj.language.to_string()
+         );
+      }
+   }
+};
+
+/**@test Stream N-Triples document in several blocks
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_stream_ntriples ) {
+   std::string s =
+            "<http://example.xyz/ont1> "
+            "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+            "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+            "<http://example.xyz/ont1#a> <http://example.xyz/ont1#p> "
+            "\"1\"^^<http://www.w3.org/2001/XMLSchema#int> .\n"
+            "<http://example.xyz/ont1#a> <http://example.xyz/ont1#p> "
+            "\"x\"@en .\n"
+   ;
+   for(unsigned i = 0; i != 100000; ++i) {
+      const std::string n = boost::lexical_cast<std::string>(i);
+      s += "_:x" + n + " <http://example.xyz/ont1#p> <http://example.xyz/ont1#c> .\n";
+   }
+   const std::string file = temp_file_path() + "/stream_triples_run.nt";
+   {
+      boost::filesystem::ofstream ofs(file, std::ios::binary);
+      ofs << s;
+   }
+
+   Count_statements cs;
+   stream_file(file, cs);
+   BOOST_REQUIRE_EQUAL(cs.docs_.size(), 1U);
+   BOOST_CHECK_EQUAL(cs.n_, 100003U);
+   BOOST_CHECK_EQUAL(cs.n_blank_, 100000U);
+   BOOST_REQUIRE_EQUAL(cs.n_literal_, 2U);
+   BOOST_CHECK_EQUAL(cs.literals_[0], "1|http://www.w3.org/2001/XMLSchema#int|");
+   BOOST_CHECK_EQUAL(cs.literals_[1], "x||en");
+
+   //syntax error is reported with line number
+   s += "<http://a/s> <http://a/p> .\n";
+   {
+      boost::filesystem::ofstream ofs(file, std::ios::binary);
+      ofs << s;
+   }
+   Count_statements cs2;
+   try{
+      stream_file(file, cs2);
+      BOOST_ERROR("exception expected");
+   } catch(Input_err const& e) {
+      int const* line = boost::get_error_info<Input_err::int1_t>(e);
+      BOOST_REQUIRE(line);
+      BOOST_CHECK_EQUAL(*line, 100004);
+   }
+   BOOST_CHECK_LT(cs2.n_, 100004U);
+}
+
+/**@test Stream import closure; compare to loaded triple store
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_stream_imports ) {
+   const std::string path = sample_files()[3].path;
+   Catalog cat;
+   add(cat, sample_file_path());
+
+   Triple_store ts;
+   load_file(path, ts, cat);
+   Count_statements cs;
+   stream_file(path, cs, cat);
+   BOOST_CHECK_EQUAL(cs.docs_.size(), ts.map_doc().size());
+   BOOST_CHECK_EQUAL(cs.n_, ts.map_triple().size());
+}
+
+}//namespace test
+}//namespace owlcpp
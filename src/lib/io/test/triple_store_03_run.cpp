@@ -5,6 +5,7 @@ part of owlcpp project.
 *******************************************************************************/
 #define BOOST_TEST_MODULE triple_store_01_run
 #include "boost/test/unit_test.hpp"
+#include <algorithm>
 #include <iostream>
 #include "boost/filesystem.hpp"
 #include "boost/filesystem/fstream.hpp"
@@ -114,6 +115,58 @@ BOOST_AUTO_TEST_CASE( test_triple_store_05 ) {
    BOOST_CHECK_GT( ts.map_triple().size(), 18u );
 }
 
+/**@test Imports parsed concurrently are merged in the same order
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_triple_store_06 ) {
+   Catalog cat;
+   add(cat, sample_file_path());
+   Triple_store ts1;
+   load_file(path3, ts1, cat, Check_id(), 1);
+   Triple_store ts4;
+   load_file(path3, ts4, cat, Check_id(), 4);
+
+   BOOST_REQUIRE_EQUAL( ts1.map_triple().size(), ts4.map_triple().size() );
+   BOOST_CHECK_EQUAL( ts1.map_doc().size(), ts4.map_doc().size() );
+   BOOST_CHECK_EQUAL( ts1.map_node().size(), ts4.map_node().size() );
+   BOOST_CHECK(
+            std::equal(
+                     ts1.map_triple().begin(),
+                     ts1.map_triple().end(),
+                     ts4.map_triple().begin()
+            )
+   );
+}
+
+/**@test Pipelined parsing produces same store
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_triple_store_07 ) {
+   Triple_store ts1;
+   owlcpp::detail::Raptor_to_store rts1(ts1, path3, Check_id());
+   rts1.parse_file(path3);
+   Triple_store ts2;
+   owlcpp::detail::Raptor_to_store rts2(ts2, path3, Check_id());
+   rts2.parse_file_pipelined(path3);
+
+   BOOST_REQUIRE( ts2.find_doc_iri(iri3) );
+   BOOST_CHECK_EQUAL( ts1.map_node().size(), ts2.map_node().size() );
+   BOOST_REQUIRE_EQUAL( ts1.map_triple().size(), ts2.map_triple().size() );
+   BOOST_CHECK(
+            std::equal(
+                     ts1.map_triple().begin(),
+                     ts1.map_triple().end(),
+                     ts2.map_triple().begin()
+            )
+   );
+   BOOST_CHECK( rts1.imports() == rts2.imports() );
+
+   //same ontology again
+   owlcpp::detail::Raptor_to_store rts3(ts2, path3, Check_id());
+   const std::size_t n_node = ts2.map_node().size();
+   BOOST_CHECK_THROW(rts3.parse_file_pipelined(path3), Input_err);
+   BOOST_CHECK_EQUAL( ts2.map_node().size(), n_node );
+   BOOST_CHECK_EQUAL( ts2.map_doc().size(), 1u );
+}
+
 /**@test
 *******************************************************************************/
 BOOST_AUTO_TEST_CASE( parse_invalid_docs ) {
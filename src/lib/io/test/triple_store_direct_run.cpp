@@ -0,0 +1,87 @@
+/** @file "/owlcpp/lib/io/test/triple_store_direct_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE triple_store_direct_run
+#include "boost/test/unit_test.hpp"
+#include "test/exception_fixture.hpp"
+#include "test/sample_triples.hpp"
+#include "owlcpp/terms/node_tags_owl.hpp"
+#include "triple_store_direct.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace t = owlcpp::terms;
+
+/** insert nodes and triples of a small document */
+void insert_doc(owlcpp::detail::Triple_store_direct& tsd) {
+   const Node_id n1 = tsd.insert_node_iri(iri11);
+   const Node_id n2 = tsd.insert_node_iri(iri24);
+   const Node_id n3 = tsd.insert_node_iri("http://example.xyz/example5#node1");
+   const Node_id n4 = tsd.insert_blank(1);
+   const Node_id n5 = tsd.insert_literal("blah", t::xsd_string::id(), "en");
+   tsd.insert_triple(n1, t::rdf_type::id(), n2);
+   tsd.insert_triple(n4, n3, n5);
+   tsd.insert_triple(n4, n3, n5);
+}
+
+/**@test Nodes are removed if document is not committed
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_rollback ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   const std::size_t n_ns = ts.map_ns().size();
+   const std::size_t n_node = ts.map_node().size();
+   const std::size_t n_triple = ts.map_triple().size();
+   {
+      owlcpp::detail::Triple_store_direct tsd(ts, path2);
+      insert_doc(tsd);
+      tsd.set_ids(doc2, "");
+      BOOST_CHECK_GT(ts.map_node().size(), n_node);
+   }
+   BOOST_CHECK_EQUAL(ts.map_ns().size(), n_ns);
+   BOOST_CHECK_EQUAL(ts.map_node().size(), n_node);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+   BOOST_CHECK( ts.find_node_iri(iri11) );
+   BOOST_CHECK( ! ts.find_node_iri(iri24) );
+   BOOST_CHECK( ! ts.find_node_iri(doc2) );
+
+   {
+      //same path as existing document with different ontologyIRI
+      owlcpp::detail::Triple_store_direct tsd(ts, path1);
+      insert_doc(tsd);
+      tsd.set_ids(doc2, "");
+      BOOST_CHECK_THROW(tsd.commit(), Input_err);
+   }
+   BOOST_CHECK_EQUAL(ts.map_ns().size(), n_ns);
+   BOOST_CHECK_EQUAL(ts.map_node().size(), n_node);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+}
+
+/**@test Commit document
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_commit ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   const std::size_t n_triple = ts.map_triple().size();
+   {
+      owlcpp::detail::Triple_store_direct tsd(ts, path2);
+      insert_doc(tsd);
+      tsd.set_ids(doc2, doc3);
+      tsd.commit();
+   }
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   BOOST_REQUIRE( ts.find_doc_iri(doc2) );
+   const Doc_id did = *ts.find_doc_iri(doc2).begin();
+   BOOST_CHECK_EQUAL(ts[did].path, path2);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), n_triple + 2);
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did)), 2);
+   BOOST_CHECK( ts.find_blank(1, did) );
+   BOOST_CHECK( ts.find_node_iri(iri24) );
+}
+
+}//namespace test
+}//namespace owlcpp
@@ -0,0 +1,104 @@
+/** @file "/owlcpp/lib/io/test/triple_writer_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE triple_writer_run
+#include "boost/test/unit_test.hpp"
+#include <sstream>
+#include <string>
+#include "boost/lexical_cast.hpp"
+#include "test/exception_fixture.hpp"
+#include "owlcpp/io/triple_writer.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+#include "ntriples_to_store.hpp"
+
+namespace owlcpp{ namespace test{
+
+using owlcpp::detail::Ntriples_to_store;
+
+const std::string nt1 =
+         "<http://example.xyz/ont1> "
+         "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+         "<http://www.w3.org/2002/07/owl#Ontology> .\n"
+         "<http://example.xyz/ont1#a> "
+         "<http://www.w3.org/2000/01/rdf-schema#label> \"a \\\"b\\\"\\n\"@en .\n"
+         "_:x <http://example.xyz/ont1#p> "
+         "\"5\"^^<http://www.w3.org/2001/XMLSchema#int> .\n"
+         "_:x <http://example.xyz/ont1#p> <http://example.xyz/ont2> .\n"
+         "<http://example.xyz/ont1#a> <http://example.xyz/ont1#p> "
+         "<http://example.xyz/ont1#1.x.> .\n"
+;
+
+void load(Triple_store& ts, std::string const& s, std::string const& path) {
+   Ntriples_to_store(ts, path, Check_id()).parse(s.data(), s.data() + s.size());
+}
+
+/**@test Written N-Triples document is parsed into same triples
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_ntriples ) {
+   Triple_store ts1;
+   load(ts1, nt1, "path1");
+   std::ostringstream os;
+   {
+      Triple_writer tw(ts1, os);
+      tw.write_range(ts1.map_triple());
+   }
+   const std::string s = os.str();
+   BOOST_CHECK_EQUAL(std::count(s.begin(), s.end(), '\n'), 5);
+
+   Triple_store ts2;
+   load(ts2, s, "path2");
+   BOOST_CHECK_EQUAL(ts2.map_triple().size(), ts1.map_triple().size());
+   BOOST_CHECK_EQUAL(ts2.map_node().size(), ts1.map_node().size());
+   BOOST_CHECK(ts2.find_literal("a \"b\"\n", "", "en"));
+   BOOST_CHECK(ts2.find_doc_iri("http://example.xyz/ont1"));
+}
+
+/**@test Turtle uses prefixes
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_turtle ) {
+   Triple_store ts;
+   load(ts, nt1, "path1");
+   std::ostringstream os;
+   write_triples(ts, os, Triple_writer::Turtle);
+   const std::string s = os.str();
+   BOOST_CHECK_NE(s.find("@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> ."), std::string::npos);
+   BOOST_CHECK_NE(s.find("<http://example.xyz/ont1> rdf:type owl:Ontology ."), std::string::npos);
+   BOOST_CHECK_NE(s.find("\"5\"^^xsd:int"), std::string::npos);
+}
+
+/**@test Parallel writing produces documents in order
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_write_parallel ) {
+   Triple_store ts;
+   load(ts, nt1, "path1");
+   std::string s =
+            "<http://example.xyz/ont3> "
+            "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+            "<http://www.w3.org/2002/07/owl#Ontology> .\n";
+   for( unsigned i = 0; i != 100000; ++i ) {
+      const std::string n = boost::lexical_cast<std::string>(i);
+      s += "<http://example.xyz/ont3#c" + n + "> "
+               "<http://www.w3.org/2000/01/rdf-schema#label> \"c" + n + "\" .\n";
+   }
+   load(ts, s, "path3");
+
+   std::ostringstream os1;
+   write_triples(ts, os1, Triple_writer::Ntriples, 1);
+   std::ostringstream os3;
+   write_triples(ts, os3, Triple_writer::Ntriples, 3);
+   BOOST_CHECK(os1.str() == os3.str());
+
+   std::ostringstream os;
+   {
+      Triple_writer tw(ts, os, Triple_writer::Ntriples, 1000);
+      BOOST_FOREACH(const Doc_id did, ts.map_doc()) {
+         tw.write_range(ts.map_triple().doc_triples(did));
+      }
+   }
+   BOOST_CHECK(os.str() == os1.str());
+}
+
+}//namespace test
+}//namespace owlcpp
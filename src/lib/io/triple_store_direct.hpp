@@ -0,0 +1,183 @@
+/** @file "/owlcpp/lib/io/triple_store_direct.hpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef TRIPLE_STORE_DIRECT_HPP_
+#define TRIPLE_STORE_DIRECT_HPP_
+#include <string>
+#include <vector>
+#include "boost/foreach.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/utility/string_ref.hpp"
+
+#include "owlcpp/io/exception.hpp"
+#include "owlcpp/rdf/triple_store.hpp"
+#include "owlcpp/terms/node_tags_system.hpp"
+
+namespace owlcpp{ namespace detail{
+
+/**@brief Insert nodes and triples of documents directly into a triple store
+@details Namespaces and nodes are added to the store as they are parsed and
+recorded in a journal; triples are kept until commit().
+The first document is added under the ID that the store will assign to its
+next document; documents added by add_doc() get subsequent unused IDs.
+Unless commit() succeeds, namespaces and nodes created by this object are
+removed from the store on destruction.
+The store should not be modified by other means until then.
+*******************************************************************************/
+class Triple_store_direct : boost::noncopyable {
+   struct Doc {
+      Doc(const Doc_id did, std::string const& path)
+      : did_(did),
+        path_(path),
+        iri_(terms::empty_::id()),
+        version_(terms::empty_::id())
+      {}
+      Doc_id did_;
+      std::string path_;
+      Node_id iri_;
+      Node_id version_;
+   };
+
+public:
+   Triple_store_direct(Triple_store& ts, std::string const& path)
+   : ts_(ts),
+     did_(ts.map_doc_.next_id()),
+     committed_(false)
+   {
+      docs_.push_back(Doc(did_, path));
+   }
+
+   ~Triple_store_direct() {if( ! committed_ ) rollback();}
+
+   std::string const& path() const {return docs_.front().path_;}
+
+   /**@return ID of the first document */
+   Doc_id doc_id() const {return did_;}
+
+   /**@brief add another document
+    @return ID under which the document will be added to the store
+   */
+   Doc_id add_doc(std::string const& path) {
+      Doc_id did(docs_.back().did_() + 1);
+      while( ts_.map_doc_.find(did) ) did = Doc_id(did() + 1);
+      docs_.push_back(Doc(did, path));
+      return did;
+   }
+
+   /**@brief do not add document @b did to the store;
+    the document should have no triples or blank nodes
+   */
+   void drop_doc(const Doc_id did) {
+      for( std::vector<Doc>::iterator i = docs_.begin(); i != docs_.end(); ++i ) {
+         if( i->did_ != did ) continue;
+         docs_.erase(i);
+         return;
+      }
+   }
+
+   Node_id insert_node_iri(boost::string_ref const& iri) {
+      boost::string_ref frag;
+      const boost::string_ref ns = split_fragment(iri, frag);
+      const std::size_t n_ns = ts_.map_ns_.size();
+      const Ns_id nsid = ts_.insert(ns);
+      if( ts_.map_ns_.size() != n_ns ) ns_.push_back(nsid);
+      const std::size_t n = ts_.map_node_.size();
+      return record(ts_.insert_node_iri(nsid, frag), n);
+   }
+
+   Node_id insert_literal(
+            boost::string_ref const& value,
+            const Node_id dt,
+            boost::string_ref const& lang
+   ) {
+      const std::size_t n = ts_.map_node_.size();
+      return record(ts_.map_node_.insert_literal(value, dt, lang), n);
+   }
+
+   Node_id insert_blank(const unsigned index) {return insert_blank(index, did_);}
+
+   Node_id insert_blank(const unsigned index, const Doc_id did) {
+      const std::size_t n = ts_.map_node_.size();
+      return record(ts_.map_node_.insert_blank(index, did), n);
+   }
+
+   void insert_triple(const Node_id subj, const Node_id pred, const Node_id obj) {
+      triples_.push_back(Triple::make(subj, pred, obj, did_));
+   }
+
+   void insert_triple(
+            const Node_id subj,
+            const Node_id pred,
+            const Node_id obj,
+            const Doc_id did
+   ) {
+      triples_.push_back(Triple::make(subj, pred, obj, did));
+   }
+
+   void set_ids(std::string const& ontologyIRI, std::string const& versionIRI) {
+      set_ids(insert_node_iri(ontologyIRI), insert_node_iri(versionIRI), did_);
+   }
+
+   void set_ids(const Node_id iri, const Node_id version, const Doc_id did) {
+      BOOST_FOREACH(Doc& doc, docs_) {
+         if( doc.did_ != did ) continue;
+         doc.iri_ = iri;
+         doc.version_ = version;
+         return;
+      }
+      BOOST_ASSERT(false && "unknown document ID");
+   }
+
+   /**@brief add document info and triples to the store
+    @throw Input_err if document info cannot be added; the store is then
+    restored on destruction
+   */
+   void commit() {
+      BOOST_ASSERT( ! committed_ );
+      ts_.map_triple_.insert(triples_.begin(), triples_.end());
+      std::size_t n = 0;
+      try{
+         for( ; n != docs_.size(); ++n ) {
+            Doc const& d = docs_[n];
+            ts_.map_doc_.insert(d.did_, d.iri_, d.path_, d.version_);
+         }
+      } catch(base_exception const&) {
+         BOOST_FOREACH(Doc const& d, docs_) ts_.map_triple_.erase_doc(d.did_);
+         for( std::size_t i = 0; i != n; ++i ) ts_.map_doc_.erase(docs_[i].did_);
+         BOOST_THROW_EXCEPTION(
+                  Input_err()
+                  << Input_err::msg_t("error adding document")
+                  << Input_err::str1_t(docs_[n].path_)
+                  << Input_err::nested_t(boost::current_exception())
+         );
+      }
+      std::vector<Triple>().swap(triples_);
+      committed_ = true;
+   }
+
+private:
+   Triple_store& ts_;
+   const Doc_id did_;
+   bool committed_;
+   std::vector<Doc> docs_;
+   std::vector<Ns_id> ns_;
+   std::vector<Node_id> nodes_;
+   std::vector<Triple> triples_;
+
+   /** record node ID if the number of nodes has changed from @b n */
+   Node_id record(const Node_id nid, const std::size_t n) {
+      if( ts_.map_node_.size() != n ) nodes_.push_back(nid);
+      return nid;
+   }
+
+   void rollback() {
+      BOOST_REVERSE_FOREACH(const Node_id nid, nodes_) ts_.map_node_.erase(nid);
+      BOOST_REVERSE_FOREACH(const Ns_id nsid, ns_) ts_.map_ns_.remove(nsid);
+   }
+};
+
+}//namespace detail
+}//namespace owlcpp
+#endif /* TRIPLE_STORE_DIRECT_HPP_ */
@@ -0,0 +1,164 @@
+/** @file "/owlcpp/lib/io/triple_writer.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_IO_SOURCE
+#define OWLCPP_IO_SOURCE
+#endif
+#include "owlcpp/io/triple_writer.hpp"
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include "boost/foreach.hpp"
+
+#include "owlcpp/detail/parallel_for.hpp"
+#include "node_renderer.hpp"
+
+namespace owlcpp { namespace{
+
+/*
+*******************************************************************************/
+void write(std::ostream& os, std::string const& s) {
+   os.write(s.data(), static_cast<std::streamsize>(s.size()));
+   if( ! os ) BOOST_THROW_EXCEPTION(
+            Input_err()
+            << Input_err::msg_t("write error")
+   );
+}
+
+typedef std::pair<Triple const*, Triple const*> segment_t;
+
+/**@brief Render segments of triples into separate buffers
+*******************************************************************************/
+class Render_segments {
+public:
+   Render_segments(
+            Triple_store const& ts,
+            detail::Ns_strings const& ns,
+            const bool turtle,
+            std::vector<segment_t> const& segs,
+            const std::size_t first,
+            std::vector<std::string>& buffs
+   )
+   : ts_(ts), ns_(ns), turtle_(turtle), segs_(segs), first_(first), buffs_(buffs)
+   {}
+
+   void operator()(const std::size_t n) {
+      std::string& s = buffs_[n];
+      s.clear();
+      detail::Node_renderer r(ts_, ns_, turtle_, s);
+      segment_t const& seg = segs_[first_ + n];
+      for( Triple const* t = seg.first; t != seg.second; ++t ) r.triple(*t);
+   }
+
+private:
+   Triple_store const& ts_;
+   detail::Ns_strings const& ns_;
+   const bool turtle_;
+   std::vector<segment_t> const& segs_;
+   const std::size_t first_;
+   std::vector<std::string>& buffs_;
+};
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+Triple_writer::Triple_writer(
+         Triple_store const& store,
+         std::ostream& os,
+         const Format format,
+         const std::size_t buffer_size
+)
+: os_(os),
+  buffer_size_(buffer_size),
+  buff_(),
+  ns_(new detail::Ns_strings(store)),
+  renderer_(new detail::Node_renderer(store, *ns_, format == Turtle, buff_))
+{
+   buff_.reserve(buffer_size_ + 1024);
+   if( format == Turtle ) ns_->prefixes(buff_);
+}
+
+/*
+*******************************************************************************/
+Triple_writer::~Triple_writer() {
+   try{
+      flush();
+   } catch(...) {}
+}
+
+/*
+*******************************************************************************/
+void Triple_writer::write(Triple const& t) {
+   renderer_->triple(t);
+   if( buff_.size() >= buffer_size_ ) flush();
+}
+
+/*
+*******************************************************************************/
+void Triple_writer::flush() {
+   if( buff_.empty() ) return;
+   owlcpp::write(os_, buff_);
+   buff_.clear();
+}
+
+/*
+*******************************************************************************/
+void write_triples(
+         Triple_store const& store,
+         std::ostream& os,
+         const Triple_writer::Format format,
+         const unsigned n_threads
+) {
+   static const std::size_t segment_size = 1 << 16;
+   const unsigned nt = detail::n_threads_default(n_threads);
+   const bool turtle = format == Triple_writer::Turtle;
+   const detail::Ns_strings ns(store);
+
+   if( turtle ) {
+      std::string s;
+      ns.prefixes(s);
+      write(os, s);
+   }
+
+   //bound memory used for rendered segments
+   const std::size_t round = 2 * nt;
+   std::vector<std::string> buffs(round);
+
+   //group triples by document in a single pass over the store
+   std::vector<std::vector<Triple> > docs;
+   BOOST_FOREACH(const Triple t, store.map_triple()) {
+      const std::size_t n = t.doc_();
+      if( n >= docs.size() ) docs.resize(n + 1);
+      docs[n].push_back(t);
+   }
+
+   std::vector<segment_t> segs;
+   BOOST_FOREACH(const Doc_id did, store.map_doc()) {
+      if( did() >= docs.size() ) continue;
+      std::vector<Triple> v;
+      v.swap(docs[did()]);
+      if( v.empty() ) continue;
+      segs.clear();
+      Triple const* const last = &v[0] + v.size();
+      for( Triple const* t = &v[0]; t != last; ) {
+         Triple const* const e =
+                  static_cast<std::size_t>(last - t) > segment_size ?
+                  t + segment_size : last;
+         segs.push_back(segment_t(t, e));
+         t = e;
+      }
+
+      for( std::size_t i = 0; i < segs.size(); i += round ) {
+         const std::size_t n = std::min(round, segs.size() - i);
+         Render_segments rs(store, ns, turtle, segs, i, buffs);
+         detail::parallel_for(n, rs, nt);
+         for( std::size_t j = 0; j != n; ++j ) write(os, buffs[j]);
+      }
+   }
+}
+
+}//namespace owlcpp
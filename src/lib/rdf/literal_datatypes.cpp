@@ -44,7 +44,7 @@ const std::string Datatype_bool::false_str = std::string("false");
 /*
 *******************************************************************************/
 Datatype_bool::value_type
-Datatype_bool::convert(std::string const& str, const Node_id) {
+Datatype_bool::convert(boost::string_ref const str, const Node_id) {
    const boost::string_ref s = trim(str);
    if( s == true_str ) return true;
    if( s == false_str ) return false;
@@ -54,7 +54,7 @@ Datatype_bool::convert(std::string const& str, const Node_id) {
 /*
 *******************************************************************************/
 Datatype_int::value_type
-Datatype_int::convert(std::string const& str, const Node_id) {
+Datatype_int::convert(boost::string_ref const str, const Node_id) {
    const boost::string_ref s = trim(str);
    return boost::lexical_cast<value_type>(s);
 }
@@ -62,7 +62,7 @@ Datatype_int::convert(std::string const& str, const Node_id) {
 /*
 *******************************************************************************/
 Datatype_unsigned::value_type
-Datatype_unsigned::convert(std::string const& str, const Node_id dt) {
+Datatype_unsigned::convert(boost::string_ref const str, const Node_id dt) {
    const boost::string_ref s = trim(str);
    return boost::numeric_cast<value_type>(
             boost::lexical_cast<Datatype_int::value_type>(s)
@@ -72,7 +72,7 @@ Datatype_unsigned::convert(std::string const& str, const Node_id dt) {
 /*
 *******************************************************************************/
 Datatype_real::value_type
-Datatype_real::convert(std::string const& str, const Node_id dt) {
+Datatype_real::convert(boost::string_ref const str, const Node_id dt) {
    const boost::string_ref s = trim(str);
    return boost::lexical_cast<value_type>(s);
 }
@@ -0,0 +1,93 @@
+/** @file "/owlcpp/lib/rdf/parallel_for.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#ifndef OWLCPP_RDF_SOURCE
+#define OWLCPP_RDF_SOURCE
+#endif
+#include "owlcpp/detail/parallel_for.hpp"
+#include <vector>
+#include "boost/bind.hpp"
+#include "boost/exception_ptr.hpp"
+#include "boost/foreach.hpp"
+#include "boost/thread/locks.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+
+namespace owlcpp{ namespace detail{ namespace{
+
+/**@brief Take tasks from a shared counter and run them
+*******************************************************************************/
+class Parallel_worker {
+public:
+   Parallel_worker(
+            const std::size_t n,
+            boost::function<void(std::size_t)> const& fun,
+            std::vector<boost::exception_ptr>& err
+   )
+   : n_(n), i_(0), fun_(fun), err_(err)
+   {}
+
+   void run() {
+      for( std::size_t i = 0; next(i); ) {
+         try{
+            fun_(i);
+         } catch(...) {
+            err_[i] = boost::current_exception();
+         }
+      }
+   }
+
+private:
+   const std::size_t n_;
+   std::size_t i_;
+   boost::function<void(std::size_t)> const& fun_;
+   std::vector<boost::exception_ptr>& err_;
+   boost::mutex mutex_;
+
+   bool next(std::size_t& i) {
+      boost::lock_guard<boost::mutex> lock(mutex_);
+      if( i_ == n_ ) return false;
+      i = i_++;
+      return true;
+   }
+};
+
+}//namespace anonymous
+
+/*
+*******************************************************************************/
+unsigned n_threads_default(const unsigned n_threads) {
+   if( n_threads ) return n_threads;
+   const unsigned n = boost::thread::hardware_concurrency();
+   return n ? n : 1;
+}
+
+/*
+*******************************************************************************/
+void run_parallel(
+         const std::size_t n,
+         boost::function<void(std::size_t)> const& fun,
+         const unsigned n_threads
+) {
+   std::vector<boost::exception_ptr> err(n);
+   Parallel_worker worker(n, fun, err);
+   std::size_t nt = n_threads_default(n_threads);
+   if( nt > n ) nt = n;
+   if( nt < 2 ) {
+      worker.run();
+   } else {
+      boost::thread_group tg;
+      for(std::size_t i = 0; i != nt; ++i) {
+         tg.create_thread(boost::bind(&Parallel_worker::run, &worker));
+      }
+      tg.join_all();
+   }
+   BOOST_FOREACH(boost::exception_ptr const& e, err) {
+      if( e ) boost::rethrow_exception(e);
+   }
+}
+
+}//namespace detail
+}//namespace owlcpp
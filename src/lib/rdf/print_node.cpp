@@ -45,7 +45,7 @@ std::string to_string(Node_double const& node) {return node.value_str();}
 /*
 *******************************************************************************/
 std::string to_string(Node_string const& node) {
-   return '"' + node.value() + '"';
+   return '"' + node.value().to_string() + '"';
 }
 
 namespace{
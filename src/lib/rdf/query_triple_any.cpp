@@ -12,7 +12,8 @@ part of owlcpp project.
 
 namespace owlcpp {
 
-/*
+/* The result is type-erased anyway, so the index is chosen at run time
+from the actual sizes of the fragments to be searched.
 *******************************************************************************/
 triple_any_range find_triple(
          Triple_store const& ts,
@@ -31,23 +32,24 @@ triple_any_range find_triple(
             ( obj ? O : 0 ) |
             ( doc ? D : 0 )
             ;
+   Triple_store::map_triple_type const& mt = ts.map_triple();
    switch (n) {
-      case 0      : return ts.map_triple();
-      case       D: return ts.find_triple(any, any, any,  *doc);
-      case     O  : return ts.find_triple(any, any,  *obj, any);
-      case     O|D: return ts.find_triple(any, any,  *obj,  *doc);
-      case   P    : return ts.find_triple(any, *pred, any, any);
-      case   P|  D: return ts.find_triple(any, *pred, any,  *doc);
-      case   P|O  : return ts.find_triple(any, *pred,  *obj, any);
-      case   P|O|D: return ts.find_triple(any, *pred,  *obj,  *doc);
-      case S      : return ts.find_triple(*subj, any, any, any);
-      case S|    D: return ts.find_triple(*subj, any, any,  *doc);
-      case S|  O  : return ts.find_triple(*subj, any,  *obj, any);
-      case S|  O|D: return ts.find_triple(*subj, any,  *obj,  *doc);
-      case S|P    : return ts.find_triple(*subj, *pred, any, any);
-      case S|P|  D: return ts.find_triple(*subj, *pred, any,  *doc);
-      case S|P|O  : return ts.find_triple(*subj, *pred,  *obj, any);
-      case S|P|O|D: return ts.find_triple(*subj, *pred,  *obj,  *doc);
+      case 0      : return mt;
+      case       D: return mt.find_planned(any, any, any,  *doc);
+      case     O  : return mt.find_planned(any, any,  *obj, any);
+      case     O|D: return mt.find_planned(any, any,  *obj,  *doc);
+      case   P    : return mt.find_planned(any, *pred, any, any);
+      case   P|  D: return mt.find_planned(any, *pred, any,  *doc);
+      case   P|O  : return mt.find_planned(any, *pred,  *obj, any);
+      case   P|O|D: return mt.find_planned(any, *pred,  *obj,  *doc);
+      case S      : return mt.find_planned(*subj, any, any, any);
+      case S|    D: return mt.find_planned(*subj, any, any,  *doc);
+      case S|  O  : return mt.find_planned(*subj, any,  *obj, any);
+      case S|  O|D: return mt.find_planned(*subj, any,  *obj,  *doc);
+      case S|P    : return mt.find_planned(*subj, *pred, any, any);
+      case S|P|  D: return mt.find_planned(*subj, *pred, any,  *doc);
+      case S|P|O  : return mt.find_planned(*subj, *pred,  *obj, any);
+      case S|P|O|D: return mt.find_planned(*subj, *pred,  *obj,  *doc);
       default:
          BOOST_THROW_EXCEPTION(
                   Rdf_err() << Rdf_err::msg_t("unsupported query")
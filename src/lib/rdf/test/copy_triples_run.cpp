@@ -5,10 +5,13 @@ part of owlcpp project.
 *******************************************************************************/
 #define BOOST_TEST_MODULE copy_triples_run
 #include "boost/test/unit_test.hpp"
+#include <set>
+#include "boost/lexical_cast.hpp"
 #include "test/exception_fixture.hpp"
 #include "test/sample_triples.hpp"
 #include "owlcpp/rdf/triple_store.hpp"
 #include "owlcpp/rdf/copy_triples.hpp"
+#include "owlcpp/rdf/print_node.hpp"
 #include "test_utils.hpp"
 
 namespace owlcpp{ namespace test{
@@ -48,5 +51,52 @@ BOOST_AUTO_TEST_CASE( test_copy_triples_01 ) {
    BOOST_CHECK_EQUAL( ts2.at(did2).ontology_iri, *ts2.find_node_iri(doc2) );
 }
 
+/** node string that does not depend on node or document IDs */
+std::string node_str(const Node_id nid, Triple_store const& ts) {
+   if( Node_blank const* nb = dynamic_cast<Node_blank const*>(&ts[nid]) ) {
+      return ts[nb->document()].path + '-' +
+               boost::lexical_cast<std::string>(nb->index());
+   }
+   return to_string_full(nid, ts);
+}
+
+std::multiset<std::string> triple_strings(Triple_store const& ts) {
+   std::multiset<std::string> s;
+   BOOST_FOREACH(Triple const& t, ts.map_triple()) {
+      s.insert(
+               node_str(t.subj_, ts) + ' ' + node_str(t.pred_, ts) + ' ' +
+               node_str(t.obj_, ts) + ' ' + ts[t.doc_].path
+      );
+   }
+   return s;
+}
+
+/**@test Copy into store with different IDs, compare triples by node strings
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_copy_triples_02 ) {
+   Triple_store ts1;
+   sample_triples_01(ts1);
+   sample_triples_02(ts1);
+   const Doc_id did1 = ts1.map_doc().find_path(path1).front();
+   const Node_id nid1 = ts1.insert_node_iri(iri11);
+   const Node_id nid2 = ts1.insert_node_iri(iri22);
+   for(unsigned i = 0; i != 200; ++i) {
+      const Node_id nid = ts1.insert_literal(
+               boost::lexical_cast<std::string>(i), ""
+      );
+      ts1.insert(Triple::make(nid1, nid2, nid, did1));
+   }
+
+   Triple_store ts2;
+   ts2.insert_node_iri(iri24);
+   ts2.insert_node_iri(iri23);
+   ts2.insert_doc(doc3, path3, "");
+   copy_triples(ts1, ts2);
+   BOOST_CHECK_EQUAL(ts2.map_triple().size(), ts1.map_triple().size());
+   const std::multiset<std::string> s1 = triple_strings(ts1);
+   const std::multiset<std::string> s2 = triple_strings(ts2);
+   BOOST_CHECK_EQUAL_COLLECTIONS(s1.begin(), s1.end(), s2.begin(), s2.end());
+}
+
 }//namespace test
 }//namespace owlcpp
@@ -5,6 +5,9 @@ part of owlcpp project.
 *******************************************************************************/
 #define BOOST_TEST_MODULE map_node_run
 #include "boost/test/unit_test.hpp"
+#include <vector>
+#include "boost/foreach.hpp"
+#include "boost/lexical_cast.hpp"
 #include "test/exception_fixture.hpp"
 #include "owlcpp/rdf/map_node.hpp"
 #include "owlcpp/terms/node_tags_system.hpp"
@@ -56,5 +59,201 @@ BOOST_AUTO_TEST_CASE( test_literal_nodes ) {
    BOOST_CHECK_EQUAL(id1, id1a);
 }
 
+/**@test Remove and re-insert many nodes of different types
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_node_02 ) {
+   Map_node mn1;
+   std::vector<Node_id> v;
+   for(unsigned i = 0; i != 300; ++i) {
+      const std::string s = boost::lexical_cast<std::string>(i);
+      v.push_back(mn1.insert_iri(Ns_id(42), s));
+      v.push_back(mn1.insert_blank(i, Doc_id(5)));
+      v.push_back(mn1.insert_literal(s, t::xsd_int::id()));
+      v.push_back(mn1.insert_literal(s, t::xsd_string::id(), "en"));
+   }
+   BOOST_CHECK_EQUAL(mn1.size(), v.size());
+   BOOST_CHECK_EQUAL(mn1.insert_literal("7", t::xsd_int::id()), v[7 * 4 + 2]);
+   BOOST_CHECK_EQUAL(*mn1.find_blank(7, Doc_id(5)), v[7 * 4 + 1]);
+   BOOST_CHECK( ! mn1.find_blank(7, Doc_id(6)) );
+
+   for(std::size_t i = 0; i < v.size(); i += 3) mn1.remove(v[i]);
+   BOOST_CHECK_EQUAL(mn1.size(), v.size() - v.size() / 3);
+   for(std::size_t i = 0; i != v.size(); ++i) {
+      BOOST_CHECK_EQUAL( ! mn1.find(v[i]), ! (i % 3) );
+   }
+
+   const Map_node mn2(mn1);
+   BOOST_CHECK_EQUAL(mn2.size(), mn1.size());
+   std::size_t n = 0;
+   BOOST_FOREACH(const Node_id id, mn2) {
+      ++n;
+      BOOST_CHECK(mn1[id] == mn2[id]);
+      BOOST_CHECK_EQUAL(*mn2.find(mn2[id]), id);
+   }
+   BOOST_CHECK_EQUAL(n, mn2.size());
+
+   //IDs of removed nodes are reused
+   for(unsigned i = 0; i != 300; ++i) {
+      const std::string s = boost::lexical_cast<std::string>(i);
+      BOOST_CHECK_LE(mn1.insert_iri(Ns_id(42), s), v.back());
+      BOOST_CHECK_LE(mn1.insert_literal(s, t::xsd_int::id()), v.back());
+   }
+   BOOST_CHECK_EQUAL(mn1.size(), mn2.size() + 2 * 100);
+}
+
+/**@test Find and insert nodes using string references
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_string_ref ) {
+   Map_node mn1;
+   const std::string buff = "blahblah";
+   const boost::string_ref s1(buff.data(), 4);
+   const Node_id id1 = mn1.insert_iri(Ns_id(42), "blah");
+   BOOST_REQUIRE( mn1.find_iri(Ns_id(42), s1) );
+   BOOST_CHECK_EQUAL( *mn1.find_iri(Ns_id(42), s1), id1 );
+   BOOST_CHECK_EQUAL( mn1.insert_iri(Ns_id(42), s1), id1 );
+   BOOST_CHECK( ! mn1.find_iri(Ns_id(43), s1) );
+   BOOST_CHECK_EQUAL( mn1.size(), 1U );
+
+   const boost::string_ref lang(buff.data() + 4, 2);
+   const Node_id id2 = mn1.insert_literal(s1, t::xsd_string::id(), lang);
+   BOOST_CHECK_EQUAL( *mn1.find_literal("blah", t::xsd_string::id(), "bl"), id2 );
+   BOOST_CHECK_EQUAL( mn1.insert_literal("blah", t::xsd_string::id(), "bl"), id2 );
+   const Node_id id3 = mn1.insert_literal(s1, t::xsd_string::id());
+   BOOST_CHECK_NE( id3, id2 );
+   BOOST_CHECK_EQUAL( mn1.insert_literal(s1, t::empty_::id()), id3 );
+   BOOST_CHECK_EQUAL( *mn1.find_literal(s1, t::empty_::id(), ""), id3 );
+   BOOST_CHECK_EQUAL( mn1.size(), 3U );
+
+   const Node_id id4 =
+            mn1.insert_literal(boost::string_ref("42x", 2), t::xsd_int::id());
+   BOOST_CHECK_EQUAL( *mn1.find_literal("42", t::xsd_int::id(), ""), id4 );
+   BOOST_CHECK_EQUAL( mn1.insert_literal("42", t::xsd_int::id()), id4 );
+
+   const Map_node mn2(mn1);
+   BOOST_CHECK_EQUAL( *mn2.find_iri(Ns_id(42), s1), id1 );
+   BOOST_CHECK_EQUAL( *mn2.find(mn1[id2]), id2 );
+}
+
+/**@test Strings of stored nodes are interned
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_interned_strings ) {
+   Map_node mn1;
+   const Node_id id1 = mn1.insert_iri(Ns_id(42), "blah");
+   const Node_id id2 = mn1.insert(Node_iri(Ns_id(43), "blah"));
+   const Node_id id3 = mn1.insert_literal("blah", t::xsd_string::id(), "en");
+   Node_iri const& n1 = static_cast<Node_iri const&>(mn1[id1]);
+   Node_iri const& n2 = static_cast<Node_iri const&>(mn1[id2]);
+   Node_string const& n3 = static_cast<Node_string const&>(mn1[id3]);
+   BOOST_CHECK(n1.fragment().data() == n2.fragment().data());
+   BOOST_CHECK(n1.fragment().data() == n3.value().data());
+   BOOST_CHECK_EQUAL(n3.language(), "en");
+
+   //copies of stored nodes own their strings
+   const Node_iri n4(n1);
+   const Node_string n5(n3);
+   BOOST_CHECK(n4 == n1);
+   BOOST_CHECK(n5 == n3);
+   BOOST_CHECK(n4.fragment().data() != n1.fragment().data());
+   BOOST_CHECK(n5.value().data() != n3.value().data());
+   Node_iri n6;
+   n6 = n1;
+   BOOST_CHECK(n6 == n1);
+   BOOST_CHECK(n6.fragment().data() != n1.fragment().data());
+
+   //removed node does not refer to the map
+   std::auto_ptr<Node> p = mn1.remove(id1);
+   mn1.clear();
+   BOOST_CHECK(*p == Node_iri(Ns_id(42), "blah"));
+   BOOST_CHECK_EQUAL(static_cast<Node_iri const&>(*p).fragment(), "blah");
+
+   const Node_id id4 = mn1.insert_literal("blahblah", t::xsd_string::id(), "en");
+   BOOST_CHECK_EQUAL(*mn1.find_literal("blahblah", t::xsd_string::id(), "en"), id4);
+   mn1.erase(id4);
+   BOOST_CHECK( ! mn1.find_literal("blahblah", t::xsd_string::id(), "en") );
+   const Node_id id5 = mn1.insert_iri(Ns_id(42), "x");
+   BOOST_CHECK_EQUAL(static_cast<Node_iri const&>(mn1[id5]).fragment(), "x");
+}
+
+/**@test Insert nodes with known IDs
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_insert_with_id ) {
+   Map_node mn1;
+   const Node_id id1(owlcpp::detail::min_node_id()() + 5);
+   mn1.reserve(Node_id(id1() + 1));
+   mn1.insert(id1, std::auto_ptr<Node>(new Node_iri(Ns_id(42), "blah")));
+   BOOST_CHECK_EQUAL(mn1.size(), 1U);
+   BOOST_CHECK_EQUAL(*mn1.find_iri(Ns_id(42), "blah"), id1);
+   BOOST_CHECK( ! mn1.find(Node_id(id1() - 1)) );
+
+   BOOST_CHECK_THROW(
+            mn1.insert(id1, std::auto_ptr<Node>(new Node_iri(Ns_id(42), "x"))),
+            Map_node::Err
+   );
+   BOOST_CHECK_THROW(
+            mn1.insert(
+                     Node_id(id1() + 1),
+                     std::auto_ptr<Node>(new Node_iri(Ns_id(42), "blah"))
+            ),
+            Map_node::Err
+   );
+   BOOST_CHECK_THROW(
+            mn1.insert(Node_id(1), std::auto_ptr<Node>(new Node_blank(1, Doc_id(1)))),
+            Map_node::Err
+   );
+   BOOST_CHECK_EQUAL(mn1.size(), 1U);
+
+   const Node_id id2 = mn1.insert_iri(Ns_id(42), "blahblah");
+   BOOST_CHECK_LT(id2, id1);
+
+   //skipped IDs are taken by new nodes before new IDs are made
+   for( unsigned i = 0; i != 4; ++i ) {
+      const Node_id id = mn1.insert_blank(i, Doc_id(1));
+      BOOST_CHECK_LT(id, id1);
+   }
+   BOOST_CHECK_EQUAL(mn1.insert_blank(4, Doc_id(1)), Node_id(id1() + 1));
+   BOOST_CHECK_EQUAL(mn1.size(), 7U);
+
+   //ID of erased node is taken by insertion with known ID
+   mn1.erase(id2);
+   mn1.insert(id2, std::auto_ptr<Node>(new Node_iri(Ns_id(42), "x")));
+   const Node_id id3 = mn1.insert_iri(Ns_id(42), "y");
+   BOOST_CHECK_NE(id3, id2);
+   BOOST_CHECK_NE(id3, id1);
+   BOOST_CHECK_EQUAL(*mn1.find_iri(Ns_id(42), "x"), id2);
+   BOOST_CHECK_EQUAL(*mn1.find_iri(Ns_id(42), "y"), id3);
+   BOOST_CHECK_EQUAL(mn1.size(), 8U);
+
+   //ID erased again is reused only once
+   mn1.erase(id2);
+   mn1.insert(id2, std::auto_ptr<Node>(new Node_iri(Ns_id(42), "x")));
+   mn1.erase(id2);
+   BOOST_CHECK_EQUAL(mn1.insert_iri(Ns_id(42), "z1"), id2);
+   BOOST_CHECK_NE(mn1.insert_iri(Ns_id(42), "z2"), id2);
+   BOOST_CHECK_EQUAL(mn1.size(), 9U);
+}
+
+/**@test Append nodes with increasing IDs
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_append ) {
+   Map_node mn1;
+   const Node_id id1(owlcpp::detail::min_node_id()() + 2);
+   const Node_id id2(id1() + 3);
+   mn1.append(id1, Node_iri(Ns_id(42), "blah"));
+   mn1.append(id2, Node_blank(1, Doc_id(1)));
+   BOOST_CHECK_EQUAL(mn1.size(), 2U);
+   BOOST_CHECK_EQUAL(*mn1.find_iri(Ns_id(42), "blah"), id1);
+   BOOST_CHECK_EQUAL(*mn1.find_blank(1, Doc_id(1)), id2);
+   BOOST_CHECK( ! mn1.find(Node_id(id1() + 1)) );
+
+   BOOST_CHECK_THROW(mn1.append(id1, Node_iri(Ns_id(42), "x")), Map_node::Err);
+   BOOST_CHECK_THROW(mn1.append(id2, Node_iri(Ns_id(42), "x")), Map_node::Err);
+
+   //skipped IDs are taken by new nodes
+   const Node_id id3 = mn1.insert_iri(Ns_id(42), "x");
+   BOOST_CHECK_LT(id3, id2);
+   BOOST_CHECK_NE(id3, id1);
+   BOOST_CHECK_EQUAL(mn1.size(), 3U);
+}
+
 }//namespace test
 }//namespace owlcpp
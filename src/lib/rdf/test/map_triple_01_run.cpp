@@ -6,8 +6,11 @@ part of owlcpp project.
 #define BOOST_TEST_MODULE triple_map_01_run
 #include "boost/test/unit_test.hpp"
 #include "boost/range.hpp"
+#include "boost/range/algorithm/equal.hpp"
 #include "test/exception_fixture.hpp"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "owlcpp/rdf/map_triple.hpp"
 namespace mpl = boost::mpl;
@@ -86,5 +89,147 @@ BOOST_AUTO_TEST_CASE( test_index_predicate_search ) {
    BOOST_CHECK_EQUAL(distance(r), 4U);
 }
 
+/**@test Insert range of triples
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_insert_range ) {
+   typedef Map_triple<> map_triple;
+   map_triple mt1, mt2;
+   insert_seq(mt1, random_triples1);
+   insert_seq(mt1, t);
+
+   std::vector<Triple> v;
+   for(std::size_t i = 0; i != boost::size(random_triples1); ++i) {
+      v.push_back(triple(random_triples1[i]));
+   }
+   mt2.insert(v.begin(), v.end());
+   BOOST_CHECK_EQUAL(mt2.size(), v.size());
+
+   v.clear();
+   for(std::size_t i = 0; i != boost::size(t); ++i) v.push_back(triple(t[i]));
+   v.push_back(triple(t[0])); //duplicate
+   mt2.insert(v.begin(), v.end());
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(std::equal(mt1.begin(), mt1.end(), mt2.begin()));
+
+   BOOST_CHECK_EQUAL(
+            boost::distance(mt2.find(any, Node_id(3), any, any)),
+            boost::distance(mt1.find(any, Node_id(3), any, any))
+   );
+   BOOST_CHECK_EQUAL(
+            boost::distance(mt2.find(any, any, Node_id(0), any)),
+            boost::distance(mt1.find(any, any, Node_id(0), any))
+   );
+}
+
+/**@test Build indices of a large batch concurrently
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_insert_range_parallel ) {
+   typedef Map_triple<> map_triple;
+   const unsigned n = map_triple::parallel_batch_min() + 1000;
+   std::vector<Triple> v;
+   for(unsigned i = 0; i != n; ++i) {
+      //skewed distribution of objects, some duplicates
+      v.push_back(triple(i % 5000, i % 7, (i * 7919) % (i % 3 ? 50 : 5000), i % 3));
+   }
+   map_triple mt1, mt2;
+   mt1.insert(v.begin(), v.end(), 1);
+   mt2.insert(v.begin(), v.end(), 4);
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(std::equal(mt1.begin(), mt1.end(), mt2.begin()));
+   for(unsigned i = 0; i != 50; ++i) {
+      BOOST_CHECK(boost::equal(
+               mt2.find(any, any, Node_id(i), any),
+               mt1.find(any, any, Node_id(i), any)
+      ));
+   }
+
+   //insert over existing triples
+   v.push_back(triple(6000, 1, 1, 1));
+   mt2.insert(v.begin(), v.end(), 4);
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size() + 1);
+}
+
+/**@test Search frozen indices, then modify them
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_freeze ) {
+   typedef Map_triple<> map_triple;
+   map_triple mt1, mt2;
+   insert_seq(mt1, random_triples1);
+   insert_seq(mt1, t);
+   insert_seq(mt2, random_triples1);
+   insert_seq(mt2, t);
+   mt2.freeze();
+   mt2.freeze();
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(std::equal(mt1.begin(), mt1.end(), mt2.begin()));
+   for(unsigned i = 0; i != 15; ++i) {
+      BOOST_CHECK(boost::equal(
+               mt2.find(Node_id(i), any, any, any),
+               mt1.find(Node_id(i), any, any, any)
+      ));
+      BOOST_CHECK(boost::equal(
+               mt2.find(any, Node_id(i), any, any),
+               mt1.find(any, Node_id(i), any, any)
+      ));
+      BOOST_CHECK(boost::equal(
+               mt2.find(any, any, Node_id(i), Doc_id(0)),
+               mt1.find(any, any, Node_id(i), Doc_id(0))
+      ));
+   }
+   BOOST_CHECK(boost::equal(
+            mt2.find(any, Node_id(3), any, any),
+            mt1.find(any, Node_id(3), any, any)
+   ));
+   BOOST_CHECK(mt2.find(Node_id(100), any, any, any).empty());
+
+   //modification thaws indices
+   mt1.insert(triple(100, 1, 2, 0));
+   mt2.insert(triple(100, 1, 2, 0));
+   mt1.erase(triple(0, 3, 0, 1));
+   mt2.erase(triple(0, 3, 0, 1));
+   BOOST_CHECK(std::equal(mt1.begin(), mt1.end(), mt2.begin()));
+   BOOST_CHECK_EQUAL(boost::distance(mt2.find(Node_id(100), any, any, any)), 1);
+   mt2.freeze();
+   BOOST_CHECK_EQUAL(mt2.erase_doc(Doc_id(0)), mt1.erase_doc(Doc_id(0)));
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(std::equal(mt1.begin(), mt1.end(), mt2.begin()));
+}
+
+/**@test Choose index by the sizes of searched fragments
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_plan ) {
+   typedef Map_triple<> map_triple; //SPOD, OPSD, DSPO
+   map_triple mt;
+   //subject 1 and object 2 are hubs, object 500 and subject 600 are rare
+   for( unsigned i = 0; i != 100; ++i ) {
+      mt.insert(triple(1, 3, 10 + i, 0));
+      mt.insert(triple(200 + i, 3, 2, 0));
+   }
+   mt.insert(triple(1, 4, 500, 0));
+   mt.insert(triple(600, 4, 2, 0));
+
+   BOOST_CHECK_EQUAL(mt.plan(Node_id(1), any, Node_id(500), any), 1U);
+   BOOST_CHECK_EQUAL(mt.plan(Node_id(600), any, Node_id(2), any), 0U);
+   BOOST_CHECK_EQUAL(mt.plan(any, Node_id(4), Node_id(500), any), 1U);
+   typedef map_triple::query<Any,Any,Any,Doc_id>::index_pos doc_index;
+   BOOST_CHECK_EQUAL(mt.plan(any, any, any, Doc_id(0)), doc_index::value);
+
+   map_triple::any_range r = mt.find_planned(Node_id(1), any, Node_id(500), any);
+   BOOST_CHECK_EQUAL(boost::distance(r), 1);
+   BOOST_CHECK(boost::equal(r, mt.find(Node_id(1), any, Node_id(500), any)));
+   r = mt.find_planned(Node_id(600), any, Node_id(2), any);
+   BOOST_CHECK(boost::equal(r, mt.find(Node_id(600), any, Node_id(2), any)));
+   r = mt.find_planned(Node_id(1), Node_id(3), any, any);
+   BOOST_CHECK_EQUAL(boost::distance(r), 100);
+   BOOST_CHECK(mt.find_planned(Node_id(7), any, any, any).empty());
+
+   mt.freeze();
+   BOOST_CHECK_EQUAL(mt.plan(Node_id(1), any, Node_id(500), any), 1U);
+   BOOST_CHECK_EQUAL(
+            boost::distance(mt.find_planned(any, any, Node_id(2), Doc_id(0))),
+            101
+   );
+}
+
 }//namespace test
 }//namespace owlcpp
@@ -6,8 +6,11 @@ part of owlcpp project.
 #define BOOST_TEST_MODULE map_triple_02_run
 #include "boost/test/unit_test.hpp"
 #include "boost/range.hpp"
+#include "boost/range/algorithm/equal.hpp"
 #include "test/exception_fixture.hpp"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "owlcpp/rdf/map_triple.hpp"
 #include "rdf/test/test_utils.hpp"
@@ -75,5 +78,154 @@ BOOST_AUTO_TEST_CASE( test_map_triple_02 ) {
    BOOST_CHECK_EQUAL(mt.find(Node_id(6), Node_id(3), any, any).size(), 2);
 }
 
+/**@test Packed triple indices return same results as default ones
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_packed ) {
+   typedef Map_triple<> map_triple1;
+   typedef Map_triple<map_triple_detail::index_config_packed> map_triple2;
+   std::vector<Triple> v;
+   for(unsigned i = 0; i != 5000; ++i) {
+      //large IDs take several bytes when packed
+      v.push_back(triple(i % 300, i % 7, (i * 7919) % 100003 + (i % 2) * 1000000, i % 3));
+   }
+   map_triple1 mt1;
+   map_triple2 mt2;
+   mt1.insert(v.begin(), v.end());
+   mt2.insert(v.begin(), v.end());
+   mt2.freeze();
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   for(unsigned i = 0; i != 20; ++i) {
+      const Triple& t = v[i * 97];
+      BOOST_CHECK(boost::equal(
+               mt2.find(t.subj_, any, any, any),
+               mt1.find(t.subj_, any, any, any)
+      ));
+      BOOST_CHECK(boost::equal(
+               mt2.find(any, any, t.obj_, any),
+               mt1.find(any, any, t.obj_, any)
+      ));
+      BOOST_CHECK(boost::equal(
+               mt2.find(t.subj_, t.pred_, any, t.doc_),
+               mt1.find(t.subj_, t.pred_, any, t.doc_)
+      ));
+      BOOST_CHECK(boost::equal(
+               mt2.find(any, t.pred_, t.obj_, any),
+               mt1.find(any, t.pred_, t.obj_, any)
+      ));
+      BOOST_CHECK_EQUAL(
+               boost::distance(mt2.find(any, t.pred_, any, t.doc_)),
+               boost::distance(mt1.find(any, t.pred_, any, t.doc_))
+      );
+      BOOST_CHECK_EQUAL(
+               boost::distance(mt2.find(t.subj_, t.pred_, t.obj_, t.doc_)), 1
+      );
+   }
+
+   //modification thaws indices
+   mt1.insert(triple(5, 5, 5, 5));
+   mt2.insert(triple(5, 5, 5, 5));
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   mt2.freeze();
+   BOOST_CHECK_EQUAL(mt2.erase_doc(Doc_id(1)), mt1.erase_doc(Doc_id(1)));
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   BOOST_CHECK(mt2.find(any, any, any, Doc_id(1)).empty());
+}
+
+/**@test Erase triples of documents found with index leading with document ID
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_erase_doc ) {
+   typedef Map_triple<> map_triple1;
+   typedef Map_triple<
+            mpl::vector2<
+               mpl::vector4<Subj_tag, Pred_tag, Obj_tag, Doc_tag>,
+               mpl::vector4<Doc_tag, Subj_tag, Pred_tag, Obj_tag>
+            >
+   > map_triple2;
+   typedef Map_triple<map_triple_detail::config_unindexed> map_triple3;
+   map_triple1 mt1;
+   map_triple2 mt2;
+   map_triple3 mt3;
+   insert_seq(mt1, random_triples1);
+   insert_seq(mt2, random_triples1);
+   insert_seq(mt3, random_triples1);
+   for(unsigned i = 0; i != 10; ++i) {
+      const Doc_id did(i);
+      const std::ptrdiff_t n = boost::distance(mt1.doc_triples(did));
+      BOOST_CHECK_EQUAL(boost::distance(mt2.doc_triples(did)), n);
+      BOOST_CHECK_EQUAL(boost::distance(mt3.doc_triples(did)), n);
+   }
+
+   const Triple t = *mt2.doc_triples(Doc_id(4)).begin();
+   mt1.erase(t);
+   mt2.erase(t);
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   BOOST_CHECK_EQUAL(mt1.erase_doc(Doc_id(4)), 2U);
+   BOOST_CHECK_EQUAL(mt2.erase_doc(Doc_id(4)), 2U);
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   BOOST_CHECK(mt2.doc_triples(Doc_id(4)).empty());
+   BOOST_CHECK_EQUAL(mt2.erase_doc(Doc_id(4)), 0U);
+}
+
+/**@test Finding and erasing triples of a document does not depend on
+other documents
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_erase_doc_cost ) {
+   typedef Map_triple<> map_triple;
+   map_triple mt;
+   for(unsigned i = 0; i != 10; ++i) mt.insert(triple(i, 1, 2, 0));
+   BOOST_CHECK_EQUAL(mt.cost(any, any, any, Doc_id(0)), 10U);
+
+   //unrelated documents sharing nodes with document 0
+   for(unsigned d = 1; d != 100; ++d) {
+      for(unsigned i = 0; i != 100; ++i) mt.insert(triple(i, 1, 2 + d, d));
+   }
+   BOOST_CHECK_EQUAL(mt.cost(any, any, any, Doc_id(0)), 10U);
+   BOOST_CHECK_EQUAL(mt.cost(any, any, any, Doc_id(7)), 100U);
+   BOOST_CHECK_EQUAL(boost::distance(mt.doc_triples(Doc_id(0))), 10);
+
+   const std::size_t n = mt.size();
+   BOOST_CHECK_EQUAL(mt.erase_doc(Doc_id(0)), 10U);
+   BOOST_CHECK_EQUAL(mt.size(), n - 10);
+   BOOST_CHECK_EQUAL(mt.cost(any, any, any, Doc_id(0)), 0U);
+   BOOST_CHECK_EQUAL(boost::distance(mt.doc_triples(Doc_id(7))), 100);
+}
+
+/**@test Insert SPOD-sorted triples
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_insert_sorted ) {
+   typedef Map_triple<> map_triple1;
+   typedef Map_triple<map_triple_detail::config_unindexed> map_triple2;
+   map_triple1 mt1;
+   insert_seq(mt1, random_triples1);
+   std::vector<Triple> v;
+   for(std::size_t i = 0; i != boost::size(random_triples1); ++i) {
+      v.push_back(triple(random_triples1[i]));
+   }
+   std::sort(v.begin(), v.end());
+   v.erase(std::unique(v.begin(), v.end()), v.end());
+
+   map_triple1 mt2;
+   mt2.insert_sorted(v);
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   BOOST_CHECK(boost::equal(mt1, mt2));
+   BOOST_CHECK(
+            boost::equal(
+                     mt1.find(any, Node_id(5), any, any),
+                     mt2.find(any, Node_id(5), any, any)
+            )
+   );
+
+   map_triple2 mt3;
+   mt3.insert_sorted(v);
+   BOOST_CHECK_EQUAL(mt3.size(), mt1.size());
+
+   std::swap(v.front(), v.back());
+   map_triple1 mt4;
+   BOOST_CHECK_THROW(mt4.insert_sorted(v), Rdf_err);
+   BOOST_CHECK(mt4.empty());
+}
+
 }//namespace test
 }//namespace owlcpp
@@ -0,0 +1,188 @@
+/** @file "/owlcpp/lib/rdf/test/map_triple_dynamic_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE map_triple_dynamic_run
+#include "boost/test/unit_test.hpp"
+#include <algorithm>
+#include <vector>
+#include "boost/foreach.hpp"
+
+#include "test/exception_fixture.hpp"
+#include "test/test_utils.hpp"
+#include "owlcpp/rdf/map_triple_dynamic.hpp"
+
+namespace owlcpp{ namespace test{
+
+namespace m = map_triple_detail;
+
+std::vector<Triple> many_triples() {
+   std::vector<Triple> v;
+   for( unsigned i = 0; i != 2000; ++i ) {
+      v.push_back(triple(i % 37, i % 5, (i * 7) % 101, i % 3));
+   }
+   return v;
+}
+
+m::Triple_pattern pattern(Triple const& t, const unsigned mask) {
+   switch (mask) {
+   case 0: return m::Triple_pattern(any, any, any, any);
+   case 1: return m::Triple_pattern(t.subj_, any, any, any);
+   case 2: return m::Triple_pattern(any, t.pred_, any, any);
+   case 3: return m::Triple_pattern(t.subj_, t.pred_, any, any);
+   case 4: return m::Triple_pattern(any, any, t.obj_, any);
+   case 5: return m::Triple_pattern(t.subj_, any, t.obj_, any);
+   case 6: return m::Triple_pattern(any, t.pred_, t.obj_, any);
+   case 7: return m::Triple_pattern(t.subj_, t.pred_, t.obj_, any);
+   case 8: return m::Triple_pattern(any, any, any, t.doc_);
+   case 9: return m::Triple_pattern(t.subj_, any, any, t.doc_);
+   case 10: return m::Triple_pattern(any, t.pred_, any, t.doc_);
+   case 11: return m::Triple_pattern(t.subj_, t.pred_, any, t.doc_);
+   case 12: return m::Triple_pattern(any, any, t.obj_, t.doc_);
+   case 13: return m::Triple_pattern(t.subj_, any, t.obj_, t.doc_);
+   case 14: return m::Triple_pattern(any, t.pred_, t.obj_, t.doc_);
+   default: return m::Triple_pattern(t.subj_, t.pred_, t.obj_, t.doc_);
+   }
+}
+
+/** compare query results with sequential search */
+void check_queries(Map_triple_dynamic const& mt, std::vector<Triple> const& v) {
+   const Triple t0 = v[v.size() / 2];
+   for( unsigned mask = 0; mask != 16; ++mask ) {
+      const m::Triple_pattern q = pattern(t0, mask);
+      std::vector<Triple> v1;
+      BOOST_FOREACH(Triple const& t, v) {
+         if(
+                  (!(mask & 1) || t.subj_ == t0.subj_) &&
+                  (!(mask & 2) || t.pred_ == t0.pred_) &&
+                  (!(mask & 4) || t.obj_ == t0.obj_) &&
+                  (!(mask & 8) || t.doc_ == t0.doc_)
+         ) v1.push_back(t);
+      }
+      std::sort(v1.begin(), v1.end());
+      v1.erase(std::unique(v1.begin(), v1.end()), v1.end());
+
+      const Map_triple_dynamic::range r = mt.find(q);
+      std::vector<Triple> v2(r.begin(), r.end());
+      std::sort(v2.begin(), v2.end());
+      BOOST_CHECK_MESSAGE(v1 == v2, "query " << mask << " " << mt.n_indices());
+   }
+}
+
+/**@test permutations
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_triple_permutation ) {
+   const Triple_permutation p1("POS");
+   BOOST_CHECK_EQUAL(p1.str(), "POSD");
+   BOOST_CHECK_EQUAL(p1[0], 1U);
+   BOOST_CHECK_EQUAL(p1.position(0), 2U);
+   BOOST_CHECK_EQUAL(p1.element(triple(5,6,7,8), 1), 7U);
+   BOOST_CHECK(Triple_permutation("dspo") == Triple_permutation("DSPO"));
+   BOOST_CHECK_THROW(Triple_permutation("SPS"), Rdf_err);
+   BOOST_CHECK_THROW(Triple_permutation("SPX"), Rdf_err);
+   BOOST_CHECK_THROW(Map_triple_dynamic(""), Rdf_err);
+}
+
+/**@test inserting, searching, and erasing triples
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_dynamic ) {
+   Map_triple_dynamic mt("SPOD");
+   BOOST_CHECK(mt.empty());
+   BOOST_CHECK(mt.begin() == mt.end());
+   insert_seq(mt, random_triples1);
+   mt.insert(triple(1,5,9,4));
+   BOOST_CHECK_EQUAL(mt.size(), 20U);
+   BOOST_CHECK_EQUAL(std::distance(mt.begin(), mt.end()), 20);
+
+   std::vector<Triple> v;
+   for( std::size_t i = 0; i != boost::size(random_triples1); ++i ) {
+      v.push_back(triple(random_triples1[i]));
+   }
+   check_queries(mt, v);
+
+   BOOST_CHECK_EQUAL(mt.query_index(any, Node_id(1), any, any).str(), "SPOD");
+   mt.add_index(Triple_permutation("PSO"));
+   BOOST_CHECK_EQUAL(mt.query_index(any, Node_id(1), any, any).str(), "PSOD");
+   BOOST_CHECK_EQUAL(
+            mt.query_index(Node_id(1), Node_id(1), any, any).str(),
+            "SPOD"
+   );
+   check_queries(mt, v);
+
+   mt.erase(triple(1,5,9,4));
+   BOOST_CHECK_THROW(mt.erase(triple(1,5,9,4)), Rdf_err);
+   BOOST_CHECK_EQUAL(mt.size(), 19U);
+   BOOST_CHECK(mt.find(Node_id(1), Node_id(5), any, any).empty());
+
+   BOOST_CHECK_EQUAL(mt.erase_doc(Doc_id(7)), 4U);
+   BOOST_CHECK_EQUAL(mt.size(), 15U);
+   BOOST_CHECK(mt.find(any, any, any, Doc_id(7)).empty());
+
+   mt.erase_index(Triple_permutation("SPOD"));
+   BOOST_CHECK_EQUAL(mt.n_indices(), 1U);
+   BOOST_CHECK_THROW(mt.erase_index(Triple_permutation("PSOD")), Rdf_err);
+   BOOST_CHECK_EQUAL(std::distance(mt.begin(), mt.end()), 15);
+}
+
+/**@test batch insertion into different sets of indices
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_dynamic_batch ) {
+   const std::vector<Triple> v = many_triples();
+   Map_triple_dynamic mt1("SPOD OPSD");
+   mt1.insert(v.begin(), v.end());
+   check_queries(mt1, v);
+
+   Map_triple_dynamic mt2("DSPO, POSD, OSPD, PSOD");
+   mt2.insert(v.begin(), v.begin() + 500);
+   mt2.insert(v.begin(), v.end(), 2);
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size());
+   check_queries(mt2, v);
+   BOOST_CHECK_EQUAL(
+            mt2.query_index(any, any, any, Doc_id(1)).str(),
+            "DSPO"
+   );
+   BOOST_CHECK_EQUAL(
+            mt2.query_index(any, Node_id(1), Node_id(1), any).str(),
+            "POSD"
+   );
+
+   const std::size_t n = mt2.erase_doc(Doc_id(1));
+   BOOST_CHECK_EQUAL(mt2.size(), mt1.size() - n);
+   BOOST_CHECK(mt2.find(any, any, any, Doc_id(1)).empty());
+}
+
+/**@test index selection by the number of searched triples
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_map_triple_dynamic_cost ) {
+   Map_triple_dynamic mt("SPOD OPSD");
+   //subject 1 is a hub, object 500 is rare
+   for( unsigned i = 0; i != 100; ++i ) mt.insert(triple(1, 3, 10 + i, 0));
+   mt.insert(triple(1, 4, 500, 0));
+   BOOST_CHECK_EQUAL(
+            mt.query_index(Node_id(1), any, Node_id(500), any).str(),
+            "OPSD"
+   );
+   BOOST_CHECK_EQUAL(
+            mt.query_index(Node_id(1), any, Node_id(10), any).str(),
+            "OPSD"
+   );
+   BOOST_CHECK_EQUAL(
+            mt.query_index(Node_id(1), any, Node_id(1000), any).str(),
+            "OPSD"
+   );
+   BOOST_CHECK_EQUAL(
+            mt.query_index(Node_id(1), Node_id(4), any, any).str(),
+            "SPOD"
+   );
+   BOOST_CHECK_EQUAL(
+            std::distance(
+                     mt.find(Node_id(1), any, Node_id(500), any).begin(),
+                     mt.find(Node_id(1), any, Node_id(500), any).end()
+            ),
+            1
+   );
+}
+
+}//namespace test
+}//namespace owlcpp
@@ -0,0 +1,81 @@
+/** @file "/owlcpp/lib/rdf/test/node_hash_index_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE node_hash_index_run
+#include "boost/test/unit_test.hpp"
+#include <vector>
+#include "test/exception_fixture.hpp"
+#include "owlcpp/rdf/detail/node_hash_index.hpp"
+
+namespace owlcpp{ namespace test{
+
+/** node with ID n has key keys[n] */
+struct Equal_key {
+   Equal_key(std::vector<unsigned> const& keys, const unsigned key)
+   : keys_(keys), key_(key) {}
+   bool operator()(const Node_id id) const {return keys_[id()] == key_;}
+   std::vector<unsigned> const& keys_;
+   unsigned key_;
+};
+
+/** poor hash function to cause many collisions */
+std::size_t bad_hash(const unsigned key) {return key % 7;}
+
+/**@test Insert, find, and erase with colliding hashes
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_node_hash_index_01 ) {
+   const unsigned n = 1000;
+   std::vector<unsigned> keys(n + 1);
+   owlcpp::detail::Node_hash_index nhi;
+   BOOST_CHECK( ! nhi.find(bad_hash(5), Equal_key(keys, 5)) );
+   for(unsigned i = 1; i <= n; ++i) {
+      keys[i] = i * 3;
+      nhi.insert(bad_hash(keys[i]), Node_id(i));
+   }
+   BOOST_CHECK_EQUAL(nhi.size(), n);
+   for(unsigned i = 1; i <= n; ++i) {
+      Node_id const* id = nhi.find(bad_hash(i * 3), Equal_key(keys, i * 3));
+      BOOST_REQUIRE(id);
+      BOOST_CHECK_EQUAL(*id, Node_id(i));
+   }
+   BOOST_CHECK( ! nhi.find(bad_hash(4), Equal_key(keys, 4)) );
+
+   //erase every other node
+   for(unsigned i = 1; i <= n; i += 2) {
+      nhi.erase(bad_hash(keys[i]), Node_id(i));
+   }
+   BOOST_CHECK_EQUAL(nhi.size(), n / 2);
+   for(unsigned i = 1; i <= n; ++i) {
+      Node_id const* id = nhi.find(bad_hash(i * 3), Equal_key(keys, i * 3));
+      if( i % 2 ) {
+         BOOST_CHECK( ! id );
+      } else {
+         BOOST_REQUIRE(id);
+         BOOST_CHECK_EQUAL(*id, Node_id(i));
+      }
+   }
+
+   nhi.clear();
+   BOOST_CHECK(nhi.empty());
+   BOOST_CHECK( ! nhi.find(bad_hash(6), Equal_key(keys, 6)) );
+}
+
+/**@test Reserve space
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_node_hash_index_02 ) {
+   std::vector<unsigned> keys(101);
+   owlcpp::detail::Node_hash_index nhi;
+   nhi.reserve(100);
+   for(unsigned i = 1; i <= 100; ++i) {
+      keys[i] = i;
+      nhi.insert(i * 2654435761U, Node_id(i));
+   }
+   Node_id const* id = nhi.find(42 * 2654435761U, Equal_key(keys, 42));
+   BOOST_REQUIRE(id);
+   BOOST_CHECK_EQUAL(*id, Node_id(42));
+}
+
+}//namespace test
+}//namespace owlcpp
@@ -39,6 +39,10 @@ BOOST_AUTO_TEST_CASE( test_literal_int_node ) {
    BOOST_CHECK_THROW(Node_int("0.9"), Rdf_err);
    BOOST_CHECK_EQUAL(Node_int(1e10).value(), 1e10);
    BOOST_CHECK_THROW(Node_int("1e10"), Rdf_err);
+
+   const std::string str = " 42 43";
+   BOOST_CHECK_EQUAL(Node_int(boost::string_ref(str.data(), 4)).value(), 42);
+   BOOST_CHECK_THROW(Node_int(boost::string_ref(str)), Rdf_err);
 }
 
 /**@test Literal unsigned nodes
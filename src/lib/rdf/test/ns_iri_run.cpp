@@ -29,5 +29,25 @@ BOOST_AUTO_TEST_CASE( case01 ) {
    BOOST_CHECK_EQUAL(str2.substr(n), "frag");
 }
 
+/**@test Split IRI without copying
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( case02 ) {
+   const std::string str1 = "http://example.com";
+   const std::string str2 = str1 + "#frag";
+   boost::string_ref frag;
+   BOOST_CHECK(split_fragment(str1, frag) == str1);
+   BOOST_CHECK(frag.empty());
+   BOOST_CHECK(split_fragment(str2, frag) == str1);
+   BOOST_CHECK(frag == "frag");
+   BOOST_CHECK(split_fragment(str1 + "#", frag) == str1);
+   BOOST_CHECK(frag.empty());
+
+   const boost::string_ref ns = boost::string_ref(str2).substr(0, str1.size());
+   BOOST_CHECK_EQUAL(
+            hash_value(Ns_iri(str1)),
+            owlcpp::detail::Ns_iri_ref_hash()(ns)
+   );
+}
+
 }//namespace test
 }//namespace owlcpp
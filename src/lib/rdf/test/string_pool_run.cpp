@@ -0,0 +1,94 @@
+/** @file "/owlcpp/lib/rdf/test/string_pool_run.cpp"
+part of owlcpp project.
+@n @n Distributed under the Boost Software License, Version 1.0; see doc/license.txt.
+@n Copyright Mikhail K Levin 2016
+*******************************************************************************/
+#define BOOST_TEST_MODULE string_pool_run
+#include "boost/test/unit_test.hpp"
+#include <string>
+#include "test/exception_fixture.hpp"
+#include "owlcpp/rdf/detail/string_pool.hpp"
+
+namespace owlcpp{ namespace test{
+
+using owlcpp::detail::Pooled_string;
+using owlcpp::detail::String_pool;
+
+/**@test Owned strings
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_pooled_string_owned ) {
+   const Pooled_string ps0;
+   BOOST_CHECK(ps0.empty());
+   BOOST_CHECK( ! ps0.pooled() );
+
+   const std::string s = "a rather long string that is not stored in place";
+   Pooled_string ps1(s);
+   BOOST_CHECK_EQUAL(ps1.str(), s);
+   BOOST_CHECK( ! ps1.pooled() );
+   const Pooled_string ps2(ps1);
+   BOOST_CHECK(ps2 == ps1);
+   BOOST_CHECK(ps2.data() != ps1.data());
+   ps1 = ps0;
+   BOOST_CHECK(ps1.empty());
+   BOOST_CHECK_EQUAL(ps2.str(), s);
+   BOOST_CHECK(boost::string_ref(ps2) == s);
+}
+
+/**@test Intern and release strings
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_string_pool ) {
+   String_pool sp;
+   const Pooled_string ps1 = sp.intern("blah");
+   const Pooled_string ps2 = sp.intern(std::string("blahblah").substr(0, 4));
+   const Pooled_string ps3 = sp.intern("blahblah");
+   BOOST_CHECK(ps1.pooled());
+   BOOST_CHECK(ps1.data() == ps2.data());
+   BOOST_CHECK(ps1 == ps2);
+   BOOST_CHECK(ps1 != ps3);
+   BOOST_CHECK_EQUAL(sp.size(), 2U);
+
+   //records are allocated one after another
+   BOOST_CHECK_EQUAL(
+            ps3.data() - ps1.data(),
+            std::ptrdiff_t(sizeof(owlcpp::detail::String_header) + 8)
+   );
+
+   const Pooled_string ps4 = sp.intern("");
+   BOOST_CHECK(ps4.empty());
+   BOOST_CHECK( ! ps4.pooled() );
+   sp.release(ps4);
+   BOOST_CHECK_EQUAL(sp.size(), 2U);
+
+   //copies of pooled handles share the string
+   const Pooled_string ps5(ps3);
+   BOOST_CHECK(ps5.data() == ps3.data());
+
+   sp.release(ps1);
+   BOOST_CHECK_EQUAL(sp.size(), 2U);
+   BOOST_CHECK_EQUAL(ps2.str(), "blah");
+   sp.release(ps2);
+   BOOST_CHECK_EQUAL(sp.size(), 1U);
+
+   //record of released string is reused by string of same rounded size
+   char const* p = ps2.data();
+   const Pooled_string ps6 = sp.intern("x");
+   BOOST_CHECK(ps6.data() == p);
+   BOOST_CHECK_EQUAL(ps6.str(), "x");
+   BOOST_CHECK_EQUAL(ps3.str(), "blahblah");
+   BOOST_CHECK_EQUAL(sp.size(), 2U);
+
+   //long strings are pooled too
+   const std::string s1(100000, 'a');
+   const Pooled_string ps7 = sp.intern(s1);
+   BOOST_CHECK(sp.intern(s1).data() == ps7.data());
+   BOOST_CHECK(boost::string_ref(ps7) == s1);
+   sp.release(ps7);
+   sp.release(ps7);
+   BOOST_CHECK_EQUAL(sp.size(), 2U);
+
+   sp.clear();
+   BOOST_CHECK_EQUAL(sp.size(), 0U);
+}
+
+}//namespace test
+}//namespace owlcpp
@@ -218,5 +218,46 @@ BOOST_AUTO_TEST_CASE( case07 ) {
 
 }
 
+/** Test sparse and dense leading IDs
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( case08 ) {
+   typedef m::Fragment_table<m::Triple_set<Pred_tag,Obj_tag,Doc_tag> > table_t;
+   index1 ind;
+   ind.insert(triple(100001, 1, 2, 0));
+   ind.insert(triple(5, 1, 2, 0));
+   ind.insert(triple(100000, 1, 2, 0));
+   ind.insert(triple(100000, 1, 3, 0));
+   BOOST_CHECK_EQUAL(ind.size(), 4U);
+   BOOST_CHECK_EQUAL(boost::distance(ind.find(any, Node_id(1), any, any)), 4);
+   BOOST_CHECK_EQUAL(ind.find(Node_id(100000), any, any, any).size(), 2);
+   BOOST_CHECK(ind.find(Node_id(6), any, any, any).empty());
+   BOOST_CHECK(ind.find(Node_id(200000), any, any, any).empty());
+
+   //make a dense page
+   const unsigned n = table_t::dense_min() + 10;
+   for( unsigned i = 0; i != n; ++i ) ind.insert(triple(512 + i, 0, i, 1));
+   BOOST_CHECK_EQUAL(ind.size(), n + 4);
+   BOOST_CHECK_EQUAL(boost::distance(ind.find(any, Node_id(0), any, any)), n);
+   BOOST_CHECK_EQUAL(ind.find(Node_id(520), any, any, any).size(), 1);
+
+   ind.erase(triple(5, 1, 2, 0));
+   BOOST_CHECK_EQUAL(ind.size(), n + 3);
+   BOOST_CHECK(ind.find(Node_id(5), any, any, any).empty());
+   BOOST_CHECK_THROW(ind.erase(triple(5, 1, 2, 0)), Rdf_err);
+
+   ind.freeze();
+   BOOST_CHECK_EQUAL(ind.size(), n + 3);
+   BOOST_CHECK_EQUAL(boost::distance(ind), n + 3);
+   ind.erase(triple(100000, 1, 3, 0));
+   BOOST_CHECK_EQUAL(ind.size(), n + 2);
+   BOOST_CHECK_EQUAL(boost::distance(ind.find(any, Node_id(1), any, any)), 2);
+
+   std::vector<Triple> v;
+   for( unsigned i = 0; i != n; ++i ) v.push_back(triple(512 + i, 0, i, 1));
+   BOOST_CHECK_EQUAL(ind.erase_batch(v), n);
+   BOOST_CHECK_EQUAL(ind.size(), 2U);
+   BOOST_CHECK_EQUAL(boost::distance(ind), 2);
+}
+
 }//namespace test
 }//namespace owlcpp
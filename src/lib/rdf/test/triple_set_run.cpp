@@ -5,6 +5,8 @@ part of owlcpp project.
 *******************************************************************************/
 #define BOOST_TEST_MODULE triple_set_run
 #include "boost/test/unit_test.hpp"
+#include <algorithm>
+#include <vector>
 #include "test/exception_fixture.hpp"
 #include "test/test_utils.hpp"
 
@@ -64,5 +66,47 @@ BOOST_AUTO_TEST_CASE( case01 ) {
    );
 }
 
+/** Test merging sorted range into triple set
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( case02 ) {
+   typedef m::Triple_set<Pred_tag, Subj_tag, Obj_tag> ts_t;
+   ts_t ts1, ts2;
+   insert_seq(ts1, random_triples1);
+
+   std::vector<Triple> v;
+   for(std::size_t i = 0; i != boost::size(random_triples1); ++i) {
+      v.push_back(triple(random_triples1[i]));
+   }
+   std::sort(v.begin(), v.end(), m::Value_predicate<Pred_tag, Subj_tag, Obj_tag>());
+   const std::size_t half = v.size() / 2;
+   ts2.insert(v[half]);
+   BOOST_CHECK_EQUAL(ts2.insert_sorted(v.begin(), v.begin() + half + 1), half);
+   BOOST_CHECK_EQUAL(ts2.insert_sorted(v.begin(), v.end()), v.size() - half - 1);
+   BOOST_CHECK_EQUAL(ts2.insert_sorted(v.begin(), v.end()), 0U);
+   BOOST_CHECK_EQUAL(ts2.size(), ts1.size());
+   BOOST_CHECK(std::equal(ts1.begin(), ts1.end(), ts2.begin()));
+}
+
+/** Test removing sorted range from triple set
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( case03 ) {
+   typedef m::Triple_set<Pred_tag, Subj_tag, Obj_tag> ts_t;
+   ts_t ts;
+   insert_seq(ts, random_triples1);
+
+   std::vector<Triple> v1, v2;
+   for(std::size_t i = 0; i != ts.size(); ++i) {
+      if( i % 3 ) v1.push_back(ts[i]);
+      else v2.push_back(ts[i]);
+   }
+   v1.push_back(triple(7, 7, 7, 7)); //not in the set
+   std::sort(v1.begin(), v1.end(), m::Value_predicate<Pred_tag, Subj_tag, Obj_tag>());
+   BOOST_CHECK_EQUAL(ts.erase_sorted(v1.begin(), v1.end()), v1.size() - 1);
+   BOOST_CHECK_EQUAL(ts.size(), v2.size());
+   BOOST_CHECK(std::equal(v2.begin(), v2.end(), ts.begin()));
+   BOOST_CHECK_EQUAL(ts.erase_sorted(v2.begin(), v2.end()), v2.size());
+   BOOST_CHECK(ts.empty());
+}
+
 }//namespace test
 }//namespace owlcpp
@@ -32,5 +32,53 @@ BOOST_AUTO_TEST_CASE( test_docs_01 ) {
    BOOST_CHECK_EQUAL(ts.map_triple().size(), 6U);
 }
 
+/**@test Remove document triples and blank nodes
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_remove_doc ) {
+   Triple_store ts;
+   sample_triples_01(ts);
+   sample_triples_02(ts);
+   BOOST_CHECK_EQUAL(ts.map_node().size(), 19U);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 14U);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+   const Doc_id did1 = *ts.find_doc_iri(doc1).begin();
+   const Doc_id did2 = *ts.find_doc_iri(doc2).begin();
+   Node_id const* nid = ts.find_node_iri(iri12);
+   BOOST_REQUIRE(nid);
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, *nid, any, any)), 14);
+
+   BOOST_CHECK_EQUAL(ts.remove_doc(did1), 7U);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 7U);
+   BOOST_CHECK_EQUAL(ts.map_node().size(), 14U);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 1U);
+   BOOST_CHECK( ! ts.find(did1) );
+   BOOST_CHECK( ts.find_blank(1, did2) );
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, *nid, any, any)), 7);
+   BOOST_CHECK_EQUAL(distance(ts.find_triple(any, any, any, did1)), 0);
+   BOOST_FOREACH(Triple const& t, ts.map_triple()) {
+      BOOST_CHECK_EQUAL(t.doc_, did2);
+   }
+   BOOST_CHECK_THROW(ts.remove_doc(did1), base_exception);
+
+   //insert document again
+   sample_triples_01(ts);
+   BOOST_CHECK_EQUAL(ts.map_node().size(), 19U);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 14U);
+   BOOST_CHECK_EQUAL(ts.map_doc().size(), 2U);
+}
+
+/**@test Erasing missing triple does not change the store
+*******************************************************************************/
+BOOST_AUTO_TEST_CASE( test_erase_missing ) {
+   Triple_store ts = sample_triples_01();
+   Triple t = *ts.map_triple().begin();
+   ts.erase(t);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 6U);
+   BOOST_CHECK_THROW(ts.erase(t), Rdf_err);
+   BOOST_CHECK_EQUAL(ts.map_triple().size(), 6U);
+   BOOST_CHECK_EQUAL(ts.remove_doc(t.doc_), 6U);
+   BOOST_CHECK(ts.map_triple().empty());
+}
+
 }//namespace test
 }//namespace owlcpp